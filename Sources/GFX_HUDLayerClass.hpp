@@ -0,0 +1,76 @@
+/*
+******************************************
+*                                        *
+* GFX_HUDLayerClass.hpp                  *
+*                                        *
+* (c) 2017 - 2020 Stefan Kubsch          *
+******************************************
+*/
+
+#pragma once
+
+#include <cstdint>
+
+#include "Game_GlobalDefinitions.hpp"
+
+//
+// Retained HUD layer
+//
+// A widget draws into the texture returned by Begin() and uploads it with Commit() - only when the values it shows have changed
+// Display() just draws the cached GPU texture, so a frame without changes costs one textured quad per widget
+// Canvas layers are blitted into the canvas instead - they are part of the 3D view then and get faded out with it (death sequence)
+//
+
+class GFX_HUDLayerClass final
+{
+public:
+	enum class Targets : std::int_fast32_t
+	{
+		GPU,
+		Canvas
+	};
+
+	void Init(std::int_fast32_t PosX, std::int_fast32_t PosY, std::int_fast32_t Width, std::int_fast32_t Height, Targets LayerTarget);
+	lwmf::TextureStruct& Begin();
+	void Commit();
+	void Display() const;
+
+private:
+	lwmf::ShaderClass LayerShader{};
+	lwmf::TextureStruct Layer{};
+	lwmf::IntPointStruct Pos{};
+	Targets Target{};
+};
+
+inline void GFX_HUDLayerClass::Init(const std::int_fast32_t PosX, const std::int_fast32_t PosY, const std::int_fast32_t Width, const std::int_fast32_t Height, const Targets LayerTarget)
+{
+	lwmf::CreateTexture(Layer, Width, Height, 0x00000000);
+	Pos = { PosX, PosY };
+	Target = LayerTarget;
+
+	if (Target == Targets::GPU)
+	{
+		LayerShader.LoadShader("Default", Canvas);
+		LayerShader.PrepareLWMFTexture(Layer, PosX, PosY);
+		Commit();
+	}
+}
+
+inline lwmf::TextureStruct& GFX_HUDLayerClass::Begin()
+{
+	lwmf::ClearTexture(Layer, 0x00000000);
+	return Layer;
+}
+
+inline void GFX_HUDLayerClass::Commit()
+{
+	if (Target == Targets::GPU)
+	{
+		glTextureSubImage2D(LayerShader.OGLTextureID, 0, 0, 0, Layer.Width, Layer.Height, GL_RGBA, GL_UNSIGNED_BYTE, Layer.Pixels.data());
+	}
+}
+
+inline void GFX_HUDLayerClass::Display() const
+{
+	Target == Targets::GPU ? LayerShader.RenderStaticTexture(&LayerShader.OGLTextureID, true, 1.0F) : lwmf::BlitTransTexture(Layer, Canvas, Pos.X, Pos.Y, 0x00000000);
+}
@@ -13,20 +13,22 @@
 #include <string>
 #include <string_view>
 #include <vector>
-#include <fstream>
 #include <istream>
+#include <utility>
 
 #define STB_TRUETYPE_IMPLEMENTATION
 #include "./stb/stb_truetype.hpp"
 
 #include "Game_GlobalDefinitions.hpp"
 #include "Tools_ErrorHandling.hpp"
+#include "Tools_VFS.hpp"
 
 class GFX_TextClass final
 {
 public:
 	void InitFont(const std::string& INIFileName, const std::string& Section);
 	void RenderText(std::string_view Text, std::int_fast32_t x, std::int_fast32_t y);
+	void RenderTextToTexture(lwmf::TextureStruct& Texture, std::string_view Text, std::int_fast32_t x, std::int_fast32_t y) const;
 	void RenderTextCentered(std::string_view Text, std::int_fast32_t y);
 	lwmf::IntPointStruct GetOffset();
 	std::int_fast32_t GetFontHeight() const;
@@ -39,6 +41,8 @@ private:
 		std::int_fast32_t Advance{};
 		std::int_fast32_t Baseline{};
 		GLuint Texture{};
+		// CPU copy for text which is rendered into retained textures
+		lwmf::TextureStruct Bitmap{};
 	};
 
 	lwmf::ShaderClass GlyphShader{};
@@ -67,12 +71,8 @@ inline void GFX_TextClass::InitFont(const std::string& INIFileName, const std::s
 		// Get raw (binary) font data
 		if (Tools_ErrorHandling::CheckFileExistence(FontName, StopOnError))
 		{
-			std::ifstream FontFile(FontName.c_str(), std::ifstream::binary);
-
-			FontFile.seekg(0, std::ios::end);
-			std::vector<unsigned char> FontBuffer(static_cast<std::size_t>(FontFile.tellg()));
-			FontFile.seekg(0, std::ios::beg);
-			FontFile.read(reinterpret_cast<char*>(FontBuffer.data()), FontBuffer.size());
+			std::vector<unsigned char> FontBuffer{};
+			Tools_VFS::ReadFile(FontName, FontBuffer);
 
 			// Render the glyphs for ASCII chars
 			// This makes 128 chars, the last 96 are printable (from 32 = "space" on)
@@ -137,6 +137,7 @@ inline void GFX_TextClass::InitFont(const std::string& INIFileName, const std::s
 				}
 
 				GlyphShader.LoadTextureInGPU(TempGlyphTexture, &Glyphs[Char].Texture);
+				Glyphs[Char].Bitmap = std::move(TempGlyphTexture);
 			}
 		}
 	}
@@ -151,6 +152,16 @@ inline void GFX_TextClass::RenderText(const std::string_view Text, std::int_fast
 	}
 }
 
+inline void GFX_TextClass::RenderTextToTexture(lwmf::TextureStruct& Texture, const std::string_view Text, std::int_fast32_t x, const std::int_fast32_t y) const
+{
+	// Same layout as RenderText(), but the glyphs are blitted on the CPU (fully transparent pixels are skipped)
+	for (const char& Char : Text)
+	{
+		lwmf::BlitTransTexture(Glyphs[Char].Bitmap, Texture, x, y - Glyphs[Char].Baseline + FontHeight, 0x00000000);
+		x += Glyphs[Char].Advance;
+	}
+}
+
 inline void GFX_TextClass::RenderTextCentered(const std::string_view Text, const std::int_fast32_t y)
 {
 	std::int_fast32_t TextLengthInPixels{};
@@ -31,6 +31,13 @@ namespace GFX_Window
 
 		if (const std::string INIFile{ GameConfigFolder + "WindowConfig.ini" }; Tools_ErrorHandling::CheckFileExistence(INIFile, StopOnError))
 		{
+			// No window and no OpenGL context - the canvas is a plain texture then
+			if (Headless)
+			{
+				lwmf::CreateTexture(Canvas, lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "WINDOW", "ViewportWidth"), lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "WINDOW", "ViewportHeight"), 0x00000000);
+				return;
+			}
+
 			lwmf::CreateOpenGLWindow(lwmf::WindowInstance,
 				Canvas,
 				lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "WINDOW", "ViewportWidth"),
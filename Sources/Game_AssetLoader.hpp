@@ -0,0 +1,194 @@
+/*
+******************************************
+*                                        *
+* Game_AssetLoader.hpp                   *
+*                                        *
+* (c) 2017 - 2020 Stefan Kubsch          *
+******************************************
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <deque>
+#include <functional>
+#include <exception>
+#include <chrono>
+
+#include "Game_GlobalDefinitions.hpp"
+#include "Game_TextureCache.hpp"
+
+namespace Game_AssetLoader
+{
+
+
+	//
+	// Asset loader
+	//
+	// Loading functions queue jobs (PNG decode, copy from the baked level, GPU upload...) instead of doing the work themselves
+	// Run() is the barrier - it executes all queued jobs on the thread pool and returns when every one of them is finished
+	//
+	// A job starts when all jobs it depends on are done; jobs can only depend on jobs queued before them, so there are no cycles
+	// Every job writes to its own target which was allocated when it was queued, so the result does not depend on the number of threads
+	// Jobs which need the OpenGL context (MainThread) run on the calling thread in queue order
+	//
+
+	enum class JobTargets : std::int_fast32_t
+	{
+		Worker,
+		MainThread
+	};
+
+	struct AssetJobStruct final
+	{
+		std::string Name;
+		std::function<void()> Work;
+		std::vector<std::size_t> Dependencies{};
+		JobTargets Target{ JobTargets::Worker };
+		std::chrono::microseconds Duration{};
+		std::exception_ptr Error{};
+		bool Done{};
+	};
+
+	std::size_t AddJob(const std::string& Name, std::function<void()> Work, const std::vector<std::size_t>& Dependencies = {}, JobTargets Target = JobTargets::Worker);
+	std::size_t AddTextureJob(const std::string& FileName, Game_TextureCache::TextureHandle& Texture, std::int_fast32_t Size = 0);
+	std::size_t AddUploadJob(const std::string& FileName, std::function<void(const lwmf::TextureStruct&)> Upload);
+	void Run(const std::string& BarrierName);
+	void RunJob(std::size_t Index);
+	bool IsReady(const AssetJobStruct& Job);
+
+	//
+	// Variables and constants
+	//
+
+	inline std::vector<AssetJobStruct> Jobs{};
+	// Images which are only needed for a GPU upload - a deque, so references stay valid while jobs are queued
+	inline std::deque<Game_TextureCache::TextureHandle> StagingTextures{};
+
+	//
+	// Functions
+	//
+
+	inline std::size_t AddJob(const std::string& Name, std::function<void()> Work, const std::vector<std::size_t>& Dependencies, const JobTargets Target)
+	{
+		Jobs.push_back({ Name, std::move(Work), Dependencies, Target });
+		return Jobs.size() - 1;
+	}
+
+	inline std::size_t AddTextureJob(const std::string& FileName, Game_TextureCache::TextureHandle& Texture, const std::int_fast32_t Size)
+	{
+		// Size 0 = no fixed size (HUD images, skybox...)
+		// The handle must not move until Run() - allocate all targets first, then queue their jobs
+		return AddJob(FileName, [&Texture, FileName, Size] { Texture = Game_TextureCache::Acquire(FileName, Size); });
+	}
+
+	inline std::size_t AddUploadJob(const std::string& FileName, std::function<void(const lwmf::TextureStruct&)> Upload)
+	{
+		// Decoded by a worker, uploaded on the main thread (OpenGL context) - returns the upload job
+		Game_TextureCache::TextureHandle& Texture{ StagingTextures.emplace_back() };
+		return AddJob(FileName + " upload", [&Texture, Upload = std::move(Upload)] { Upload(*Texture); }, { AddTextureJob(FileName, Texture) }, JobTargets::MainThread);
+	}
+
+	inline void Run(const std::string& BarrierName)
+	{
+		NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Load " + BarrierName + " (" + std::to_string(Jobs.size()) + " jobs)...");
+
+		const auto StartTime{ std::chrono::steady_clock::now() };
+		std::vector<std::size_t> Wave{};
+		std::size_t Remaining{ Jobs.size() };
+
+		while (Remaining > 0)
+		{
+			Wave.clear();
+
+			for (std::size_t Index{}; Index < Jobs.size(); ++Index)
+			{
+				if (!Jobs[Index].Done && IsReady(Jobs[Index]))
+				{
+					Wave.emplace_back(Index);
+				}
+			}
+
+			for (const auto Index : Wave)
+			{
+				if (Jobs[Index].Target == JobTargets::Worker)
+				{
+					ThreadPool.AddThread(&RunJob, Index);
+				}
+			}
+
+			// Main thread jobs overlap with the workers of the same wave
+			for (const auto Index : Wave)
+			{
+				if (Jobs[Index].Target == JobTargets::MainThread)
+				{
+					RunJob(Index);
+				}
+			}
+
+			ThreadPool.WaitForThreads();
+
+			for (const auto Index : Wave)
+			{
+				// The first failed job in queue order is reported, no matter which thread finished first
+				if (Jobs[Index].Error)
+				{
+					const std::exception_ptr Error{ Jobs[Index].Error };
+					Jobs.clear();
+					StagingTextures.clear();
+					std::rethrow_exception(Error);
+				}
+
+				Jobs[Index].Done = true;
+			}
+
+			Remaining -= Wave.size();
+		}
+
+		for (const auto& Job : Jobs)
+		{
+			NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Asset job " + Job.Name + ": " + std::to_string(Job.Duration.count()) + " us");
+		}
+
+		NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Loaded " + BarrierName + " in " + std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - StartTime).count()) + " ms.");
+
+		Jobs.clear();
+		StagingTextures.clear();
+	}
+
+	inline void RunJob(const std::size_t Index)
+	{
+		AssetJobStruct& Job{ Jobs[Index] };
+		const auto StartTime{ std::chrono::steady_clock::now() };
+
+		// Exceptions are passed to Run(), so they reach the main thread like before
+		try
+		{
+			Job.Work();
+		}
+		catch (...)
+		{
+			Job.Error = std::current_exception();
+		}
+
+		Job.Duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - StartTime);
+	}
+
+	inline bool IsReady(const AssetJobStruct& Job)
+	{
+		for (const auto Dependency : Job.Dependencies)
+		{
+			if (!Jobs[Dependency].Done)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+
+} // namespace Game_AssetLoader
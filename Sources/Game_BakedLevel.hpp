@@ -0,0 +1,339 @@
+/*
+******************************************
+*                                        *
+* Game_BakedLevel.hpp                    *
+*                                        *
+* (c) 2017 - 2020 Stefan Kubsch          *
+******************************************
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <array>
+#include <span>
+#include <sstream>
+#include <filesystem>
+
+#include "Game_GlobalDefinitions.hpp"
+#include "Game_Folder.hpp"
+#include "Tools_VFS.hpp"
+
+namespace Game_BakedLevel
+{
+
+
+	//
+	// Baked level container
+	//
+	// One binary file per level ("Level.baked" in the level folder), made from the text files by the offline baker ("NARC.exe -bakelevels", see Tools_LevelBaker.hpp)
+	// Layout: FileHeaderStruct, one SectionStruct per section, then the sections - each one starts at a multiple of SectionAlignment
+	// The file is memory mapped (in place from the pack archive, if it is in there), loading a level just copies map cells, records and already decoded texture pixels - no text parsing, no PNG decoding
+	//
+	// SourceStamp is a hash over names, sizes and modification times of all text files and textures the bake was made from - no file is read for it
+	// If they are present and the stamp differs, the bake is stale and the level gets loaded from the text files instead
+	// Bakes from the pack archive are not checked - the pack is release data and does not contain the level sources
+	//
+
+	enum class Sections : std::uint32_t
+	{
+		FloorLayer,
+		WallLayer,
+		CeilingLayer,
+		DoorLayer,
+		Lights,
+		Entities,
+		Textures,
+		Counter
+	};
+
+	struct FileHeaderStruct final
+	{
+		std::array<char, 4> Magic{};
+		std::uint32_t Version{};
+		std::uint32_t NumberOfSections{};
+		std::uint32_t TextureSize{};
+		std::uint64_t SourceStamp{};
+	};
+
+	// Count is the number of rows (map layers), records (lights, entities) or textures
+	struct SectionStruct final
+	{
+		std::uint32_t Type{};
+		std::uint32_t Count{};
+		std::uint64_t Offset{};
+		std::uint64_t Size{};
+	};
+
+	struct LightRecordStruct final
+	{
+		float PosX{};
+		float PosY{};
+		std::int32_t Location{};
+		float Radius{};
+		float Intensity{};
+	};
+
+	// All keys of an entity ini file - strings have a fixed size, so records can be used right from the mapped file
+	struct EntityRecordStruct final
+	{
+		std::array<char, 32> TypeName{};
+		std::array<char, 32> EntityType{};
+		std::array<char, 32> ContainedItem{};
+		std::int32_t WalkAnimStepWidth{};
+		std::int32_t AttackAnimStepWidth{};
+		std::int32_t KillAnimStepWidth{};
+		float MoveV{};
+		float MoveSpeed{};
+		std::int32_t MovementBehaviour{};
+		std::int32_t AttackMode{};
+		float StartPosX{};
+		float StartPosY{};
+		std::int32_t Direction{};
+		std::int32_t Hitpoints{};
+		std::int32_t HitAnimDuration{};
+		std::int32_t DamagePoints{};
+		std::int32_t DamageHitrate{};
+		std::int32_t ContainedItemValue{};
+		float NearDistance{};
+		float FarDistance{};
+		float HearingDistance{};
+		std::int32_t MidTickInterval{};
+	};
+
+	std::string GetFileName(std::int_fast32_t Level);
+	std::vector<std::string> GatherSourceFiles(std::int_fast32_t Level);
+	std::uint64_t GetSourceStamp(std::int_fast32_t Level);
+	bool Open(std::int_fast32_t Level);
+	bool CheckSections();
+	bool CheckRecordCount(const SectionStruct& Section);
+	void Close();
+	bool IsOpen();
+	const SectionStruct& GetSectionInfo(Sections Section);
+	template<typename T>std::span<const T> GetSection(Sections Section);
+	template<std::size_t Size>void CopyString(std::array<char, Size>& Target, const std::string& Source);
+
+	//
+	// Variables and constants
+	//
+
+	inline constexpr std::array<char, 4> Magic{ 'N', 'A', 'R', 'C' };
+	inline constexpr std::uint32_t Version{ 2 };
+	inline constexpr std::uint64_t SectionAlignment{ 16 };
+
+	inline lwmf::MappedFile LevelFile{};
+	inline std::span<const std::byte> LevelData{};
+	inline std::array<SectionStruct, static_cast<std::size_t>(Sections::Counter)> SectionTable{};
+
+	//
+	// Functions
+	//
+
+	inline std::string GetFileName(const std::int_fast32_t Level)
+	{
+		return LevelFolder + std::to_string(Level) + "/Level.baked";
+	}
+
+	inline std::vector<std::string> GatherSourceFiles(const std::int_fast32_t Level)
+	{
+		// Everything the baked sections are made of - in a fixed order, so the checksum is reproducible
+		const std::string LevelPath{ LevelFolder + std::to_string(Level) + "/" };
+		std::vector<std::string> SourceFiles
+		{
+			LevelPath + "LevelData/MapFloorData.conf",
+			LevelPath + "LevelData/MapWallData.conf",
+			LevelPath + "LevelData/MapCeilingData.conf",
+			LevelPath + "LevelData/MapDoorData.conf",
+			LevelPath + "LevelData/StaticLightsData.conf",
+			LevelPath + "LevelData/TexturesData.conf"
+		};
+
+		std::istringstream TexturesDataFile(Tools_VFS::ReadText(LevelPath + "LevelData/TexturesData.conf"));
+		std::string Line;
+
+		while (std::getline(TexturesDataFile, Line))
+		{
+			SourceFiles.emplace_back(GFXLevelTexturesFolder + std::to_string(TextureSize) + "/" + Line);
+		}
+
+		for (std::int_fast32_t Index{};; ++Index)
+		{
+			std::string INIFile{ LevelPath + "EntityData/" + std::to_string(Index) + ".ini" };
+
+			if (!Tools_VFS::Exists(INIFile))
+			{
+				break;
+			}
+
+			SourceFiles.emplace_back(std::move(INIFile));
+		}
+
+		return SourceFiles;
+	}
+
+	inline std::uint64_t GetSourceStamp(const std::int_fast32_t Level)
+	{
+		std::uint64_t Stamp{ lwmf::SplitMix64(static_cast<std::uint64_t>(Version) ^ static_cast<std::uint64_t>(TextureSize)) };
+
+		for (const auto& FileName : GatherSourceFiles(Level))
+		{
+			// Names are part of the stamp too, so a renamed or missing file also makes the bake stale
+			Stamp = lwmf::HashBytes(FileName.data(), FileName.size(), Stamp);
+
+			std::error_code SizeError{};
+			std::error_code TimeError{};
+			const std::array<std::int64_t, 2> FileInfo{ static_cast<std::int64_t>(std::filesystem::file_size(FileName, SizeError)), static_cast<std::int64_t>(std::filesystem::last_write_time(FileName, TimeError).time_since_epoch().count()) };
+
+			if (!SizeError && !TimeError)
+			{
+				Stamp = lwmf::HashBytes(FileInfo.data(), sizeof(FileInfo), Stamp);
+			}
+		}
+
+		return Stamp;
+	}
+
+	inline bool Open(const std::int_fast32_t Level)
+	{
+		Close();
+
+		const std::string FileName{ GetFileName(Level) };
+
+		if (!Tools_VFS::Exists(FileName))
+		{
+			NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "No baked level found, loading level from text files...");
+			return false;
+		}
+
+		NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Open baked level " + FileName + "...");
+
+		LevelData = Tools_VFS::Map(FileName);
+		const bool FromPack{ !LevelData.empty() };
+
+		if (!FromPack && LevelFile.Open(FileName))
+		{
+			LevelData = { LevelFile.GetData(), LevelFile.GetSize() };
+		}
+
+		if (LevelData.empty() || !CheckSections())
+		{
+			NARCLog.AddEntry(lwmf::LogLevel::Warn, __FILENAME__, __LINE__, "Open(): " + FileName + " is invalid or was made for another version or texture size - loading level from text files!");
+			Close();
+			return false;
+		}
+
+		FileHeaderStruct Header{};
+		std::memcpy(&Header, LevelData.data(), sizeof(FileHeaderStruct));
+
+		// Without the text files (e.g. a release which ships baked levels only) there is nothing to compare against
+		if (!FromPack && Tools_VFS::Exists(LevelFolder + std::to_string(Level) + "/LevelData/MapWallData.conf") && GetSourceStamp(Level) != Header.SourceStamp)
+		{
+			NARCLog.AddEntry(lwmf::LogLevel::Warn, __FILENAME__, __LINE__, "Open(): " + FileName + " is stale, run \"NARC.exe -bakelevels\" again - loading level from text files!");
+			Close();
+			return false;
+		}
+
+		return true;
+	}
+
+	inline bool CheckSections()
+	{
+		const std::size_t FileSize{ LevelData.size() };
+
+		if (FileSize < sizeof(FileHeaderStruct) + sizeof(SectionTable))
+		{
+			return false;
+		}
+
+		FileHeaderStruct Header{};
+		std::memcpy(&Header, LevelData.data(), sizeof(FileHeaderStruct));
+
+		if (Header.Magic != Magic || Header.Version != Version || Header.NumberOfSections != static_cast<std::uint32_t>(Sections::Counter) || Header.TextureSize != static_cast<std::uint32_t>(TextureSize))
+		{
+			return false;
+		}
+
+		std::memcpy(SectionTable.data(), LevelData.data() + sizeof(FileHeaderStruct), sizeof(SectionTable));
+
+		for (std::uint32_t Index{}; Index < Header.NumberOfSections; ++Index)
+		{
+			const SectionStruct& Section{ SectionTable[Index] };
+
+			if (Section.Type != Index || Section.Offset % SectionAlignment != 0 || Section.Offset > FileSize || Section.Size > FileSize - Section.Offset || !CheckRecordCount(Section))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	inline bool CheckRecordCount(const SectionStruct& Section)
+	{
+		// A truncated or mismatched bake is rejected as a whole - the level gets loaded from the text files instead of with missing rows or textures
+		switch (static_cast<Sections>(Section.Type))
+		{
+			case Sections::FloorLayer:
+			case Sections::WallLayer:
+			case Sections::CeilingLayer:
+			case Sections::DoorLayer:
+			{
+				// Rows of the same length, at least one cell
+				return Section.Count > 0 && Section.Size >= Section.Count * sizeof(std::int32_t) && Section.Size % (Section.Count * sizeof(std::int32_t)) == 0;
+			}
+			case Sections::Lights:
+			{
+				return Section.Size == Section.Count * sizeof(LightRecordStruct);
+			}
+			case Sections::Entities:
+			{
+				return Section.Size == Section.Count * sizeof(EntityRecordStruct);
+			}
+			case Sections::Textures:
+			{
+				return Section.Size == Section.Count * static_cast<std::uint64_t>(TextureSize) * static_cast<std::uint64_t>(TextureSize) * sizeof(std::int32_t);
+			}
+			default:
+			{
+				return false;
+			}
+		}
+	}
+
+	inline void Close()
+	{
+		LevelFile.Close();
+		LevelData = {};
+		SectionTable = {};
+	}
+
+	inline bool IsOpen()
+	{
+		return !LevelData.empty();
+	}
+
+	inline const SectionStruct& GetSectionInfo(const Sections Section)
+	{
+		return SectionTable[static_cast<std::size_t>(Section)];
+	}
+
+	template<typename T>std::span<const T> GetSection(const Sections Section)
+	{
+		// Sections are aligned, so the records can be used in place
+		const SectionStruct& Info{ GetSectionInfo(Section) };
+		return { reinterpret_cast<const T*>(LevelData.data() + Info.Offset), static_cast<std::size_t>(Info.Size / sizeof(T)) };
+	}
+
+	template<std::size_t Size>void CopyString(std::array<char, Size>& Target, const std::string& Source)
+	{
+		// Always zero terminated - longer strings get cut
+		Target.fill('\0');
+		Source.copy(Target.data(), Size - 1);
+	}
+
+
+} // namespace Game_BakedLevel
@@ -12,6 +12,8 @@
 #include <cstdint>
 #include <string>
 #include <map>
+#include <random>
+#include <algorithm>
 
 #include "Game_GlobalDefinitions.hpp"
 #include "Tools_ErrorHandling.hpp"
@@ -65,7 +67,21 @@ namespace Game_Config
 				NARCLog.AddEntry(lwmf::LogLevel::Critical, __FILENAME__, __LINE__, "Init(): EntitySize has an incorrect value!");
 			}
 
+			// Given in MB
+			TextureCacheBudget = static_cast<std::size_t>(std::max(lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "TEXTURES", "TextureCacheBudget"), static_cast<std::int_fast32_t>(0))) << 20;
+
 			FrameLock = lwmf::ReadINIValue<std::uint_fast32_t>(INIFile, "GENERAL", "FrameLock");
+
+			// Seed 0 = new seed every run - it is logged, so the run can be reproduced
+			GameSeed = lwmf::ReadINIValue<std::uint64_t>(INIFile, "GENERAL", "Seed");
+
+			if (GameSeed == 0)
+			{
+				std::random_device Device;
+				GameSeed = (static_cast<std::uint64_t>(Device()) << 32) | static_cast<std::uint64_t>(Device());
+			}
+
+			NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Game seed: " + std::to_string(GameSeed));
 		}
 	}
 
@@ -12,9 +12,13 @@
 #include <cstdint>
 #include <string>
 #include <vector>
+#include <array>
+#include <list>
 #include <map>
 
 #include "Game_PlayerClass.hpp"
+#include "Game_TimingWheel.hpp"
+#include "Game_TextureCache.hpp"
 
 // Tried tp "pad" the elements by their size..
 
@@ -22,12 +26,41 @@
 // Structure for entity asset data (textures, sounds etc.)
 //
 
+enum class EntityAnimStates : std::int_fast32_t
+{
+	Walk,
+	Attack,
+	Kill
+};
+
+inline constexpr std::int_fast32_t NumberOfEntityAnimStates{ 3 };
+
+// What happens after the last frame of a sequence
+enum class EntityAnimEnds : std::int_fast32_t
+{
+	Loop,
+	Rewind,
+	Hold
+};
+
+// Frames of one animation state in the compiled frame table - one run of NumberOfFrames per direction
+struct EntityAnimSequenceStruct final
+{
+	std::int_fast32_t FirstFrame{};
+	std::int_fast32_t NumberOfFrames{};
+	std::int_fast32_t NumberOfDirections{ 1 };
+	EntityAnimEnds End{};
+};
+
 struct EntityAssetStruct final
 {
-	std::vector<std::vector<lwmf::TextureStruct>> WalkingTextures{};
-	std::vector<lwmf::TextureStruct> AttackTextures{};
-	std::vector<lwmf::TextureStruct> KillTextures{};
+	std::vector<std::vector<Game_TextureCache::TextureHandle>> WalkingTextures{};
+	std::vector<Game_TextureCache::TextureHandle> AttackTextures{};
+	std::vector<Game_TextureCache::TextureHandle> KillTextures{};
 	std::vector<lwmf::MP3Player> Sounds{};
+	// Compiled at load - pixel pointers of all frames in one flat table, indexed by EntityAnimStates
+	std::vector<const std::int_fast32_t*> AnimFrames{};
+	std::array<EntityAnimSequenceStruct, NumberOfEntityAnimStates> AnimSequences{};
 	std::string Name;
 	std::int_fast32_t Number{};
 };
@@ -46,49 +79,273 @@ enum class EntityTypes : std::int_fast32_t
 	Turret
 };
 
-struct EntityStruct final
+enum class EntityArchetypes : std::int_fast32_t
+{
+	Mobile,
+	Pickup,
+	Turret,
+	None
+};
+
+inline constexpr std::int_fast32_t NumberOfEntityArchetypes{ 3 };
+
+enum class EntityLODTiers : std::int_fast32_t
+{
+	Full,
+	Mid,
+	Sleep
+};
+
+// Entity data is split into components which are stored in separate contiguous columns
+// Hot columns are read every tick (movement, depth sorting, rendering), cold columns only on demand
+// The entity number is the index into every column and stays valid until the entity is destroyed
+
+struct EntityTransformComponent final
 {
-	std::list<lwmf::IntPointStruct> PathFindingWayPoints{};
-	std::map<std::string, std::int_fast32_t> ContainedItem{};
-	EntityTypes Type{};
 	lwmf::FloatPointStruct Pos{};
 	lwmf::FloatPointStruct Dir{};
-	std::string TypeName;
-	std::int_fast32_t Number{};
-	std::int_fast32_t TypeNumber{};
-	std::int_fast32_t WaitTimer{};
-	std::int_fast32_t Hitpoints{};
-	std::int_fast32_t WalkAnimCounter{};
-	std::int_fast32_t WalkAnimStep{};
-	std::int_fast32_t WalkAnimStepWidth{};
-	std::int_fast32_t AttackMode{};
-	std::int_fast32_t AttackAnimCounter{};
-	std::int_fast32_t AttackAnimStep{};
-	std::int_fast32_t AttackAnimStepWidth{};
-	std::int_fast32_t HitAnimDuration{};
-	std::int_fast32_t HitAnimCounter{};
-	std::int_fast32_t KillAnimStep{};
-	std::int_fast32_t KillAnimStepWidth{};
-	std::int_fast32_t KillAnimCounter{};
-	std::int_fast32_t MovementBehaviour{};
 	std::int_fast32_t RotationFactor{};
-	std::int_fast32_t DamagePoints{};
-	std::int_fast32_t DamageHitrate{};
-	std::int_fast32_t DamageHitrateCounter{};
-	std::int_fast32_t PathFindingStart{};
-	std::int_fast32_t PathFindingTarget{};
 	float MoveSpeed{};
 	float MoveV{};
 	char Direction{ '\0' };
+};
+
+struct EntityStateComponent final
+{
+	EntityTypes Type{};
+	std::int_fast32_t TypeNumber{};
+	std::int_fast32_t MovementBehaviour{};
+	std::int_fast32_t AttackMode{};
+	std::int_fast32_t WaitTimer{};
 	bool AttackFinished{};
 	bool AttackAnimEnabled{};
 	bool KillAnimEnabled{};
 	bool IsPickedUp{};
 	bool IsDead{};
 	bool IsHit{};
+};
+
+struct EntityAnimationComponent final
+{
+	// Current frame, ticks spent on it and ticks per frame - indexed by EntityAnimStates
+	std::array<std::int_fast32_t, NumberOfEntityAnimStates> Step{};
+	std::array<std::int_fast32_t, NumberOfEntityAnimStates> Counter{};
+	std::array<std::int_fast32_t, NumberOfEntityAnimStates> StepWidth{};
+	std::int_fast32_t HitAnimDuration{};
+	TimerHandleStruct HitAnimTimer{};
+};
+
+struct EntityCombatComponent final
+{
+	std::int_fast32_t Hitpoints{};
+	std::int_fast32_t DamagePoints{};
+	std::int_fast32_t DamageHitrate{};
+	std::int_fast32_t DamageHitrateCounter{};
+};
+
+struct EntityLODComponent final
+{
+	EntityLODTiers Tier{};
+	std::int_fast32_t MidTickInterval{ 1 };
+	// Game tick until the entity stays awake after a noise
+	std::uint64_t AwakeUntilTick{};
+	float NearDistance{};
+	float FarDistance{};
+	float HearingDistance{};
+};
+
+struct EntityPathComponent final
+{
+	std::list<lwmf::IntPointStruct> PathFindingWayPoints{};
+	std::int_fast32_t PathFindingStart{};
+	std::int_fast32_t PathFindingTarget{};
 	bool ValidPathFound{};
 };
 
+struct EntityInfoComponent final
+{
+	std::map<std::string, std::int_fast32_t> ContainedItem{};
+	std::string TypeName;
+};
+
+// Handle of an entity - refers to the entity which lived in the slot when the handle was taken
+// Once the entity is destroyed (or the level is reloaded) the generation of its slot moves on and the handle is no longer valid
+struct EntityHandleStruct final
+{
+	std::int_fast32_t Number{ -1 };
+	std::uint_fast32_t Generation{};
+};
+
+struct EntityTableStruct final
+{
+	void Reserve(std::int_fast32_t Capacity);
+	std::int_fast32_t Create(EntityArchetypes Archetype);
+	void Destroy(std::int_fast32_t Number);
+	void Clear();
+	bool IsActive(std::int_fast32_t Number) const;
+	EntityHandleStruct GetHandle(std::int_fast32_t Number) const;
+	bool IsValid(const EntityHandleStruct& Handle) const;
+	std::int_fast32_t Size() const;
+
+	// Hot columns
+	std::vector<EntityTransformComponent> Transform{};
+	std::vector<EntityStateComponent> State{};
+	std::vector<EntityAnimationComponent> Animation{};
+	std::vector<EntityCombatComponent> Combat{};
+	std::vector<EntityLODComponent> LOD{};
+
+	// Cold columns
+	std::vector<EntityPathComponent> Path{};
+	std::vector<EntityInfoComponent> Info{};
+
+	// Entity numbers per archetype - systems iterate only the archetypes they are interested in
+	std::array<std::vector<std::int_fast32_t>, NumberOfEntityArchetypes> Archetypes{};
+	std::vector<EntityArchetypes> Archetype{};
+	std::vector<std::int_fast32_t> RowInArchetype{};
+
+	// Slots of destroyed entities, reused by Create()
+	std::vector<std::int_fast32_t> FreeSlots{};
+
+	// Generation per slot - not cleared by Clear(), so handles from a previous level never match a reused slot
+	std::vector<std::uint_fast32_t> Generation{};
+};
+
+inline void EntityTableStruct::Reserve(const std::int_fast32_t Capacity)
+{
+	// Spawning up to Capacity entities never reallocates a column - Clear() keeps the memory for the next level
+	const std::size_t NewCapacity{ static_cast<std::size_t>(Capacity) };
+
+	Transform.reserve(NewCapacity);
+	State.reserve(NewCapacity);
+	Animation.reserve(NewCapacity);
+	Combat.reserve(NewCapacity);
+	LOD.reserve(NewCapacity);
+	Path.reserve(NewCapacity);
+	Info.reserve(NewCapacity);
+	Archetype.reserve(NewCapacity);
+	RowInArchetype.reserve(NewCapacity);
+	FreeSlots.reserve(NewCapacity);
+	Generation.reserve(NewCapacity);
+
+	for (auto&& Members : Archetypes)
+	{
+		Members.reserve(NewCapacity);
+	}
+}
+
+inline std::int_fast32_t EntityTableStruct::Create(const EntityArchetypes NewArchetype)
+{
+	std::int_fast32_t Number{};
+
+	if (FreeSlots.empty())
+	{
+		Number = Size();
+
+		if (Number >= static_cast<std::int_fast32_t>(Generation.size()))
+		{
+			Generation.emplace_back();
+		}
+
+		Transform.emplace_back();
+		State.emplace_back();
+		Animation.emplace_back();
+		Combat.emplace_back();
+		LOD.emplace_back();
+		Path.emplace_back();
+		Info.emplace_back();
+		Archetype.emplace_back();
+		RowInArchetype.emplace_back();
+	}
+	else
+	{
+		Number = FreeSlots.back();
+		FreeSlots.pop_back();
+		Transform[Number] = {};
+		State[Number] = {};
+		Animation[Number] = {};
+		Combat[Number] = {};
+		LOD[Number] = {};
+		Path[Number] = {};
+		Info[Number] = {};
+	}
+
+	std::vector<std::int_fast32_t>& Members{ Archetypes[static_cast<std::int_fast32_t>(NewArchetype)] };
+	Archetype[Number] = NewArchetype;
+	RowInArchetype[Number] = static_cast<std::int_fast32_t>(Members.size());
+	Members.emplace_back(Number);
+
+	return Number;
+}
+
+inline void EntityTableStruct::Destroy(const std::int_fast32_t Number)
+{
+	if (!IsActive(Number))
+	{
+		return;
+	}
+
+	// Swap with the last member of the archetype, so the other entity numbers stay untouched
+	std::vector<std::int_fast32_t>& Members{ Archetypes[static_cast<std::int_fast32_t>(Archetype[Number])] };
+	const std::int_fast32_t Row{ RowInArchetype[Number] };
+	Members[Row] = Members.back();
+	RowInArchetype[Members[Row]] = Row;
+	Members.pop_back();
+
+	Archetype[Number] = EntityArchetypes::None;
+	Path[Number].PathFindingWayPoints.clear();
+	Info[Number].ContainedItem.clear();
+	++Generation[Number];
+	FreeSlots.emplace_back(Number);
+}
+
+inline void EntityTableStruct::Clear()
+{
+	// Invalidate the handles of all living entities - the columns are cleared, but keep their capacity
+	for (std::int_fast32_t Number{}; Number < Size(); ++Number)
+	{
+		if (Archetype[Number] != EntityArchetypes::None)
+		{
+			++Generation[Number];
+		}
+	}
+
+	Transform.clear();
+	State.clear();
+	Animation.clear();
+	Combat.clear();
+	LOD.clear();
+	Path.clear();
+	Info.clear();
+	Archetype.clear();
+	RowInArchetype.clear();
+	FreeSlots.clear();
+
+	for (auto&& Members : Archetypes)
+	{
+		Members.clear();
+	}
+}
+
+inline bool EntityTableStruct::IsActive(const std::int_fast32_t Number) const
+{
+	return Number >= 0 && Number < Size() && Archetype[Number] != EntityArchetypes::None;
+}
+
+inline EntityHandleStruct EntityTableStruct::GetHandle(const std::int_fast32_t Number) const
+{
+	return IsActive(Number) ? EntityHandleStruct{ Number, Generation[Number] } : EntityHandleStruct{};
+}
+
+inline bool EntityTableStruct::IsValid(const EntityHandleStruct& Handle) const
+{
+	return IsActive(Handle.Number) && Generation[Handle.Number] == Handle.Generation;
+}
+
+inline std::int_fast32_t EntityTableStruct::Size() const
+{
+	return static_cast<std::int_fast32_t>(Transform.size());
+}
+
 //
 // Structure for weapons
 //
@@ -100,22 +357,25 @@ struct WeaponStruct final
 	std::vector<lwmf::MP3Player> Sounds{};
 	lwmf::IntRectStruct WeaponRect{};
 	lwmf::IntRectStruct MuzzleFlashRect{};
-	std::string HUDAmmoInfo;
-	std::string HUDCarriedAmmoInfo;
 	std::string Name;
 	std::int_fast32_t Type{};
 	std::int_fast32_t ReloadDuration{};
-	std::int_fast32_t ReloadCounter{};
+	TimerHandleStruct ReloadTimer{};
 	std::int_fast32_t FadeInOutSpeed{};
 	std::int_fast32_t CarriedAmmo{};
 	std::int_fast32_t Number{};
 	std::int_fast32_t MuzzleFlashDuration{};
-	std::int_fast32_t MuzzleFlashCounter{};
 	std::int_fast32_t Capacity{};
 	std::int_fast32_t LoadedRounds{};
 	std::int_fast32_t Damage{};
 	std::int_fast32_t Cadence{};
-	std::int_fast32_t CadenceCounter{};
+	TimerHandleStruct CadenceTimer{};
+	std::int_fast32_t Pellets{ 1 };
+	float Spread{};
+	std::int_fast32_t ProjectileColor{};
+	std::int_fast32_t ProjectileLifeTime{};
+	float ProjectileSpeed{};
+	float ProjectileRadius{};
 	float Weight{};
 	float PaceFactor{};
 };
@@ -126,7 +386,7 @@ struct WeaponStruct final
 
 struct DoorTypeStruct final
 {
-	lwmf::TextureStruct OriginalTexture{};
+	Game_TextureCache::TextureHandle OriginalTexture{};
 	std::vector<lwmf::MP3Player> Sounds{};
 	std::int_fast32_t OpenCloseSpeed{};
 	std::int_fast32_t StayOpenTime{};
@@ -140,15 +400,15 @@ struct DoorStruct final
 	{
 		Closed,
 		Triggered,
-		Open
+		Open,
+		Closing
 	};
 
-	lwmf::TextureStruct AnimTexture{};
 	lwmf::FloatPointStruct Pos{};
 	States State{};
 	std::int_fast32_t DoorType{};
 	std::int_fast32_t Number{};
-	std::int_fast32_t StayOpenCounter{};
+	TimerHandleStruct StayOpenTimer{};
 	float CurrentOpenPercent{};
 	bool CloseAudioFlag{};
 };
@@ -158,7 +418,7 @@ struct DoorStruct final
 //
 
 inline std::vector<EntityAssetStruct> EntityAssets{};
-inline std::vector<EntityStruct> Entities{};
+inline EntityTableStruct Entities{};
 inline std::vector<WeaponStruct> Weapons{};
 inline std::vector<DoorTypeStruct> DoorTypes{};
 inline std::vector<DoorStruct> Doors{};
@@ -10,13 +10,20 @@
 #pragma once
 
 #include <cstdint>
+#include <climits>
+#include <cstddef>
 #include <string>
+#include <vector>
+#include <functional>
 
 #include "Game_GlobalDefinitions.hpp"
 #include "Tools_ErrorHandling.hpp"
 #include "Game_DataStructures.hpp"
 #include "Game_LevelHandling.hpp"
+#include "Game_AssetLoader.hpp"
 #include "Game_EntityHandling.hpp"
+#include "Game_SpatialIndex.hpp"
+#include "Game_TimingWheel.hpp"
 
 namespace Game_Doors
 {
@@ -27,11 +34,34 @@ namespace Game_Doors
 		OpenCloseSound
 	};
 
+	//
+	// Event driven doors
+	//
+	// Closed doors are dormant - only triggered, open and closing doors are in ActiveDoors and get processed per tick
+	// Doors are found via DoorIndex (one entry per map cell), so triggering and the raycaster do not scan all doors
+	// Once a door is fully open or closed again, it updates the wall layer and publishes an event to the subscribers (pathfinding, visibility...)
+	// The stay-open time is a timer on the timing wheel (in game ticks) - an open door starts closing as soon as its timer is no longer pending
+	// Level loads reset the timing wheel, so no door timer survives into the next level
+	//
+
+	enum class DoorEvents : std::int_fast32_t
+	{
+		Opened,
+		Closed
+	};
+
+	using DoorEventHandler = std::function<void(const DoorStruct&, DoorEvents)>;
+
 	void InitDoorAssets();
 	void InitDoors();
+	std::vector<std::int_fast32_t> GatherDoorIndices();
+	std::int_fast32_t GetDoorCell(const DoorStruct& Door);
+	std::int_fast32_t GetDoorAt(std::int_fast32_t x, std::int_fast32_t y);
+	void Subscribe(DoorEventHandler Handler);
+	void Publish(const DoorStruct& Door, DoorEvents Event);
 	void TriggerDoor();
-	void ModifyDoorTexture(DoorStruct& Door);
 	void OpenCloseDoors();
+	bool UpdateDoor(DoorStruct& Door);
 	void PlayAudio(const DoorStruct& Door, DoorSounds Sound);
 	void CloseAudio();
 
@@ -44,6 +74,13 @@ namespace Game_Doors
 	inline constexpr float MinimumOpenPercentLowerLimit{ 0.0F };
 	inline constexpr float MinimumOpenPercentUpperLimit{ 100.0F };
 
+	// Map cell (LevelMapWidth * y + x) -> door number, -1 if there is no door
+	inline std::vector<std::int_fast32_t> DoorIndex{};
+	// Numbers of all doors which are not closed
+	inline std::vector<std::int_fast32_t> ActiveDoors{};
+	// Subscribed once at startup, they stay valid across levels
+	inline std::vector<DoorEventHandler> EventHandlers{};
+
 	//
 	// Functions
 	//
@@ -60,6 +97,7 @@ namespace Game_Doors
 
 		// We start our DoorTypes counting at "1", since in the map definition it has to be greater zero!
 		std::int_fast32_t Index{ 1 };
+		std::vector<std::string> TextureFiles(1);
 
 		while (true)
 		{
@@ -72,7 +110,7 @@ namespace Game_Doors
 			{
 				DoorTypes.emplace_back();
 
-				lwmf::LoadPNG(DoorTypes[Index].OriginalTexture, lwmf::ReadINIValue<std::string>(INIFile, "TEXTURE", "DoorTexture"));
+				TextureFiles.emplace_back(lwmf::ReadINIValue<std::string>(INIFile, "TEXTURE", "DoorTexture"));
 
 				DoorTypes[Index].Sounds.emplace_back();
 				DoorTypes[Index].Sounds[static_cast<std::int_fast32_t>(DoorSounds::OpenCloseSound)].Load(lwmf::ReadINIValue<std::string>(INIFile, "AUDIO", "OpenCloseSound"));
@@ -92,6 +130,12 @@ namespace Game_Doors
 				break;
 			}
 		}
+
+		// DoorTypes is complete now - queue the textures
+		for (std::size_t Type{ 1 }; Type < TextureFiles.size(); ++Type)
+		{
+			Game_AssetLoader::AddTextureJob(TextureFiles[Type], DoorTypes[Type].OriginalTexture);
+		}
 	}
 
 	inline void InitDoors()
@@ -100,6 +144,8 @@ namespace Game_Doors
 
 		Doors.clear();
 		Doors.shrink_to_fit();
+		ActiveDoors.clear();
+		DoorIndex.assign(static_cast<std::size_t>(Game_LevelHandling::LevelMapWidth) * static_cast<std::size_t>(Game_LevelHandling::LevelMapHeight), -1);
 
 		for (std::int_fast32_t Index{}, MapPosX{}; MapPosX < Game_LevelHandling::LevelMapWidth; ++MapPosX)
 		{
@@ -111,16 +157,14 @@ namespace Game_Doors
 				{
 					Doors.emplace_back();
 
-					Doors[Index].AnimTexture = DoorTypes[FoundDoorType].OriginalTexture;
 					Doors[Index].Pos = { static_cast<float>(MapPosX), static_cast<float>(MapPosY) };
 					Doors[Index].State = DoorStruct::States::Closed;
 					Doors[Index].DoorType = FoundDoorType;
 					Doors[Index].Number = Index;
 					Doors[Index].CurrentOpenPercent = DoorTypes[Doors[Index].DoorType].MinimumOpenPercent;
 
-					ModifyDoorTexture(Doors[Index]);
-
 					Game_LevelHandling::LevelMap[static_cast<std::int_fast32_t>(Game_LevelHandling::LevelMapLayers::Wall)][MapPosX][MapPosY] = INT_MAX;
+					DoorIndex[Game_LevelHandling::LevelMapWidth * MapPosY + MapPosX] = Index;
 
 					++Index;
 				}
@@ -128,84 +172,129 @@ namespace Game_Doors
 		}
 	}
 
-	inline void TriggerDoor()
+	inline std::vector<std::int_fast32_t> GatherDoorIndices()
 	{
-		for (auto&& Door : Doors)
+		std::vector<std::int_fast32_t> DoorIndices{};
+
+		for (const auto& Door : Doors)
 		{
-			if (Door.State == DoorStruct::States::Closed && (std::abs(Door.Pos.X - Player.FuturePos.X) < FLT_EPSILON && std::abs(Door.Pos.Y - Player.FuturePos.Y) < FLT_EPSILON))
-			{
-				Door.State = DoorStruct::States::Triggered;
-				PlayAudio(Door, DoorSounds::OpenCloseSound);
-				break;
-			}
+			DoorIndices.emplace_back(GetDoorCell(Door));
+		}
+
+		return DoorIndices;
+	}
+
+	inline std::int_fast32_t GetDoorCell(const DoorStruct& Door)
+	{
+		return Game_LevelHandling::LevelMapWidth * static_cast<std::int_fast32_t>(Door.Pos.Y) + static_cast<std::int_fast32_t>(Door.Pos.X);
+	}
+
+	inline std::int_fast32_t GetDoorAt(const std::int_fast32_t x, const std::int_fast32_t y)
+	{
+		return DoorIndex[Game_LevelHandling::LevelMapWidth * y + x];
+	}
+
+	inline void Subscribe(DoorEventHandler Handler)
+	{
+		EventHandlers.emplace_back(std::move(Handler));
+	}
+
+	inline void Publish(const DoorStruct& Door, const DoorEvents Event)
+	{
+		// The door cell blocks as long as the door is not fully open
+		Game_LevelHandling::LevelMap[static_cast<std::int_fast32_t>(Game_LevelHandling::LevelMapLayers::Wall)][static_cast<std::int_fast32_t>(Door.Pos.X)][static_cast<std::int_fast32_t>(Door.Pos.Y)] = Event == DoorEvents::Opened ? 0 : INT_MAX;
+		++Game_LevelHandling::MapRevision;
+
+		for (const auto& Handler : EventHandlers)
+		{
+			Handler(Door, Event);
 		}
 	}
 
-	inline void ModifyDoorTexture(DoorStruct& Door)
+	inline void TriggerDoor()
 	{
-		// TextureOffset is not correct - works only when MaximumOpenPercent = 100% !
-		const float TextureOffset{ 100.0F / static_cast<float>(TextureSize) };
-		const std::int_fast32_t OpenPercent{ static_cast<std::int_fast32_t>(Door.CurrentOpenPercent / TextureOffset) };
+		const std::int_fast32_t DoorNumber{ GetDoorAt(Player.FuturePos.X, Player.FuturePos.Y) };
 
-		for (std::int_fast32_t y{}; y < TextureSize; ++y)
+		if (DoorNumber > -1 && Doors[DoorNumber].State == DoorStruct::States::Closed)
 		{
-			const std::int_fast32_t TempY{ y * TextureSize };
-			const auto SourceY{ DoorTypes[Door.DoorType].OriginalTexture.Pixels.begin() + TempY };
-			std::copy(SourceY, SourceY + TextureSize - OpenPercent, Door.AnimTexture.Pixels.begin() + TempY + OpenPercent);
+			DoorStruct& Door{ Doors[DoorNumber] };
+
+			Door.State = DoorStruct::States::Triggered;
+			ActiveDoors.emplace_back(DoorNumber);
+			PlayAudio(Door, DoorSounds::OpenCloseSound);
+			Game_EntityHandling::WakeEntities(Door.Pos);
 		}
 	}
 
 	inline void OpenCloseDoors()
 	{
-		for (auto&& Door : Doors)
+		// Backwards, so doors which are closed again can be swapped out of the list
+		for (std::int_fast32_t Index{ static_cast<std::int_fast32_t>(ActiveDoors.size()) - 1 }; Index >= 0; --Index)
 		{
-			// Open door
-			if (Door.State == DoorStruct::States::Triggered)
+			if (UpdateDoor(Doors[ActiveDoors[Index]]))
 			{
-				if (Door.CurrentOpenPercent < DoorTypes[Door.DoorType].MaximumOpenPercent)
-				{
-					Door.CurrentOpenPercent += DoorTypes[Door.DoorType].OpenCloseSpeed;
-					ModifyDoorTexture(Door);
-				}
+				ActiveDoors[Index] = ActiveDoors.back();
+				ActiveDoors.pop_back();
+			}
+		}
+	}
 
-				if (Door.CurrentOpenPercent >= DoorTypes[Door.DoorType].MaximumOpenPercent)
-				{
-					Door.State = DoorStruct::States::Open;
-					Door.StayOpenCounter = DoorTypes[Door.DoorType].StayOpenTime;
-					Door.CurrentOpenPercent = DoorTypes[Door.DoorType].MaximumOpenPercent;
-					Game_LevelHandling::LevelMap[static_cast<std::int_fast32_t>(Game_LevelHandling::LevelMapLayers::Wall)][static_cast<std::int_fast32_t>(Door.Pos.X)][static_cast<std::int_fast32_t>(Door.Pos.Y)] = 0;
-				}
+	inline bool UpdateDoor(DoorStruct& Door)
+	{
+		const DoorTypeStruct& DoorType{ DoorTypes[Door.DoorType] };
+
+		// Open door
+		if (Door.State == DoorStruct::States::Triggered)
+		{
+			if (Door.CurrentOpenPercent < DoorType.MaximumOpenPercent)
+			{
+				Door.CurrentOpenPercent += DoorType.OpenCloseSpeed;
 			}
 
-			// Close door - but first check if door is not blocked!
-			if (Door.State == DoorStruct::States::Open
-				&& Game_EntityHandling::EntityMap[static_cast<std::int_fast32_t>(Door.Pos.X)][static_cast<std::int_fast32_t>(Door.Pos.Y)] == EntityTypes::Clear
-				&& (std::abs(Player.Pos.X - Door.Pos.X) > FLT_EPSILON || std::abs(Player.Pos.Y - Door.Pos.Y) > FLT_EPSILON))
+			if (Door.CurrentOpenPercent >= DoorType.MaximumOpenPercent)
 			{
-				if (--Door.StayOpenCounter <= 0)
-				{
-					if (Door.CurrentOpenPercent >= DoorTypes[Door.DoorType].OpenCloseSpeed)
-					{
-						if (!Door.CloseAudioFlag)
-						{
-							PlayAudio(Door, DoorSounds::OpenCloseSound);
-							Door.CloseAudioFlag = true;
-						}
-
-						Door.CurrentOpenPercent -= DoorTypes[Door.DoorType].OpenCloseSpeed;
-						ModifyDoorTexture(Door);
-					}
-				}
+				Door.State = DoorStruct::States::Open;
+				// Nothing to do when the timer fires - the door starts closing once it is no longer pending
+				Door.StayOpenTimer = Game_TimingWheel::Schedule(DoorType.StayOpenTime, nullptr);
+				Door.CurrentOpenPercent = DoorType.MaximumOpenPercent;
+				Publish(Door, DoorEvents::Opened);
+			}
+		}
 
-				if (Door.CurrentOpenPercent <= DoorTypes[Door.DoorType].MinimumOpenPercent)
+		if (Door.State == DoorStruct::States::Open && !Game_TimingWheel::IsPending(Door.StayOpenTimer))
+		{
+			Door.State = DoorStruct::States::Closing;
+		}
+
+		// Close door - but first check if door is not blocked!
+		if (Door.State == DoorStruct::States::Closing
+			&& Game_SpatialIndex::IsCellEmpty(static_cast<std::int_fast32_t>(Door.Pos.X), static_cast<std::int_fast32_t>(Door.Pos.Y))
+			&& (std::abs(Player.Pos.X - Door.Pos.X) > FLT_EPSILON || std::abs(Player.Pos.Y - Door.Pos.Y) > FLT_EPSILON))
+		{
+			if (Door.CurrentOpenPercent >= DoorType.OpenCloseSpeed)
+			{
+				if (!Door.CloseAudioFlag)
 				{
-					Door.State = DoorStruct::States::Closed;
-					Door.CloseAudioFlag = false;
-					Door.CurrentOpenPercent = DoorTypes[Door.DoorType].MinimumOpenPercent;
-					Game_LevelHandling::LevelMap[static_cast<std::int_fast32_t>(Game_LevelHandling::LevelMapLayers::Wall)][static_cast<std::int_fast32_t>(Door.Pos.X)][static_cast<std::int_fast32_t>(Door.Pos.Y)] = INT_MAX;
+					PlayAudio(Door, DoorSounds::OpenCloseSound);
+					Door.CloseAudioFlag = true;
 				}
+
+				Door.CurrentOpenPercent -= DoorType.OpenCloseSpeed;
+			}
+
+			if (Door.CurrentOpenPercent <= DoorType.MinimumOpenPercent)
+			{
+				Door.State = DoorStruct::States::Closed;
+				Door.CloseAudioFlag = false;
+				Door.CurrentOpenPercent = DoorType.MinimumOpenPercent;
+				Publish(Door, DoorEvents::Closed);
+
+				// Dormant until it gets triggered again
+				return true;
 			}
 		}
+
+		return false;
 	}
 
 	inline void PlayAudio(const DoorStruct& Door, const DoorSounds Sound)
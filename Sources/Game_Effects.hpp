@@ -14,6 +14,7 @@
 #include <algorithm>
 
 #include "Tools_ErrorHandling.hpp"
+#include "Game_TimingWheel.hpp"
 
 namespace Game_Effects
 {
@@ -21,7 +22,6 @@ namespace Game_Effects
 
 	void InitEffects();
 	void StartBloodstainDrawing();
-	void CountdownBloodstainCounter();
 	void DrawBloodstain();
 
 	//
@@ -30,7 +30,7 @@ namespace Game_Effects
 
 	inline lwmf::ShaderClass BloodstainShader{};
 	inline std::int_fast32_t BloodstainDuration{};
-	inline std::int_fast32_t BloodstainCounter{};
+	inline TimerHandleStruct BloodstainTimer{};
 	inline bool BloodstainFlag{};
 
 	//
@@ -55,22 +55,18 @@ namespace Game_Effects
 	inline void StartBloodstainDrawing()
 	{
 		BloodstainFlag = true;
-		BloodstainCounter = BloodstainDuration;
-	}
-
-	inline void CountdownBloodstainCounter()
-	{
-		if (--BloodstainCounter == 0)
+		Game_TimingWheel::Cancel(BloodstainTimer);
+		BloodstainTimer = Game_TimingWheel::Schedule(BloodstainDuration, []
 		{
 			BloodstainFlag = false;
-		}
+		});
 	}
 
 	inline void DrawBloodstain()
 	{
 		if (BloodstainFlag)
 		{
-			BloodstainShader.RenderStaticTexture(&BloodstainShader.OGLTextureID, true, std::clamp(0.5F - (0.5F / static_cast<float>(BloodstainCounter)), 0.0F, 0.5F));
+			BloodstainShader.RenderStaticTexture(&BloodstainShader.OGLTextureID, true, std::clamp(0.5F - (0.5F / static_cast<float>(Game_TimingWheel::TicksLeft(BloodstainTimer))), 0.0F, 0.5F));
 		}
 	}
 
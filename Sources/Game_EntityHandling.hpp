@@ -10,25 +10,55 @@
 #pragma once
 
 #include <cstdint>
+#include <cstddef>
 #include <string>
 #include <vector>
-#include <random>
 #include <algorithm>
 #include <map>
 #include <utility>
 #include <tuple>
+#include <span>
 
 #include "Game_GlobalDefinitions.hpp"
 #include "Tools_ErrorHandling.hpp"
 #include "Game_DataStructures.hpp"
 #include "GFX_ImageHandling.hpp"
 #include "Game_LevelHandling.hpp"
+#include "Game_BakedLevel.hpp"
+#include "Game_AssetLoader.hpp"
 #include "Game_PathFinding.hpp"
+#include "Game_PathService.hpp"
+#include "Game_Visibility.hpp"
+#include "Game_SpatialIndex.hpp"
+#include "Game_TimingWheel.hpp"
 
 namespace Game_EntityHandling
 {
 
 
+	enum class RandomStreams : std::int_fast32_t
+	{
+		WaitChance,
+		WaitDuration,
+		TurnDirection
+	};
+
+	inline constexpr std::uint64_t NumberOfRandomStreams{ 3 };
+
+	// Result of the think phase of an entity, applied in the commit phase
+	struct EntityIntentStruct final
+	{
+		EntityTransformComponent Transform{};
+		EntityStateComponent State{};
+		EntityAnimationComponent Animation{};
+		std::int_fast32_t DamageHitrateCounter{};
+		std::int_fast32_t DamageToPlayer{};
+		bool RequestPath{};
+		bool PlayAttackSound{};
+		bool Moved{};
+		bool Killed{};
+	};
+
 	enum class EntitySounds : std::int_fast32_t
 	{
 		Kill			= 0,
@@ -36,27 +66,32 @@ namespace Game_EntityHandling
 		Attack			= 1
 	};
 
-	enum class SortOrder : std::int_fast32_t
-	{
-		FrontToBack,
-		BackToFront
-	};
-
 	void InitEntityAssets();
-	void LoadWalkAnimTextures(std::int_fast32_t AssetIndex, const std::string& AssetTypeName);
-	void LoadAdditionalAnimTextures(const std::string& AnimType, const std::string& AssetTypeName, std::vector<lwmf::TextureStruct>& AnimVector);
+	void LoadWalkAnimTextures(std::int_fast32_t AssetIndex, const std::string& AssetTypeName, std::vector<std::size_t>& TextureJobs);
+	void LoadAdditionalAnimTextures(const std::string& AnimType, const std::string& AssetTypeName, std::vector<Game_TextureCache::TextureHandle>& AnimVector, std::vector<std::size_t>& TextureJobs);
+	void CompileAnimations(EntityAssetStruct& Asset);
+	void AddAnimSequence(EntityAssetStruct& Asset, EntityAnimStates AnimState, const std::vector<Game_TextureCache::TextureHandle>& Textures, EntityAnimEnds End);
+	bool AdvanceAnimation(EntityAnimationComponent& Animation, const EntityAssetStruct& Asset, EntityAnimStates AnimState, std::int_fast32_t Ticks);
+	EntityAnimStates GetAnimState(const EntityStateComponent& State, const EntityAssetStruct& Asset);
+	const std::int_fast32_t* GetAnimFrame(const EntityAnimationComponent& Animation, const EntityAssetStruct& Asset, EntityAnimStates AnimState, std::int_fast32_t Direction);
 	void InitEntities();
-	void RenderEntities();
+	void ReadEntityDataFiles(std::int_fast32_t Level, std::vector<Game_BakedLevel::EntityRecordStruct>& Records);
+	void RenderEntity(std::int_fast32_t Index);
 	std::int_fast32_t GetEntityTextureIndex(std::int_fast32_t EntityNumber);
-	void HandleEntityHit(EntityStruct& Entity);
-	void SwitchDirection(EntityStruct& Entity, char Direction);
-	void ChangeEntityDirection(EntityStruct& Entity, char NewDirection);
-	void TurnEntityBackwards(EntityStruct& Entity);
-	void CalculateEntityPath(EntityStruct& Entity);
+	void HandleEntityHit(std::int_fast32_t EntityNumber, std::int_fast32_t Damage);
+	void SwitchDirection(EntityTransformComponent& Transform, char Direction);
+	void ChangeEntityDirection(EntityTransformComponent& Transform, char NewDirection);
+	void TurnEntityBackwards(EntityTransformComponent& Transform);
+	void CalculateEntityPath(std::int_fast32_t EntityNumber);
+	std::uint64_t GetEntityRandom(std::int_fast32_t EntityNumber, RandomStreams Stream);
+	void ThinkEntities(std::int_fast32_t First, std::int_fast32_t Last);
+	void ThinkEntity(std::int_fast32_t Index);
+	void CommitEntity(std::int_fast32_t Index);
+	void UpdateSimulationTier(std::int_fast32_t EntityNumber);
+	void WakeEntities(const lwmf::FloatPointStruct& Pos);
 	void MoveEntities();
-	void GetEntityDistance();
-	void SortEntities(SortOrder SortOrder);
-	void MarkEntityPositionOnMap(const EntityStruct& Entity);
+	void UpdateDepthOrder();
+	EntityArchetypes GetArchetype(EntityTypes Type);
 	void PlayAudio(std::int_fast32_t TypeNumber, EntitySounds EntitySound);
 	void CloseAudio();
 
@@ -80,17 +115,37 @@ namespace Game_EntityHandling
 		DirectionTuple(0.0F, -1.0F, 'W', 6)
 	};
 
-	// Populate the Mersenne-Twister-Random Engine with proper distributions
-	inline std::uniform_int_distribution<std::int_fast32_t> Distribution200(1, 200);
-	inline std::uniform_int_distribution<std::int_fast32_t> Distribution666(1, 666);
-
 	inline constexpr float EntityCollisionDetectionWallDist{ 0.5F };
 
-	inline std::vector<std::vector<EntityTypes>> EntityMap{};
-
-	// Vector used to sort the entities
+	// Two-phase entity update: "think" runs in parallel on a snapshot, "commit" applies the intents in entity number order
+	// Random numbers are derived from seed, tick and entity number, so the result does not depend on the number of threads
+	inline std::vector<std::int_fast32_t> SimulationOrder{};
+	inline std::vector<std::int_fast32_t> SimulationSteps{};
+	inline std::vector<EntityIntentStruct> Intents{};
+	inline constexpr std::int_fast32_t ThinkJobSize{ 64 };
+	inline std::uint64_t SimulationSeed{};
+	inline std::uint64_t SimulationTick{};
+
+	// Simulation LOD - near or visible entities tick every frame, mid range entities every MidTickInterval ticks and distant ones sleep
+	// Sleeping entities are checked only every SleepCheckInterval ticks, or woken by noise (shots, doors) within their hearing distance
+	inline constexpr std::int_fast32_t MidTickIntervalMin{ 1 };
+	inline constexpr std::int_fast32_t MidTickIntervalMax{ 8 };
+	inline constexpr std::int_fast32_t SleepCheckInterval{ 16 };
+	inline constexpr std::int_fast32_t WakeDuration{ 10 };
+	inline std::vector<std::int_fast32_t> WakeCandidates{};
+	inline float MaxHearingDistance{};
+
+	// Entity slots reserved per level - runtime spawns below this number never reallocate the entity table
+	inline constexpr std::int_fast32_t EntityPoolCapacity{ 1024 };
+
+	// Visible entities (entity number, view-space depth), sorted front to back
+	// Iterate forwards for front-to-back (weapon hit check) and backwards for back-to-front (rendering)
 	inline std::vector<std::pair<std::int_fast32_t, float>> EntityOrder{};
 
+	// Per entity scratch data for UpdateDepthOrder() - depth is negative if the entity was culled
+	inline std::vector<float> EntityDepth{};
+	inline std::vector<std::uint8_t> InEntityOrder{};
+
 	// 1D Zbuffer
 	inline std::vector<float> ZBuffer{};
 
@@ -107,97 +162,109 @@ namespace Game_EntityHandling
 		EntityAssets.clear();
 		EntityAssets.shrink_to_fit();
 
-		std::int_fast32_t AssetFileIndex{};
-		std::int_fast32_t AssetIndex{};
+		// Asset types used by the level - from the baked entity records if there is a bake (the pack does not contain the entity files then)
+		std::vector<std::string> AssetTypeNames{};
 
-		while (true) //-V776
+		if (Game_BakedLevel::IsOpen())
 		{
-			bool SkipAssetFlag{};
-
-			std::string EntityDataFile{ LevelFolder };
-			EntityDataFile += std::to_string(SelectedLevel);
-			EntityDataFile += "/EntityData/";
-			EntityDataFile += std::to_string(AssetFileIndex);
-			EntityDataFile += ".ini";
-
-			if (Tools_ErrorHandling::CheckFileExistence(EntityDataFile, ContinueOnError))
+			for (const auto& Record : Game_BakedLevel::GetSection<Game_BakedLevel::EntityRecordStruct>(Game_BakedLevel::Sections::Entities))
+			{
+				AssetTypeNames.emplace_back(Record.TypeName.data());
+			}
+		}
+		else
+		{
+			for (std::int_fast32_t AssetFileIndex{};; ++AssetFileIndex)
 			{
-				const std::string AssetTypeName{ lwmf::ReadINIValue<std::string>(EntityDataFile, "ENTITY", "EntityTypeName") };
+				std::string EntityDataFile{ LevelFolder };
+				EntityDataFile += std::to_string(SelectedLevel);
+				EntityDataFile += "/EntityData/";
+				EntityDataFile += std::to_string(AssetFileIndex);
+				EntityDataFile += ".ini";
 
-				// If asset type was already loaded, skip this...
-				for (const auto& Asset : EntityAssets)
+				if (!Tools_ErrorHandling::CheckFileExistence(EntityDataFile, ContinueOnError))
 				{
-					if (Asset.Name == AssetTypeName)
-					{
-						SkipAssetFlag = true;
-						break;
-					}
+					break;
 				}
 
-				std::string INIFile{ AssetsEntitiesFolder };
-				INIFile += AssetTypeName;
-				INIFile += "/AssetData.ini";
-
-				if (!SkipAssetFlag && Tools_ErrorHandling::CheckFileExistence(INIFile, StopOnError))
-				{
-					EntityAssets.emplace_back();
-					EntityAssets[AssetIndex].Number = AssetIndex;
-					EntityAssets[AssetIndex].Name = AssetTypeName;
+				AssetTypeNames.emplace_back(lwmf::ReadINIValue<std::string>(EntityDataFile, "ENTITY", "EntityTypeName"));
+			}
+		}
 
-					//
-					// Get GFX
-					//
+		std::int_fast32_t AssetIndex{};
 
-					NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Load entity textures...");
+		for (const auto& AssetTypeName : AssetTypeNames)
+		{
+			// If asset type was already loaded, skip this...
+			if (std::any_of(EntityAssets.begin(), EntityAssets.end(), [&](const auto& Asset) { return Asset.Name == AssetTypeName; }))
+			{
+				continue;
+			}
 
-					LoadWalkAnimTextures(AssetIndex, AssetTypeName);
-					LoadAdditionalAnimTextures("Attack", AssetTypeName, EntityAssets[AssetIndex].AttackTextures);
-					LoadAdditionalAnimTextures("Kill", AssetTypeName, EntityAssets[AssetIndex].KillTextures);
+			std::string INIFile{ AssetsEntitiesFolder };
+			INIFile += AssetTypeName;
+			INIFile += "/AssetData.ini";
 
-					//
-					// Get SFX
-					//
+			if (Tools_ErrorHandling::CheckFileExistence(INIFile, StopOnError))
+			{
+				EntityAssets.emplace_back();
+				EntityAssets[AssetIndex].Number = AssetIndex;
+				EntityAssets[AssetIndex].Name = AssetTypeName;
 
-					NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Load entity audio...");
+				//
+				// Get SFX
+				//
 
-					EntityAssets[AssetIndex].Sounds.clear();
-					EntityAssets[AssetIndex].Sounds.shrink_to_fit();
+				NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Load entity audio...");
 
-					if (const std::string AssetType{ lwmf::ReadINIValue<std::string>(INIFile, "GENERAL", "AssetType") }; AssetType == "AmmoBox")
-					{
-						// Get Pickup audio
-						EntityAssets[AssetIndex].Sounds.emplace_back();
-						EntityAssets[AssetIndex].Sounds[0].Load(lwmf::ReadINIValue<std::string>(INIFile, "AUDIO", "AmmoPickup"));
-					}
-					else if (AssetType == "Enemy" || AssetType == "Turret")
-					{
-						// Get KillSound audio
-						EntityAssets[AssetIndex].Sounds.emplace_back();
-						EntityAssets[AssetIndex].Sounds[0].Load(lwmf::ReadINIValue<std::string>(INIFile, "AUDIO", "KillSound"));
+				EntityAssets[AssetIndex].Sounds.clear();
+				EntityAssets[AssetIndex].Sounds.shrink_to_fit();
 
-						// Get AttackSound audio
-						EntityAssets[AssetIndex].Sounds.emplace_back();
-						EntityAssets[AssetIndex].Sounds[1].Load(lwmf::ReadINIValue<std::string>(INIFile, "AUDIO", "AttackSound"));
-					}
+				if (const std::string AssetType{ lwmf::ReadINIValue<std::string>(INIFile, "GENERAL", "AssetType") }; AssetType == "AmmoBox")
+				{
+					// Get Pickup audio
+					EntityAssets[AssetIndex].Sounds.emplace_back();
+					EntityAssets[AssetIndex].Sounds[0].Load(lwmf::ReadINIValue<std::string>(INIFile, "AUDIO", "AmmoPickup"));
+				}
+				else if (AssetType == "Enemy" || AssetType == "Turret")
+				{
+					// Get KillSound audio
+					EntityAssets[AssetIndex].Sounds.emplace_back();
+					EntityAssets[AssetIndex].Sounds[0].Load(lwmf::ReadINIValue<std::string>(INIFile, "AUDIO", "KillSound"));
 
-					++AssetIndex;
+					// Get AttackSound audio
+					EntityAssets[AssetIndex].Sounds.emplace_back();
+					EntityAssets[AssetIndex].Sounds[1].Load(lwmf::ReadINIValue<std::string>(INIFile, "AUDIO", "AttackSound"));
 				}
 
-				++AssetFileIndex;
-			}
-			else
-			{
-				break;
+				++AssetIndex;
 			}
 		}
+
+		//
+		// Get GFX
+		//
+		// Queued after all assets are known, so EntityAssets does not move anymore
+		// The animations of an asset are compiled as soon as all of its textures are decoded
+		//
+
+		NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Load entity textures...");
+
+		for (auto&& Asset : EntityAssets)
+		{
+			std::vector<std::size_t> TextureJobs{};
+
+			LoadWalkAnimTextures(Asset.Number, Asset.Name, TextureJobs);
+			LoadAdditionalAnimTextures("Attack", Asset.Name, Asset.AttackTextures, TextureJobs);
+			LoadAdditionalAnimTextures("Kill", Asset.Name, Asset.KillTextures, TextureJobs);
+
+			Game_AssetLoader::AddJob("Compile animations " + Asset.Name, [&Asset] { CompileAnimations(Asset); }, TextureJobs);
+		}
 	}
 
-	inline void LoadWalkAnimTextures(const std::int_fast32_t AssetIndex, const std::string& AssetTypeName)
+	inline void LoadWalkAnimTextures(const std::int_fast32_t AssetIndex, const std::string& AssetTypeName, std::vector<std::size_t>& TextureJobs)
 	{
-		EntityAssets[AssetIndex].WalkingTextures.clear(); //-V807
-		EntityAssets[AssetIndex].WalkingTextures.shrink_to_fit();
-
-		std::int_fast32_t DirectionIndex{};
+		std::vector<std::vector<std::string>> TextureFiles{};
 
 		while (true)
 		{
@@ -206,47 +273,55 @@ namespace Game_EntityHandling
 			Path += "/";
 			Path += AssetTypeName;
 			Path += "/";
-			Path += std::to_string(DirectionIndex);
+			Path += std::to_string(TextureFiles.size());
 
 			if (Tools_ErrorHandling::CheckFolderExistence(Path, ContinueOnError))
 			{
-				EntityAssets[AssetIndex].WalkingTextures.emplace_back();
-
-				std::int_fast32_t TextureIndex{};
+				TextureFiles.emplace_back();
 
 				while (true)
 				{
 					std::string Texture{ Path };
 					Texture += "/";
-					Texture += std::to_string(TextureIndex);
+					Texture += std::to_string(TextureFiles.back().size());
 					Texture += ".png";
 
 					if (Tools_ErrorHandling::CheckFileExistence(Texture, ContinueOnError))
 					{
-						EntityAssets[AssetIndex].WalkingTextures[DirectionIndex].emplace_back(GFX_ImageHandling::ImportTexture(Texture, EntitySize));
-						++TextureIndex;
+						TextureFiles.back().emplace_back(std::move(Texture));
 					}
 					else
 					{
 						break;
 					}
 				}
-
-				++DirectionIndex;
 			}
 			else
 			{
 				break;
 			}
 		}
+
+		// Allocate all handles first - the jobs write right into them
+		std::vector<std::vector<Game_TextureCache::TextureHandle>>& WalkingTextures{ EntityAssets[AssetIndex].WalkingTextures }; //-V807
+		WalkingTextures.clear();
+		WalkingTextures.shrink_to_fit();
+		WalkingTextures.resize(TextureFiles.size());
+
+		for (std::size_t DirectionIndex{}; DirectionIndex < TextureFiles.size(); ++DirectionIndex)
+		{
+			WalkingTextures[DirectionIndex].resize(TextureFiles[DirectionIndex].size());
+
+			for (std::size_t TextureIndex{}; TextureIndex < TextureFiles[DirectionIndex].size(); ++TextureIndex)
+			{
+				TextureJobs.emplace_back(Game_AssetLoader::AddTextureJob(TextureFiles[DirectionIndex][TextureIndex], WalkingTextures[DirectionIndex][TextureIndex], EntitySize));
+			}
+		}
 	}
 
-	inline void LoadAdditionalAnimTextures(const std::string& AnimType, const std::string& AssetTypeName, std::vector<lwmf::TextureStruct>& AnimVector)
+	inline void LoadAdditionalAnimTextures(const std::string& AnimType, const std::string& AssetTypeName, std::vector<Game_TextureCache::TextureHandle>& AnimVector, std::vector<std::size_t>& TextureJobs)
 	{
-		AnimVector.clear();
-		AnimVector.shrink_to_fit();
-
-		std::int_fast32_t TextureIndex{};
+		std::vector<std::string> TextureFiles{};
 
 		while (true)
 		{
@@ -257,104 +332,267 @@ namespace Game_EntityHandling
 			Texture += "/";
 			Texture += AnimType;
 			Texture += "/";
-			Texture += std::to_string(TextureIndex);
+			Texture += std::to_string(TextureFiles.size());
 			Texture += ".png";
 
 			if (Tools_ErrorHandling::CheckFileExistence(Texture, ContinueOnError))
 			{
-				AnimVector.emplace_back(GFX_ImageHandling::ImportTexture(Texture, EntitySize));
-				++TextureIndex;
+				TextureFiles.emplace_back(std::move(Texture));
 			}
 			else
 			{
 				break;
 			}
 		}
+
+		AnimVector.clear();
+		AnimVector.shrink_to_fit();
+		AnimVector.resize(TextureFiles.size());
+
+		for (std::size_t TextureIndex{}; TextureIndex < TextureFiles.size(); ++TextureIndex)
+		{
+			TextureJobs.emplace_back(Game_AssetLoader::AddTextureJob(TextureFiles[TextureIndex], AnimVector[TextureIndex], EntitySize));
+		}
+	}
+
+	inline void CompileAnimations(EntityAssetStruct& Asset)
+	{
+		// Flatten the texture sets into one table of frame pointers, so ticks and rendering address a frame with a single index
+		// Walk frames are stored direction by direction, attack and kill have no directions
+		Asset.AnimFrames.clear();
+
+		EntityAnimSequenceStruct& Walk{ Asset.AnimSequences[static_cast<std::int_fast32_t>(EntityAnimStates::Walk)] };
+		Walk = { 0, Asset.WalkingTextures.empty() ? 0 : static_cast<std::int_fast32_t>(Asset.WalkingTextures[0].size()), std::max(static_cast<std::int_fast32_t>(Asset.WalkingTextures.size()), static_cast<std::int_fast32_t>(1)), EntityAnimEnds::Loop };
+
+		if (Walk.NumberOfFrames == 0)
+		{
+			NARCLog.AddEntry(lwmf::LogLevel::Error, __FILENAME__, __LINE__, "CompileAnimations(): No walking textures found for " + Asset.Name + "!");
+		}
+
+		for (const auto& Direction : Asset.WalkingTextures)
+		{
+			for (std::int_fast32_t Step{}; Step < Walk.NumberOfFrames; ++Step)
+			{
+				// Directions with fewer frames repeat their last one
+				Asset.AnimFrames.emplace_back(Direction[std::min(Step, static_cast<std::int_fast32_t>(Direction.size()) - 1)]->Pixels.data());
+			}
+		}
+
+		AddAnimSequence(Asset, EntityAnimStates::Attack, Asset.AttackTextures, EntityAnimEnds::Rewind);
+		AddAnimSequence(Asset, EntityAnimStates::Kill, Asset.KillTextures, EntityAnimEnds::Hold);
+	}
+
+	inline void AddAnimSequence(EntityAssetStruct& Asset, const EntityAnimStates AnimState, const std::vector<Game_TextureCache::TextureHandle>& Textures, const EntityAnimEnds End)
+	{
+		Asset.AnimSequences[static_cast<std::int_fast32_t>(AnimState)] = { static_cast<std::int_fast32_t>(Asset.AnimFrames.size()), static_cast<std::int_fast32_t>(Textures.size()), 1, End };
+
+		for (const auto& Texture : Textures)
+		{
+			Asset.AnimFrames.emplace_back(Texture->Pixels.data());
+		}
+	}
+
+	inline bool AdvanceAnimation(EntityAnimationComponent& Animation, const EntityAssetStruct& Asset, const EntityAnimStates AnimState, const std::int_fast32_t Ticks)
+	{
+		// Returns true when a non-looping sequence passed its last frame
+		const std::int_fast32_t StateIndex{ static_cast<std::int_fast32_t>(AnimState) };
+		const EntityAnimSequenceStruct& Sequence{ Asset.AnimSequences[StateIndex] };
+
+		if ((Animation.Counter[StateIndex] += Ticks) <= Animation.StepWidth[StateIndex])
+		{
+			return false;
+		}
+
+		Animation.Counter[StateIndex] = 0;
+
+		if (Animation.Step[StateIndex] < Sequence.NumberOfFrames - 1)
+		{
+			++Animation.Step[StateIndex];
+			return false;
+		}
+
+		if (Sequence.End != EntityAnimEnds::Hold)
+		{
+			Animation.Step[StateIndex] = 0;
+		}
+
+		return Sequence.End != EntityAnimEnds::Loop;
+	}
+
+	inline EntityAnimStates GetAnimState(const EntityStateComponent& State, const EntityAssetStruct& Asset)
+	{
+		// Assets without attack or kill frames keep walking
+		if (State.AttackAnimEnabled && Asset.AnimSequences[static_cast<std::int_fast32_t>(EntityAnimStates::Attack)].NumberOfFrames > 0)
+		{
+			return EntityAnimStates::Attack;
+		}
+
+		if (State.KillAnimEnabled && Asset.AnimSequences[static_cast<std::int_fast32_t>(EntityAnimStates::Kill)].NumberOfFrames > 0)
+		{
+			return EntityAnimStates::Kill;
+		}
+
+		return EntityAnimStates::Walk;
+	}
+
+	inline const std::int_fast32_t* GetAnimFrame(const EntityAnimationComponent& Animation, const EntityAssetStruct& Asset, const EntityAnimStates AnimState, const std::int_fast32_t Direction)
+	{
+		const std::int_fast32_t StateIndex{ static_cast<std::int_fast32_t>(AnimState) };
+		const EntityAnimSequenceStruct& Sequence{ Asset.AnimSequences[StateIndex] };
+
+		return Asset.AnimFrames[static_cast<std::size_t>(Sequence.FirstFrame + (Direction % Sequence.NumberOfDirections) * Sequence.NumberOfFrames + Animation.Step[StateIndex])];
 	}
 
 	inline void InitEntities()
 	{
 		NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Init entities...");
 
-		Entities.clear();
-		Entities.shrink_to_fit();
-		EntityMap.clear();
-		EntityMap.shrink_to_fit();
+		// Pending hit timers belong to the entities of the previous level
+		for (auto&& Animation : Entities.Animation)
+		{
+			Game_TimingWheel::Cancel(Animation.HitAnimTimer);
+		}
+
+		// The table keeps its memory across levels, spawns during the level fill the reserved pool
+		Entities.Clear();
+		Entities.Reserve(EntityPoolCapacity);
 		EntityOrder.clear();
-		EntityOrder.shrink_to_fit();
+		EntityOrder.reserve(static_cast<std::size_t>(EntityPoolCapacity));
 		ZBuffer.clear();
 		ZBuffer.shrink_to_fit();
 		ZBuffer.resize(static_cast<size_t>(Canvas.Width));
 
-		EntityMap = std::vector<std::vector<EntityTypes>>(static_cast<size_t>(Game_LevelHandling::LevelMapWidth), std::vector<EntityTypes>(static_cast<size_t>(Game_LevelHandling::LevelMapHeight), EntityTypes::Clear));
+		Game_SpatialIndex::Init(Game_LevelHandling::LevelMapWidth, Game_LevelHandling::LevelMapHeight);
+
+		// Same seed and level - same simulation
+		SimulationSeed = lwmf::CounterRandom(GameSeed, static_cast<std::uint64_t>(RandomSubsystems::Entities), static_cast<std::uint64_t>(SelectedLevel));
+		SimulationTick = 0;
+		MaxHearingDistance = 0.0F;
+
+		std::vector<Game_BakedLevel::EntityRecordStruct> Records{};
+
+		if (Game_BakedLevel::IsOpen())
+		{
+			const std::span<const Game_BakedLevel::EntityRecordStruct> BakedRecords{ Game_BakedLevel::GetSection<Game_BakedLevel::EntityRecordStruct>(Game_BakedLevel::Sections::Entities) };
+			Records.assign(BakedRecords.begin(), BakedRecords.end());
+		}
+		else
+		{
+			ReadEntityDataFiles(SelectedLevel, Records);
+		}
+
+		const std::map<std::string, EntityTypes> EntityTypeCompare //-V808
+		{
+			{ "Clear", EntityTypes::Clear },
+			{ "Neutral", EntityTypes::Neutral },
+			{ "Enemy", EntityTypes::Enemy },
+			{ "Player", EntityTypes::Player },
+			{ "AmmoBox", EntityTypes::AmmoBox },
+			{ "Turret", EntityTypes::Turret }
+		};
+
+		for (const auto& Record : Records)
+		{
+			EntityTypes Type{ EntityTypes::Clear };
+
+			if (const auto TypeFound{ EntityTypeCompare.find(Record.EntityType.data()) }; TypeFound != EntityTypeCompare.end())
+			{
+				Type = TypeFound->second;
+			}
+			else
+			{
+				NARCLog.AddEntry(lwmf::LogLevel::Critical, __FILENAME__, __LINE__, "InitEntities(): Entity type wrong or not found!");
+			}
+
+			const std::int_fast32_t Number{ Entities.Create(GetArchetype(Type)) };
+
+			EntityTransformComponent& Transform{ Entities.Transform[Number] };
+			EntityStateComponent& State{ Entities.State[Number] };
+			EntityAnimationComponent& Animation{ Entities.Animation[Number] };
+			EntityCombatComponent& Combat{ Entities.Combat[Number] };
+			EntityInfoComponent& Info{ Entities.Info[Number] };
+
+			State.Type = Type;
+			Info.TypeName = Record.TypeName.data();
+			Animation.StepWidth[static_cast<std::int_fast32_t>(EntityAnimStates::Walk)] = Record.WalkAnimStepWidth;
+			Animation.StepWidth[static_cast<std::int_fast32_t>(EntityAnimStates::Attack)] = Record.AttackAnimStepWidth;
+			Animation.StepWidth[static_cast<std::int_fast32_t>(EntityAnimStates::Kill)] = Record.KillAnimStepWidth;
+			Transform.MoveV = Record.MoveV;
+			Transform.MoveSpeed = Record.MoveSpeed;
+			State.MovementBehaviour = Record.MovementBehaviour;
+			State.AttackMode = Record.AttackMode;
+			Transform.Pos = { Record.StartPosX, Record.StartPosY };
+
+			// Load/set direction data: Dir.X, Dir.Y, Direction, Rotationfactor
+			SwitchDirection(Transform, static_cast<char>(Record.Direction));
+
+			Combat.Hitpoints = Record.Hitpoints;
+			Animation.HitAnimDuration = Record.HitAnimDuration;
+			Combat.DamagePoints = Record.DamagePoints;
+			Combat.DamageHitrate = Record.DamageHitrate;
+			Info.ContainedItem[Record.ContainedItem.data()] = Record.ContainedItemValue;
+
+			EntityLODComponent& LOD{ Entities.LOD[Number] };
+			LOD.NearDistance = Record.NearDistance;
+			LOD.FarDistance = std::max(Record.FarDistance, LOD.NearDistance);
+			LOD.HearingDistance = Record.HearingDistance;
+			LOD.MidTickInterval = Record.MidTickInterval;
+			Tools_ErrorHandling::CheckAndClampRange(LOD.MidTickInterval, MidTickIntervalMin, MidTickIntervalMax, __FILENAME__, "MidTickInterval");
+			MaxHearingDistance = std::max(MaxHearingDistance, LOD.HearingDistance);
+
+			// Assign proper asset data (= texture set) to entity
+			for (const auto& Asset : EntityAssets)
+			{
+				if (Info.TypeName == Asset.Name)
+				{
+					State.TypeNumber = Asset.Number;
+					break;
+				}
+			}
+
+			Game_SpatialIndex::UpdateEntity(Number);
+		}
+	}
 
+	inline void ReadEntityDataFiles(const std::int_fast32_t Level, std::vector<Game_BakedLevel::EntityRecordStruct>& Records)
+	{
 		std::int_fast32_t Index{};
 
 		while (true)
 		{
 			std::string INIFile{ LevelFolder };
-			INIFile += std::to_string(SelectedLevel);
+			INIFile += std::to_string(Level);
 			INIFile += "/EntityData/";
 			INIFile += std::to_string(Index);
 			INIFile += ".ini";
 
 			if (Tools_ErrorHandling::CheckFileExistence(INIFile, ContinueOnError))
 			{
-				EntityOrder.emplace_back();
-				Entities.emplace_back();
-				Entities[Index].Number = Index;
-				Entities[Index].TypeName = lwmf::ReadINIValue<std::string>(INIFile, "ENTITY", "EntityTypeName");
-
-				const std::string EntityTypeString{ lwmf::ReadINIValue<std::string>(INIFile, "ENTITY", "EntityType") }; //-V808
-
-				const std::map<std::string, EntityTypes> EntityTypeCompare //-V808
-				{
-					{ "Clear", EntityTypes::Clear },
-					{ "Neutral", EntityTypes::Neutral },
-					{ "Enemy", EntityTypes::Enemy },
-					{ "Player", EntityTypes::Player },
-					{ "AmmoBox", EntityTypes::AmmoBox },
-					{ "Turret", EntityTypes::Turret }
-				};
-
-				if (const auto Type{ EntityTypeCompare.find(EntityTypeString) }; Type != EntityTypeCompare.end())
-				{
-					Entities[Index].Type = Type->second;
-				}
-				else
-				{
-					NARCLog.AddEntry(lwmf::LogLevel::Critical, __FILENAME__, __LINE__, "InitEntities(): Entity type wrong or not found!");
-				}
-
-				Entities[Index].WalkAnimStepWidth = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "ENTITY", "WalkAnimStepWidth");
-				Entities[Index].AttackAnimStepWidth = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "ENTITY", "AttackAnimStepWidth");
-				Entities[Index].KillAnimStepWidth = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "ENTITY", "KillAnimStepWidth");
-				Entities[Index].MoveV = lwmf::ReadINIValue<float>(INIFile, "ENTITY", "EntityMoveV");
-				Entities[Index].MoveSpeed = lwmf::ReadINIValue<float>(INIFile, "MOVEMENT", "MoveSpeed");
-				Entities[Index].MovementBehaviour = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "MOVEMENT", "MovementBehaviour");
-				Entities[Index].AttackMode = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "MOVEMENT", "AttackMode");
-				Entities[Index].Pos = { lwmf::ReadINIValue<float>(INIFile, "POSITION", "StartPosX"), lwmf::ReadINIValue<float>(INIFile, "POSITION", "StartPosY") };
-
-				// Load/set direction data: Dir.X, Dir.Y, Direction, Rotationfactor
-				SwitchDirection(Entities[Index], lwmf::ReadINIValue<char>(INIFile, "DIRECTION", "Direction"));
-
-				Entities[Index].Hitpoints = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "STATUS", "Hitpoints");
-				Entities[Index].HitAnimDuration = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "STATUS", "HitAnimDuration");
-				Entities[Index].DamagePoints = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "DAMAGE", "DamagePoints");
-				Entities[Index].DamageHitrate = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "DAMAGE", "DamageHitrate");
-				Entities[Index].ContainedItem[lwmf::ReadINIValue<std::string>(INIFile, "CONTAINS", "ContainedItem")] = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "CONTAINS", "ContainedItemValue");
-
-				// Assign proper asset data (= texture set) to entity
-				for (const auto& Asset : EntityAssets)
-				{
-					if (Entities[Index].TypeName == Asset.Name)
-					{
-						Entities[Index].TypeNumber = Asset.Number;
-						break;
-					}
-				}
+				Game_BakedLevel::EntityRecordStruct& Record{ Records.emplace_back() };
+
+				Game_BakedLevel::CopyString(Record.TypeName, lwmf::ReadINIValue<std::string>(INIFile, "ENTITY", "EntityTypeName"));
+				Game_BakedLevel::CopyString(Record.EntityType, lwmf::ReadINIValue<std::string>(INIFile, "ENTITY", "EntityType"));
+				Record.WalkAnimStepWidth = static_cast<std::int32_t>(lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "ENTITY", "WalkAnimStepWidth"));
+				Record.AttackAnimStepWidth = static_cast<std::int32_t>(lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "ENTITY", "AttackAnimStepWidth"));
+				Record.KillAnimStepWidth = static_cast<std::int32_t>(lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "ENTITY", "KillAnimStepWidth"));
+				Record.MoveV = lwmf::ReadINIValue<float>(INIFile, "ENTITY", "EntityMoveV");
+				Record.MoveSpeed = lwmf::ReadINIValue<float>(INIFile, "MOVEMENT", "MoveSpeed");
+				Record.MovementBehaviour = static_cast<std::int32_t>(lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "MOVEMENT", "MovementBehaviour"));
+				Record.AttackMode = static_cast<std::int32_t>(lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "MOVEMENT", "AttackMode"));
+				Record.StartPosX = lwmf::ReadINIValue<float>(INIFile, "POSITION", "StartPosX");
+				Record.StartPosY = lwmf::ReadINIValue<float>(INIFile, "POSITION", "StartPosY");
+				Record.Direction = lwmf::ReadINIValue<char>(INIFile, "DIRECTION", "Direction");
+				Record.Hitpoints = static_cast<std::int32_t>(lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "STATUS", "Hitpoints"));
+				Record.HitAnimDuration = static_cast<std::int32_t>(lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "STATUS", "HitAnimDuration"));
+				Record.DamagePoints = static_cast<std::int32_t>(lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "DAMAGE", "DamagePoints"));
+				Record.DamageHitrate = static_cast<std::int32_t>(lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "DAMAGE", "DamageHitrate"));
+				Game_BakedLevel::CopyString(Record.ContainedItem, lwmf::ReadINIValue<std::string>(INIFile, "CONTAINS", "ContainedItem"));
+				Record.ContainedItemValue = static_cast<std::int32_t>(lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "CONTAINS", "ContainedItemValue"));
+				Record.NearDistance = lwmf::ReadINIValue<float>(INIFile, "LOD", "NearDistance");
+				Record.FarDistance = lwmf::ReadINIValue<float>(INIFile, "LOD", "FarDistance");
+				Record.HearingDistance = lwmf::ReadINIValue<float>(INIFile, "LOD", "HearingDistance");
+				Record.MidTickInterval = static_cast<std::int32_t>(lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "LOD", "MidTickInterval"));
 
-				MarkEntityPositionOnMap(Entities[Index]);
 				++Index;
 			}
 			else
@@ -364,66 +602,56 @@ namespace Game_EntityHandling
 		}
 	}
 
-	inline void RenderEntities()
+	inline void RenderEntity(const std::int_fast32_t Index)
 	{
 		const float InverseMatrix{ 1.0F / (Plane.X * Player.Dir.Y - Player.Dir.X * Plane.Y) };
 		const std::int_fast32_t VerticalLookTemp{ Canvas.Height + VerticalLook };
-		const std::int_fast32_t NumberOfEntities{ static_cast<std::int_fast32_t>(Entities.size()) };
 
-		for (std::int_fast32_t Index{}; Index < NumberOfEntities; ++Index)
+		const std::int_fast32_t Number{ EntityOrder[Index].first };
+		const EntityStateComponent& State{ Entities.State[Number] };
+
+		// Additional check if Loot is not picked up...
+		if (!State.IsPickedUp)
 		{
-			// Additional check if Loot is not picked up...
-			if (!Entities[EntityOrder[Index].first].IsPickedUp)
+			const EntityTransformComponent& Transform{ Entities.Transform[Number] };
+			const EntityAnimationComponent& Animation{ Entities.Animation[Number] };
+			const EntityAssetStruct& Asset{ EntityAssets[State.TypeNumber] };
+
+			const lwmf::FloatPointStruct EntityPos{ Transform.Pos.X - Player.Pos.X, Transform.Pos.Y - Player.Pos.Y };
+			const float TransY{ InverseMatrix * (-Plane.Y * EntityPos.X + Plane.X * EntityPos.Y) };
+			const std::int_fast32_t vScreen{ static_cast<std::int_fast32_t>(Transform.MoveV / TransY) };
+			const std::int_fast32_t EntitySizeTemp{ static_cast<std::int_fast32_t>(Canvas.Height / TransY) };
+			const std::int_fast32_t Temp{ (VerticalLookTemp >> 1) + vScreen };
+			const std::int_fast32_t LineStartY{ std::max(-(EntitySizeTemp >> 1) + Temp, 0) };
+			const std::int_fast32_t LineEndY{ std::min((EntitySizeTemp >> 1) + Temp, Canvas.Height) };
+			const std::int_fast32_t EntitySX{ static_cast<std::int_fast32_t>(Canvas.WidthMid * (1.0F + InverseMatrix * (Player.Dir.Y * EntityPos.X - Player.Dir.X * EntityPos.Y) / TransY)) };
+			const std::int_fast32_t LineEndX{ std::min((EntitySizeTemp >> 1) + EntitySX, Canvas.Width) };
+			const std::int_fast32_t Temp1{ (-EntitySizeTemp >> 1) + EntitySX };
+			const std::int_fast32_t Temp2{ VerticalLookTemp << 7 };
+			const std::int_fast32_t Temp3{ EntitySizeTemp << 7 };
+			// Frame is the same for every pixel of the entity
+			const std::int_fast32_t* const Frame{ GetAnimFrame(Animation, Asset, GetAnimState(State, Asset), GetEntityTextureIndex(Index)) };
+
+			for (std::int_fast32_t x{ (-EntitySizeTemp >> 1) + EntitySX }; x < LineEndX; ++x)
 			{
-				const lwmf::FloatPointStruct EntityPos{ Entities[EntityOrder[Index].first].Pos.X - Player.Pos.X, Entities[EntityOrder[Index].first].Pos.Y - Player.Pos.Y };
-				const float TransY{ InverseMatrix * (-Plane.Y * EntityPos.X + Plane.X * EntityPos.Y) };
-				const std::int_fast32_t vScreen{ static_cast<std::int_fast32_t>(Entities[EntityOrder[Index].first].MoveV / TransY) };
-				const std::int_fast32_t EntitySizeTemp{ static_cast<std::int_fast32_t>(Canvas.Height / TransY) };
-				const std::int_fast32_t Temp{ (VerticalLookTemp >> 1) + vScreen };
-				const std::int_fast32_t LineStartY{ std::max(-(EntitySizeTemp >> 1) + Temp, 0) };
-				const std::int_fast32_t LineEndY{ std::min((EntitySizeTemp >> 1) + Temp, Canvas.Height) };
-				const std::int_fast32_t EntitySX{ static_cast<std::int_fast32_t>(Canvas.WidthMid * (1.0F + InverseMatrix * (Player.Dir.Y * EntityPos.X - Player.Dir.X * EntityPos.Y) / TransY)) };
-				const std::int_fast32_t LineEndX{ std::min((EntitySizeTemp >> 1) + EntitySX, Canvas.Width) };
-				const std::int_fast32_t Temp1{ (-EntitySizeTemp >> 1) + EntitySX };
-				const std::int_fast32_t Temp2{ VerticalLookTemp << 7 };
-				const std::int_fast32_t Temp3{ EntitySizeTemp << 7 };
-				const std::int_fast32_t TextureIndex{ GetEntityTextureIndex(Index) };
-
-				for (std::int_fast32_t x{ (-EntitySizeTemp >> 1) + EntitySX }; x < LineEndX; ++x)
+				if (TransY > 0.0F && (static_cast<std::uint_fast32_t>(x) < static_cast<std::uint_fast32_t>(Canvas.Width)) && TransY < ZBuffer[x])
 				{
-					if (TransY > 0.0F && (static_cast<std::uint_fast32_t>(x) < static_cast<std::uint_fast32_t>(Canvas.Width)) && TransY < ZBuffer[x])
+					const std::int_fast32_t TextureX{ (x - Temp1) * EntitySize / EntitySizeTemp };
+
+					for (std::int_fast32_t y{ LineStartY }; y < LineEndY; ++y)
 					{
-						const std::int_fast32_t TextureX{ (x - Temp1) * EntitySize / EntitySizeTemp };
+						const std::int_fast32_t Color{ Frame[((((((y - vScreen) << 8) - Temp2 + Temp3) * EntitySize) / EntitySizeTemp) >> 8) * EntitySize + TextureX] };
 
-						for (std::int_fast32_t y{ LineStartY }; y < LineEndY; ++y)
+						// Check if alphachannel of pixel ist not transparent and draw pixel
+						if ((Color & lwmf::AMask) != 0)
 						{
-							std::int_fast32_t Color{};
-							const std::int_fast32_t PixelOffset{ ((((((y - vScreen) << 8) - Temp2 + Temp3) * EntitySize) / EntitySizeTemp) >> 8) * EntitySize + TextureX };
-
-							if (Entities[Entities[EntityOrder[Index].first].Number].AttackAnimEnabled)
+							if (State.IsHit && !State.KillAnimEnabled)
 							{
-								Color = EntityAssets[Entities[Entities[EntityOrder[Index].first].Number].TypeNumber].AttackTextures[Entities[EntityOrder[Index].first].AttackAnimStep].Pixels[PixelOffset];
-							}
-							else if (Entities[Entities[EntityOrder[Index].first].Number].KillAnimEnabled)
-							{
-								Color = EntityAssets[Entities[Entities[EntityOrder[Index].first].Number].TypeNumber].KillTextures[Entities[EntityOrder[Index].first].KillAnimStep].Pixels[PixelOffset];
+								lwmf::SetPixel(Canvas, x, y, Color | 0xFFFFFF00);
 							}
 							else
 							{
-								Color = EntityAssets[Entities[Entities[EntityOrder[Index].first].Number].TypeNumber].WalkingTextures[TextureIndex][Entities[EntityOrder[Index].first].WalkAnimStep].Pixels[PixelOffset];
-							}
-
-							// Check if alphachannel of pixel ist not transparent and draw pixel
-							if ((Color & lwmf::AMask) != 0)
-							{
-								if (Entities[EntityOrder[Index].first].IsHit && !Entities[EntityOrder[Index].first].KillAnimEnabled)
-								{
-									lwmf::SetPixel(Canvas, x, y, Color | 0xFFFFFF00);
-								}
-								else
-								{
-									Game_LevelHandling::LightingFlag ? (lwmf::SetPixel(Canvas, x, y, lwmf::ShadeColor(Color, TransY, FogOfWarDistance))) : lwmf::SetPixel(Canvas, x, y, Color);
-								}
+								Game_LevelHandling::LightingFlag ? (lwmf::SetPixel(Canvas, x, y, lwmf::ShadeColor(Color, TransY, FogOfWarDistance))) : lwmf::SetPixel(Canvas, x, y, Color);
 							}
 						}
 					}
@@ -437,7 +665,8 @@ namespace Game_EntityHandling
 		// Get angle between player and entity without atan2
 		// Returns TextureIndex (0..7) for adressing correct texture
 
-		const lwmf::FloatPointStruct EntityTemp{ Entities[Entities[EntityOrder[EntityNumber].first].Number].Pos.X - Player.Pos.X, Entities[Entities[EntityOrder[EntityNumber].first].Number].Pos.Y - Player.Pos.Y };
+		const EntityTransformComponent& Transform{ Entities.Transform[EntityOrder[EntityNumber].first] };
+		const lwmf::FloatPointStruct EntityTemp{ Transform.Pos.X - Player.Pos.X, Transform.Pos.Y - Player.Pos.Y };
 		const float CosTheta1{ (EntityTemp.X + EntityTemp.Y) * lwmf::SQRT1_2 };
 		const float CosTheta3{ (EntityTemp.Y - EntityTemp.X) * lwmf::SQRT1_2 };
 		float ClosestTheta{ EntityTemp.X };
@@ -486,47 +715,63 @@ namespace Game_EntityHandling
 		}
 
 		// Add rotation factor to Textureindex dependent on heading direction of entity
-		const std::int_fast32_t TextureIndexTemp{ TextureIndex + Entities[Entities[EntityOrder[EntityNumber].first].Number].RotationFactor };
+		const std::int_fast32_t TextureIndexTemp{ TextureIndex + Transform.RotationFactor };
 		return TextureIndexTemp < 8 ? TextureIndexTemp : TextureIndexTemp - 8;
 	}
 
-	inline void HandleEntityHit(EntityStruct& Entity)
+	inline void HandleEntityHit(const std::int_fast32_t EntityNumber, const std::int_fast32_t Damage)
 	{
-		if (Entity.Type != EntityTypes::AmmoBox)
+		EntityStateComponent& State{ Entities.State[EntityNumber] };
+
+		if (State.Type != EntityTypes::AmmoBox)
 		{
-			Entity.IsHit = true;
-			Entity.AttackMode = 1;
-			Entity.Type = EntityTypes::Enemy;
+			EntityAnimationComponent& Animation{ Entities.Animation[EntityNumber] };
+			EntityCombatComponent& Combat{ Entities.Combat[EntityNumber] };
+
+			State.IsHit = true;
+			State.AttackMode = 1;
+			Entities.LOD[EntityNumber].Tier = EntityLODTiers::Full;
+			State.Type = EntityTypes::Enemy;
 
 			// Is entity still alive?
-			if (Entity.Hitpoints > 0)
+			if (Combat.Hitpoints > 0)
 			{
-				Entity.Hitpoints -= Weapons[Player.SelectedWeapon].Damage;
-				Entity.HitAnimCounter += Entity.HitAnimDuration;
+				Combat.Hitpoints -= Damage;
+				// Hits while the hit animation runs extend it
+				const std::int_fast32_t HitAnimTicks{ Game_TimingWheel::TicksLeft(Animation.HitAnimTimer) + Animation.HitAnimDuration };
+				Game_TimingWheel::Cancel(Animation.HitAnimTimer);
+				Animation.HitAnimTimer = Game_TimingWheel::Schedule(HitAnimTicks, [Handle{ Entities.GetHandle(EntityNumber) }]
+				{
+					// The slot may belong to another entity by now
+					if (Entities.IsValid(Handle))
+					{
+						Entities.State[Handle.Number].IsHit = false;
+					}
+				});
 			}
 
-			if (Entity.Hitpoints <= 0 && !Entity.KillAnimEnabled)
+			if (Combat.Hitpoints <= 0 && !State.KillAnimEnabled)
 			{
-				PlayAudio(Entity.TypeNumber, EntitySounds::Kill);
+				PlayAudio(State.TypeNumber, EntitySounds::Kill);
 
 				// Entity is killed, now the death animation needs to be rendered...
 				// Will be set to "IsDead" in MoveEntities()
-				Entity.KillAnimEnabled = true;
-				Entity.AttackAnimEnabled = false;
-				Entity.AttackFinished = true;
+				State.KillAnimEnabled = true;
+				State.AttackAnimEnabled = false;
+				State.AttackFinished = true;
 			}
 		}
 	}
 
-	inline void SwitchDirection(EntityStruct& Entity, const char Direction)
+	inline void SwitchDirection(EntityTransformComponent& Transform, const char Direction)
 	{
 		const auto it{ std::find_if(Directions.begin(), Directions.end(), [&](const auto &e) {return std::get<2>(e) == Direction; }) };
 
 		if (it != Directions.end())
 		{
-			Entity.Dir = { std::get<0>(*it), std::get<1>(*it) };
-			Entity.Direction = std::get<2>(*it);
-			Entity.RotationFactor = std::get<3>(*it);
+			Transform.Dir = { std::get<0>(*it), std::get<1>(*it) };
+			Transform.Direction = std::get<2>(*it);
+			Transform.RotationFactor = std::get<3>(*it);
 		}
 		else
 		{
@@ -535,36 +780,36 @@ namespace Game_EntityHandling
 		}
 	}
 
-	inline void ChangeEntityDirection(EntityStruct& Entity, const char NewDirection)
+	inline void ChangeEntityDirection(EntityTransformComponent& Transform, const char NewDirection)
 	{
 		switch (NewDirection)
 		{
 			case 'l':
 			{
-				switch (Entity.Direction)
+				switch (Transform.Direction)
 				{
 					case 'N':
 					{
 						// Turn left (-> West) if moved North previously
-						SwitchDirection(Entity, 'W');
+						SwitchDirection(Transform, 'W');
 						break;
 					}
 					case 'S':
 					{
 						// Turn left (-> East) if moved South previously
-						SwitchDirection(Entity, 'E');
+						SwitchDirection(Transform, 'E');
 						break;
 					}
 					case 'E':
 					{
 						// Turn left (-> North) if moved East previously
-						SwitchDirection(Entity, 'N');
+						SwitchDirection(Transform, 'N');
 						break;
 					}
 					case 'W':
 					{
 						// Turn left (-> South) if moved West previously
-						SwitchDirection(Entity, 'S');
+						SwitchDirection(Transform, 'S');
 						break;
 					}
 					default: {}
@@ -573,30 +818,30 @@ namespace Game_EntityHandling
 			}
 			case 'r':
 			{
-				switch (Entity.Direction)
+				switch (Transform.Direction)
 				{
 					case 'N':
 					{
 						// Turn right (-> East) if moved North previously
-						SwitchDirection(Entity, 'E');
+						SwitchDirection(Transform, 'E');
 						break;
 					}
 					case 'S':
 					{
 						// Turn right (-> West) if moved South previously
-						SwitchDirection(Entity, 'W');
+						SwitchDirection(Transform, 'W');
 						break;
 					}
 					case 'E':
 					{
 						// Turn right (-> South) if moved East previously
-						SwitchDirection(Entity, 'S');
+						SwitchDirection(Transform, 'S');
 						break;
 					}
 					case 'W':
 					{
 						// Turn right (-> North) if moved West previously
-						SwitchDirection(Entity, 'N');
+						SwitchDirection(Transform, 'N');
 						break;
 					}
 					default: {}
@@ -607,246 +852,493 @@ namespace Game_EntityHandling
 		}
 	}
 
-	inline void TurnEntityBackwards(EntityStruct& Entity)
+	inline void TurnEntityBackwards(EntityTransformComponent& Transform)
 	{
-		switch (Entity.Direction)
+		switch (Transform.Direction)
 		{
 			case 'N':
 			{
-				SwitchDirection(Entity, 'S');
+				SwitchDirection(Transform, 'S');
 				break;
 			}
 			case 'E':
 			{
-				SwitchDirection(Entity, 'W');
+				SwitchDirection(Transform, 'W');
 				break;
 			}
 			case 'S':
 			{
-				SwitchDirection(Entity, 'N');
+				SwitchDirection(Transform, 'N');
 				break;
 			}
 			case 'W':
 			{
-				SwitchDirection(Entity, 'E');
+				SwitchDirection(Transform, 'E');
 				break;
 			}
 			default:{}
 		}
 	}
 
-	inline void CalculateEntityPath(EntityStruct& Entity)
+	inline void CalculateEntityPath(const std::int_fast32_t EntityNumber)
 	{
-		if (Entity.Type == EntityTypes::Enemy || Entity.Type == EntityTypes::Neutral)
+		if (const EntityTypes Type{ Entities.State[EntityNumber].Type }; Type == EntityTypes::Enemy || Type == EntityTypes::Neutral)
 		{
-			Entity.PathFindingWayPoints.clear();
+			const EntityTransformComponent& Transform{ Entities.Transform[EntityNumber] };
+			EntityPathComponent& Path{ Entities.Path[EntityNumber] };
 
-			Entity.PathFindingStart = Game_LevelHandling::LevelMapWidth * static_cast<std::int_fast32_t>(Entity.Pos.Y) + static_cast<std::int_fast32_t>(Entity.Pos.X);
-			Entity.PathFindingTarget = Game_LevelHandling::LevelMapWidth * static_cast<std::int_fast32_t>(Player.Pos.Y) + static_cast<std::int_fast32_t>(Player.Pos.X); //-V778
+			Path.PathFindingStart = Game_LevelHandling::LevelMapWidth * static_cast<std::int_fast32_t>(Transform.Pos.Y) + static_cast<std::int_fast32_t>(Transform.Pos.X);
+			Path.PathFindingTarget = Game_LevelHandling::LevelMapWidth * static_cast<std::int_fast32_t>(Player.Pos.Y) + static_cast<std::int_fast32_t>(Player.Pos.X); //-V778
 
-			Entity.ValidPathFound = Game_PathFinding::CalculatePath(Game_PathFinding::FlattenedMap, Game_LevelHandling::LevelMapWidth, Game_LevelHandling::LevelMapHeight, Entity.PathFindingStart, Entity.PathFindingTarget, false, Entity.PathFindingWayPoints);
+			// Solved asynchronously - the entity keeps its last valid path until the result arrives
+			const float DistX{ Player.Pos.X - Transform.Pos.X };
+			const float DistY{ Player.Pos.Y - Transform.Pos.Y };
+			Game_PathService::RequestPath(EntityNumber, Path.PathFindingStart, Path.PathFindingTarget, DistX * DistX + DistY * DistY);
 		}
 	}
 
-	inline void MoveEntities()
+	inline std::uint64_t GetEntityRandom(const std::int_fast32_t EntityNumber, const RandomStreams Stream)
+	{
+		// Counter-based: one stream per entity and purpose, the tick is the counter
+		// The result does not depend on the thread or the order in which the entities are processed
+		return lwmf::CounterRandom(SimulationSeed, static_cast<std::uint64_t>(EntityNumber) * NumberOfRandomStreams + static_cast<std::uint64_t>(Stream), SimulationTick);
+	}
+
+	inline void ThinkEntities(const std::int_fast32_t First, const std::int_fast32_t Last)
+	{
+		for (std::int_fast32_t Index{ First }; Index < Last; ++Index)
+		{
+			ThinkEntity(Index);
+		}
+	}
+
+	inline void ThinkEntity(const std::int_fast32_t Index)
 	{
-		for (auto&& Entity : Entities)
+		// Runs in parallel - reads the world as it was at the start of the tick and writes only into its own intent
+
+		const std::int_fast32_t Number{ SimulationOrder[Index] };
+		// Mid range entities tick less often, but with larger steps
+		const std::int_fast32_t StepScale{ SimulationSteps[Index] };
+		const EntityCombatComponent& Combat{ Entities.Combat[Number] };
+		EntityIntentStruct& Intent{ Intents[Index] };
+
+		Intent = { Entities.Transform[Number], Entities.State[Number], Entities.Animation[Number], Combat.DamageHitrateCounter };
+
+		EntityTransformComponent& Transform{ Intent.Transform };
+		EntityStateComponent& State{ Intent.State };
+		EntityAnimationComponent& Animation{ Intent.Animation };
+
+		const EntityAssetStruct& Asset{ EntityAssets[State.TypeNumber] };
+
+		if (!State.IsDead && State.KillAnimEnabled)
 		{
-			if (Entity.IsHit && --Entity.HitAnimCounter == 0)
+			if (AdvanceAnimation(Animation, Asset, EntityAnimStates::Kill, 1))
 			{
-				Entity.IsHit = false;
+				State.IsDead = true;
+				// ...and gets removed from the spatial index, but the pile stays...
+				State.MovementBehaviour = 0;
+				Intent.Killed = true;
 			}
 
-			if (!Entity.IsDead && Entity.KillAnimEnabled && ++Entity.KillAnimCounter > Entity.KillAnimStepWidth)
-			{
-				if (Entity.KillAnimStep < static_cast<std::int_fast32_t>(EntityAssets[Entity.TypeNumber].KillTextures.size()) - 1)
-				{
-					++Entity.KillAnimStep;
-				}
-				else
-				{
-					Entity.IsDead = true;
-					// ...and gets cleared from EntityMap, but the pile stays...
-					Entity.MovementBehaviour = 0;
-					EntityMap[static_cast<std::int_fast32_t>(Entity.Pos.X)][static_cast<std::int_fast32_t>(Entity.Pos.Y)] = EntityTypes::Clear;
-				}
+			return;
+		}
 
-				Entity.KillAnimCounter = 0;
-				break;
+		if (!State.IsDead && !State.KillAnimEnabled)
+		{
+			// Run A* pathfinding routine...
+			Intent.RequestPath = true;
+
+			// Enemies which see the player get alerted and attack without a pause
+			if (State.Type == EntityTypes::Enemy && State.AttackMode == 0 && Game_Visibility::CanSeePlayer(Number))
+			{
+				State.AttackMode = 1;
+				State.WaitTimer = 0;
 			}
 
-			if (!Entity.IsDead && !Entity.KillAnimEnabled)
+			switch (State.MovementBehaviour)
 			{
-				// Run A* pathfinding routine...
-				CalculateEntityPath(Entity);
+				case 0:
+				{
+					//
+					// Stationary
+					//
 
-				switch (Entity.MovementBehaviour)
+					break;
+				}
+				case 2:
 				{
-					case 0:
-					{
-						//
-						// Stationary
-						//
+					//
+					// Free roaming mode
+					//
 
-						// Refresh ammo position on map once another entity moved over this position
-						if (Entity.Type == EntityTypes::AmmoBox && EntityMap[static_cast<std::int_fast32_t>(Entity.Pos.X)][static_cast<std::int_fast32_t>(Entity.Pos.Y)] == EntityTypes::Clear)
-						{
-							MarkEntityPositionOnMap(Entity);
-						}
-						break;
-					}
-					case 2:
+					const float StepWidth{ Transform.MoveSpeed };
+					const float EntityCollisionDetectionFactor{ StepWidth + EntityCollisionDetectionWallDist };
+
+					// Wait by chance
+					// Check if a chance hit occured and if no current timer is running
+					if (State.WaitTimer == 0 && GetEntityRandom(Number, RandomStreams::WaitChance) % 666 == 98 && State.AttackMode == 0)
 					{
-						//
-						// Free roaming mode
-						//
+						State.WaitTimer = static_cast<std::int_fast32_t>(1 + GetEntityRandom(Number, RandomStreams::WaitDuration) % 200);
+					}
 
-						const float EntityCollisionDetectionFactor{ Entity.MoveSpeed + EntityCollisionDetectionWallDist };
+					// Switch textures for walking animations
+					const bool Waiting{ State.WaitTimer > 0 };
 
-						EntityMap[static_cast<std::int_fast32_t>(Entity.Pos.X)][static_cast<std::int_fast32_t>(Entity.Pos.Y)] = EntityTypes::Clear;
+					if (Waiting)
+					{
+						State.WaitTimer = std::max(State.WaitTimer - StepScale, static_cast<std::int_fast32_t>(0));
+						Animation.Step[static_cast<std::int_fast32_t>(EntityAnimStates::Walk)] = 0;
+					}
+					else
+					{
+						AdvanceAnimation(Animation, Asset, EntityAnimStates::Walk, StepScale);
+					}
 
-						// Wait by chance
-						// Check if a chance hit occured and if no current timer is running
-						if (Entity.WaitTimer == 0 && Distribution666(RNG) == 99 && Entity.AttackMode == 0)
-						{
-							Entity.WaitTimer = static_cast<std::int_fast32_t>(Distribution200(RNG));
-						}
+					// Switch textures for attack animations
+					if (State.AttackAnimEnabled && AdvanceAnimation(Animation, Asset, EntityAnimStates::Attack, 1))
+					{
+						State.AttackAnimEnabled = false;
+						State.AttackFinished = true;
+					}
 
-						// Switch textures for walking animations
-						if (Entity.WaitTimer > 0)
-						{
-							--Entity.WaitTimer;
-							Entity.WalkAnimStep = 0;
-						}
-						else
+					// Mid range entities do StepScale single steps - every one is checked, so no wall, entity or player gets skipped
+					// The first step which runs into something ends the move
+					for (std::int_fast32_t SubStep{}; SubStep < (Waiting ? 1 : StepScale); ++SubStep)
+					{
+						if (!Waiting)
 						{
-							if (EntityAssets[Entity.TypeNumber].WalkingTextures[0].size() == 1)
-							{
-								// Not animated
-								Entity.WalkAnimStep = 0;
-							}
-							else
-							{
-								// animated
-								if (++Entity.WalkAnimCounter > Entity.WalkAnimStepWidth)
-								{
-									Entity.WalkAnimStep < static_cast<std::int_fast32_t>(EntityAssets[Entity.TypeNumber].WalkingTextures[0].size()) - 1 ? ++Entity.WalkAnimStep : Entity.WalkAnimStep = 0;
-									Entity.WalkAnimCounter = 0;
-								}
-							}
-
 							// Move forward
-							Entity.Pos.X += Entity.Dir.X * Entity.MoveSpeed;
-							Entity.Pos.Y += Entity.Dir.Y * Entity.MoveSpeed;
-						}
-
-						// Switch textures for attack animations
-						if (Entity.AttackAnimEnabled && ++Entity.AttackAnimCounter > Entity.AttackAnimStepWidth)
-						{
-							if (Entity.AttackAnimStep < static_cast<std::int_fast32_t>(EntityAssets[Entity.TypeNumber].AttackTextures.size()) - 1)
-							{
-								++Entity.AttackAnimStep;
-							}
-							else
-							{
-								Entity.AttackAnimStep = 0;
-								Entity.AttackAnimEnabled = false;
-								Entity.AttackFinished = true;
-							}
-
-							Entity.AttackAnimCounter = 0;
+							Transform.Pos.X += Transform.Dir.X * StepWidth;
+							Transform.Pos.Y += Transform.Dir.Y * StepWidth;
 						}
 
-						const std::int_fast32_t EntityPosXTemp{ static_cast<std::int_fast32_t>(Entity.Pos.X + Entity.Dir.X * EntityCollisionDetectionFactor) };
-						const std::int_fast32_t EntityPosYTemp{ static_cast<std::int_fast32_t>(Entity.Pos.Y + Entity.Dir.Y * EntityCollisionDetectionFactor) };
+						const std::int_fast32_t EntityPosXTemp{ static_cast<std::int_fast32_t>(Transform.Pos.X + Transform.Dir.X * EntityCollisionDetectionFactor) };
+						const std::int_fast32_t EntityPosYTemp{ static_cast<std::int_fast32_t>(Transform.Pos.Y + Transform.Dir.Y * EntityCollisionDetectionFactor) };
 
 						if (Game_LevelHandling::LevelMap[static_cast<std::int_fast32_t>(Game_LevelHandling::LevelMapLayers::Wall)][EntityPosXTemp][EntityPosYTemp] != 0)
 						{
-							Entity.Pos.X -= Entity.Dir.X * Entity.MoveSpeed;
-							Entity.Pos.Y -= Entity.Dir.Y * Entity.MoveSpeed;
+							Transform.Pos.X -= Transform.Dir.X * StepWidth;
+							Transform.Pos.Y -= Transform.Dir.Y * StepWidth;
 
 							// Random choice of new direction (left or right)
-							ChangeEntityDirection(Entity, "lr"[rand() % 2]);
+							ChangeEntityDirection(Transform, "lr"[GetEntityRandom(Number, RandomStreams::TurnDirection) % 2]);
+							break;
 						}
+
 						// Turn backwards if stepping on another enemy or neutral entity
-						else if (EntityMap[EntityPosXTemp][EntityPosYTemp] == EntityTypes::Enemy
-							|| EntityMap[EntityPosXTemp][EntityPosYTemp] == EntityTypes::Neutral
-							|| EntityMap[EntityPosXTemp][EntityPosYTemp] == EntityTypes::Turret)
+						if (Game_SpatialIndex::IsBlocked(EntityPosXTemp, EntityPosYTemp, Number))
 						{
-							TurnEntityBackwards(Entity);
+							TurnEntityBackwards(Transform);
+							break;
 						}
+
 						// What happens if entity meets player?
-						else if (EntityMap[EntityPosXTemp][EntityPosYTemp] == EntityTypes::Player)
+						if (Game_SpatialIndex::IsPlayerCell(EntityPosXTemp, EntityPosYTemp))
 						{
 							// Deal damage to player
-							if (Entity.Type == EntityTypes::Enemy)
+							if (State.Type == EntityTypes::Enemy)
 							{
-								Entity.Pos.X -= Entity.Dir.X * Entity.MoveSpeed;
-								Entity.Pos.Y -= Entity.Dir.Y * Entity.MoveSpeed;
+								Transform.Pos.X -= Transform.Dir.X * StepWidth;
+								Transform.Pos.Y -= Transform.Dir.Y * StepWidth;
 
-								if (--Entity.DamageHitrateCounter <= 0)
+								if (--Intent.DamageHitrateCounter <= 0)
 								{
-									PlayAudio(Entity.TypeNumber, EntitySounds::Attack);
-									Entity.DamageHitrateCounter = Entity.DamageHitrate * static_cast<std::int_fast32_t>(FrameLock);
-									Entity.AttackAnimEnabled = true;
+									Intent.PlayAttackSound = true;
+									Intent.DamageHitrateCounter = Combat.DamageHitrate * static_cast<std::int_fast32_t>(FrameLock);
+									State.AttackAnimEnabled = true;
 
 									// Once it attacked, entity is in "rage" mode, so it will attack without a pause...
-									Entity.AttackMode = 1;
+									State.AttackMode = 1;
 								}
 							}
-							else if (Entity.Type == EntityTypes::Neutral)
+							else if (State.Type == EntityTypes::Neutral)
 							{
-								TurnEntityBackwards(Entity);
+								TurnEntityBackwards(Transform);
 							}
-						}
 
-						if (Entity.AttackFinished)
-						{
-							Player.HurtPlayer(Entity.DamagePoints);
-							Entity.AttackFinished = false;
+							break;
 						}
+					}
 
-						MarkEntityPositionOnMap(Entity);
-						break;
+					if (State.AttackFinished)
+					{
+						Intent.DamageToPlayer = Combat.DamagePoints;
+						State.AttackFinished = false;
 					}
 
-					default:{}
+					Intent.Moved = true;
+					break;
 				}
+
+				default:{}
 			}
 		}
 	}
 
-	inline void GetEntityDistance()
+	inline void CommitEntity(const std::int_fast32_t Index)
 	{
-		const std::int_fast32_t NumberOfEntities{ static_cast<std::int_fast32_t>(Entities.size()) };
+		const std::int_fast32_t Number{ SimulationOrder[Index] };
+		EntityIntentStruct& Intent{ Intents[Index] };
+
+		if (Intent.RequestPath)
+		{
+			CalculateEntityPath(Number);
+		}
 
+		// Resolve tile conflicts - if an entity with a lower number moved into the same cell during this tick, this one turns back
+		if (Intent.Moved)
+		{
+			const lwmf::FloatPointStruct& OldPos{ Entities.Transform[Number].Pos };
+			const std::int_fast32_t NewPosX{ static_cast<std::int_fast32_t>(Intent.Transform.Pos.X) };
+			const std::int_fast32_t NewPosY{ static_cast<std::int_fast32_t>(Intent.Transform.Pos.Y) };
+
+			if ((NewPosX != static_cast<std::int_fast32_t>(OldPos.X) || NewPosY != static_cast<std::int_fast32_t>(OldPos.Y)) && Game_SpatialIndex::IsBlocked(NewPosX, NewPosY, Number))
+			{
+				Intent.Transform.Pos = OldPos;
+				TurnEntityBackwards(Intent.Transform);
+			}
+		}
+
+		Entities.Transform[Number] = Intent.Transform;
+		Entities.State[Number] = Intent.State;
+		Entities.Animation[Number] = Intent.Animation;
+		Entities.Combat[Number].DamageHitrateCounter = Intent.DamageHitrateCounter;
+
+		if (Intent.Moved)
+		{
+			Game_SpatialIndex::UpdateEntity(Number);
+		}
+
+		if (Intent.Killed)
+		{
+			Game_SpatialIndex::Remove(Number);
+		}
+
+		if (Intent.PlayAttackSound)
+		{
+			PlayAudio(Intent.State.TypeNumber, EntitySounds::Attack);
+		}
+
+		if (Intent.DamageToPlayer > 0)
+		{
+			Player.HurtPlayer(Intent.DamageToPlayer);
+		}
+	}
+
+	inline void UpdateSimulationTier(const std::int_fast32_t EntityNumber)
+	{
+		const EntityStateComponent& State{ Entities.State[EntityNumber] };
+		EntityLODComponent& LOD{ Entities.LOD[EntityNumber] };
+
+		// Dead entities are just piles - nothing left to simulate
+		if (State.IsDead)
+		{
+			LOD.Tier = EntityLODTiers::Sleep;
+			return;
+		}
+
+		const float DistX{ Player.Pos.X - Entities.Transform[EntityNumber].Pos.X };
+		const float DistY{ Player.Pos.Y - Entities.Transform[EntityNumber].Pos.Y };
+		const float DistanceSquared{ DistX * DistX + DistY * DistY };
+
+		if (Game_TimingWheel::CurrentTick < LOD.AwakeUntilTick || State.IsHit || State.KillAnimEnabled || State.AttackAnimEnabled || DistanceSquared <= LOD.NearDistance * LOD.NearDistance || Game_Visibility::CanSeePlayer(EntityNumber))
+		{
+			LOD.Tier = EntityLODTiers::Full;
+		}
+		else if (DistanceSquared <= LOD.FarDistance * LOD.FarDistance)
+		{
+			LOD.Tier = EntityLODTiers::Mid;
+		}
+		else
+		{
+			LOD.Tier = EntityLODTiers::Sleep;
+		}
+	}
+
+	inline void WakeEntities(const lwmf::FloatPointStruct& Pos)
+	{
+		// Only entities within hearing distance of the noise are woken up
+		Game_SpatialIndex::QueryRadius(Pos, MaxHearingDistance, WakeCandidates);
+
+		for (const std::int_fast32_t Number : WakeCandidates)
+		{
+			const float DistX{ Pos.X - Entities.Transform[Number].Pos.X };
+			const float DistY{ Pos.Y - Entities.Transform[Number].Pos.Y };
+
+			if (EntityLODComponent& LOD{ Entities.LOD[Number] }; DistX * DistX + DistY * DistY <= LOD.HearingDistance * LOD.HearingDistance)
+			{
+				LOD.Tier = EntityLODTiers::Full;
+				LOD.AwakeUntilTick = Game_TimingWheel::CurrentTick + static_cast<std::uint64_t>(WakeDuration) * FrameLock;
+			}
+		}
+	}
+
+	inline void MoveEntities()
+	{
+		// Pickups never move, so only mobile entities and turrets are updated
+		// Sorted by entity number, so the commit phase always runs in the same order
+		SimulationOrder.clear();
+
+		for (const EntityArchetypes Archetype : { EntityArchetypes::Mobile, EntityArchetypes::Turret })
+		{
+			const std::vector<std::int_fast32_t>& Members{ Entities.Archetypes[static_cast<std::int_fast32_t>(Archetype)] };
+			SimulationOrder.insert(SimulationOrder.end(), Members.begin(), Members.end());
+		}
+
+		std::sort(SimulationOrder.begin(), SimulationOrder.end());
+
+		// Select the entities which tick this frame - ticks of mid range and sleeping entities are spread by entity number
+		SimulationSteps.clear();
+		std::int_fast32_t NumberOfTicking{};
+
+		for (const std::int_fast32_t Number : SimulationOrder)
+		{
+			const std::uint64_t Phase{ SimulationTick + static_cast<std::uint64_t>(Number) };
+			EntityLODComponent& LOD{ Entities.LOD[Number] };
+
+			if (LOD.Tier == EntityLODTiers::Sleep && Phase % SleepCheckInterval != 0)
+			{
+				continue;
+			}
+
+			UpdateSimulationTier(Number);
+
+			if (LOD.Tier == EntityLODTiers::Full)
+			{
+				SimulationOrder[NumberOfTicking++] = Number;
+				SimulationSteps.emplace_back(1);
+			}
+			else if (LOD.Tier == EntityLODTiers::Mid && Phase % static_cast<std::uint64_t>(LOD.MidTickInterval) == 0)
+			{
+				SimulationOrder[NumberOfTicking++] = Number;
+				SimulationSteps.emplace_back(LOD.MidTickInterval);
+			}
+		}
+
+		SimulationOrder.resize(static_cast<std::size_t>(NumberOfTicking));
+
+		const std::int_fast32_t NumberOfEntities{ static_cast<std::int_fast32_t>(SimulationOrder.size()) };
+		Intents.resize(static_cast<std::size_t>(NumberOfEntities));
+
+		// Think phase
+		if (NumberOfEntities > ThinkJobSize)
+		{
+			for (std::int_fast32_t First{}; First < NumberOfEntities; First += ThinkJobSize)
+			{
+				ThreadPool.AddThread(&ThinkEntities, First, std::min(First + ThinkJobSize, NumberOfEntities));
+			}
+
+			ThreadPool.WaitForThreads();
+		}
+		else
+		{
+			ThinkEntities(0, NumberOfEntities);
+		}
+
+		// Commit phase
 		for (std::int_fast32_t Index{}; Index < NumberOfEntities; ++Index)
 		{
-			EntityOrder[Index] = { Index, lwmf::CalcEuclidianDistance<float>(Player.Pos.X, Entities[Index].Pos.X, Player.Pos.Y, Entities[Index].Pos.Y) };
+			CommitEntity(Index);
 		}
+
+		++SimulationTick;
 	}
 
-	inline void SortEntities(const SortOrder SortOrder)
+	inline void UpdateDepthOrder()
 	{
-		switch (SortOrder)
+		const float InverseMatrix{ 1.0F / (Plane.X * Player.Dir.Y - Player.Dir.X * Plane.Y) };
+		const std::int_fast32_t NumberOfSlots{ Entities.Size() };
+
+		// Cull picked up entities and entities outside the view, get view-space depth of the rest
+		// (the depth is the same value the renderer uses - no square root needed)
+		EntityDepth.assign(static_cast<std::size_t>(NumberOfSlots), -1.0F);
+
+		for (const auto& Members : Entities.Archetypes)
 		{
-			case SortOrder::FrontToBack:
+			for (const std::int_fast32_t Number : Members)
 			{
-				std::sort(EntityOrder.begin(), EntityOrder.end(), [](auto& Left, auto& Right) {	return Left.second < Right.second; });
-				break;
+				if (Entities.State[Number].IsPickedUp)
+				{
+					continue;
+				}
+
+				const lwmf::FloatPointStruct EntityPos{ Entities.Transform[Number].Pos.X - Player.Pos.X, Entities.Transform[Number].Pos.Y - Player.Pos.Y };
+				const float TransY{ InverseMatrix * (-Plane.Y * EntityPos.X + Plane.X * EntityPos.Y) };
+
+				// Behind the player
+				if (TransY <= 0.0F)
+				{
+					continue;
+				}
+
+				const float EntitySX{ static_cast<float>(Canvas.WidthMid) * (1.0F + InverseMatrix * (Player.Dir.Y * EntityPos.X - Player.Dir.X * EntityPos.Y) / TransY) };
+				const float HalfEntitySize{ static_cast<float>(Canvas.Height) / TransY * 0.5F };
+
+				// Left or right of the screen
+				if (EntitySX + HalfEntitySize < 0.0F || EntitySX - HalfEntitySize >= static_cast<float>(Canvas.Width))
+				{
+					continue;
+				}
+
+				EntityDepth[Number] = TransY;
 			}
-			case SortOrder::BackToFront:
+		}
+
+		// Keep the order of the last frame - drop culled entities and refresh the depth of the remaining ones
+		InEntityOrder.assign(static_cast<std::size_t>(NumberOfSlots), 0);
+
+		EntityOrder.erase(std::remove_if(EntityOrder.begin(), EntityOrder.end(), [&](const auto& Entry) { return Entry.first >= NumberOfSlots || EntityDepth[Entry.first] < 0.0F; }), EntityOrder.end());
+
+		for (auto&& Entry : EntityOrder)
+		{
+			Entry.second = EntityDepth[Entry.first];
+			InEntityOrder[Entry.first] = 1;
+		}
+
+		// Add entities which became visible
+		for (std::int_fast32_t Number{}; Number < NumberOfSlots; ++Number)
+		{
+			if (EntityDepth[Number] >= 0.0F && InEntityOrder[Number] == 0)
 			{
-				std::sort(EntityOrder.begin(), EntityOrder.end(), [](auto& Left, auto& Right) {	return Left.second > Right.second; });
-				break;
+				EntityOrder.emplace_back(Number, EntityDepth[Number]);
 			}
-			default: {}
+		}
+
+		// The order changes only slightly from frame to frame, so insertion sort is close to linear here
+		const std::int_fast32_t NumberOfEntries{ static_cast<std::int_fast32_t>(EntityOrder.size()) };
+
+		for (std::int_fast32_t i{ 1 }; i < NumberOfEntries; ++i)
+		{
+			const std::pair<std::int_fast32_t, float> Entry{ EntityOrder[i] };
+			std::int_fast32_t j{ i };
+
+			while (j > 0 && EntityOrder[j - 1].second > Entry.second)
+			{
+				EntityOrder[j] = EntityOrder[j - 1];
+				--j;
+			}
+
+			EntityOrder[j] = Entry;
 		}
 	}
 
-	inline void MarkEntityPositionOnMap(const EntityStruct& Entity)
+	inline EntityArchetypes GetArchetype(const EntityTypes Type)
 	{
-		EntityMap[static_cast<std::int_fast32_t>(Entity.Pos.X)][static_cast<std::int_fast32_t>(Entity.Pos.Y)] = Entity.Type;
+		switch (Type)
+		{
+			case EntityTypes::AmmoBox:
+			{
+				return EntityArchetypes::Pickup;
+			}
+			case EntityTypes::Turret:
+			{
+				return EntityArchetypes::Turret;
+			}
+			default:
+			{
+				return EntityArchetypes::Mobile;
+			}
+		}
 	}
 
 	inline void PlayAudio(const std::int_fast32_t TypeNumber, const EntitySounds EntitySound)
@@ -0,0 +1,67 @@
+/*
+******************************************
+*                                        *
+* Game_FPSDisplayClass.hpp               *
+*                                        *
+* (c) 2017 - 2020 Stefan Kubsch          *
+******************************************
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <array>
+#include <charconv>
+
+#include "Game_GlobalDefinitions.hpp"
+#include "GFX_HUDLayerClass.hpp"
+
+class Game_FPSDisplayClass final
+{
+public:
+	void Init();
+	void Display();
+
+private:
+	void Refresh();
+
+	// "fps:" and up to five digits in the 8x8 font
+	static constexpr std::int_fast32_t LayerWidth{ 72 };
+	static constexpr std::int_fast32_t LayerHeight{ 8 };
+
+	GFX_HUDLayerClass Layer{};
+	std::array<char, 10> FPSInfo{ 'f', 'p', 's', ':' };
+	// lwmf::FPS changes once per second
+	std::int_fast32_t DisplayedFPS{ -1 };
+	std::int_fast32_t Color{};
+};
+
+inline void Game_FPSDisplayClass::Init()
+{
+	NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Init fps display...");
+
+	Color = lwmf::RGBAtoINT(255, 255, 255, 255);
+	Layer.Init(Canvas.Width - LayerWidth - 7, 7, LayerWidth, LayerHeight, GFX_HUDLayerClass::Targets::Canvas);
+	DisplayedFPS = -1;
+}
+
+inline void Game_FPSDisplayClass::Display()
+{
+	if (lwmf::FPS != DisplayedFPS)
+	{
+		Refresh();
+	}
+
+	Layer.Display();
+}
+
+inline void Game_FPSDisplayClass::Refresh()
+{
+	const char* const FPSInfoEnd{ std::to_chars(FPSInfo.data() + 4, FPSInfo.data() + FPSInfo.size(), lwmf::FPS).ptr };
+
+	lwmf::RenderText(Layer.Begin(), { FPSInfo.data(), static_cast<std::size_t>(FPSInfoEnd - FPSInfo.data()) }, 0, 0, Color);
+	Layer.Commit();
+
+	DisplayedFPS = lwmf::FPS;
+}
@@ -18,4 +18,5 @@ inline const std::string AssetsEntitiesFolder{ "./DATA/Assets_Entities/" };
 inline const std::string AssetsDoorsFolder{ "./DATA/Assets_Doors/" };
 inline const std::string AssetsWeaponsFolder{ "./DATA/Assets_Weapons/" };
 
-inline const std::string GFXEntitiesFolder{ "./GFX/Entities/" };
\ No newline at end of file
+inline const std::string GFXEntitiesFolder{ "./GFX/Entities/" };
+inline const std::string GFXLevelTexturesFolder{ "./GFX/LevelTextures/" };
\ No newline at end of file
@@ -10,7 +10,7 @@
 #pragma once
 
 #include <cstdint>
-#include <random>
+#include <cstddef>
 
 // Setting planes/viewport for raycaster
 inline lwmf::FloatPointStruct Plane{};
@@ -32,11 +32,17 @@ inline std::int_fast32_t NumberOfLevels{};
 // Options for Renderer
 inline bool VSync{};
 inline bool Fullscreen{};
+// Benchmark runs without window, OpenGL and input - everything is rendered into the canvas only
+inline bool Headless{};
 
 // Size of textures (width and height)
 inline std::int_fast32_t TextureSize{};
 inline std::int_fast32_t EntitySize{};
 
+// Memory for decoded textures which are not in use right now (see "Game_TextureCache.hpp")
+// is set in "Game_Config.hpp"
+inline std::size_t TextureCacheBudget{};
+
 // Set factor for bitshifting from TextureSize
 // 7 for 128x128, 8 for 256x256, 9 for 512x512, 10 for 1024x1024
 // is calculated in "Game_Config.hpp" dependent on given TextureSize
@@ -49,6 +55,15 @@ inline bool GamePausedFlag{};
 inline bool GameControllerFlag{};
 inline bool QuitGameFlag{};
 
-// Random Number Generator
-// C++ 11 Mersenne-Twister-Engine
-inline std::mt19937 RNG(std::random_device{}());
\ No newline at end of file
+// Random numbers
+// One seed for the whole game (GameConfig.ini), every subsystem derives its own streams from it (see lwmf_random.hpp)
+enum class RandomSubsystems : std::uint64_t
+{
+	Entities,
+	Effects,
+	Weapons,
+	Benchmark,
+	BenchmarkPaths
+};
+
+inline std::uint64_t GameSeed{};
\ No newline at end of file
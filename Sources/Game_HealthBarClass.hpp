@@ -14,14 +14,18 @@
 
 #include "Tools_ErrorHandling.hpp"
 #include "Game_PlayerClass.hpp"
+#include "GFX_HUDLayerClass.hpp"
 
 class Game_HealthBarClass final
 {
 public:
 	void Init();
-	void Display() const;
+	void Display();
 
 private:
+	void Refresh();
+
+	GFX_HUDLayerClass Layer{};
 	lwmf::IntRectStruct RectRed{};
 	lwmf::IntRectStruct RectOrange{};
 	lwmf::IntRectStruct RectBlack1{};
@@ -30,6 +34,8 @@ private:
 	lwmf::IntPointStruct Pos{};
 	std::int_fast32_t HealthBarWidth{};
 	std::int_fast32_t HealthBarFactor{};
+	// Hitpoints the layer was last rendered with
+	std::int_fast32_t DisplayedHitpoints{ -1 };
 
 	std::int_fast32_t Green{};
 	std::int_fast32_t Red{};
@@ -57,14 +63,34 @@ inline void Game_HealthBarClass::Init()
 		RectOrange = { Pos.X - 3, Pos.Y - 3, HealthBarLength + 6, HealthBarWidth + 6 };
 		RectBlack1 = { Pos.X - 1, Pos.Y - 1, HealthBarLength + 2, HealthBarWidth + 2 };
 		RectBlack2 = { Pos.X - 4, Pos.Y - 4, HealthBarLength + 8, HealthBarWidth + 8 };
+
+		Layer.Init(RectBlack2.X, RectBlack2.Y, RectBlack2.Width, RectBlack2.Height, GFX_HUDLayerClass::Targets::Canvas);
+		DisplayedHitpoints = -1;
+	}
+}
+
+inline void Game_HealthBarClass::Display()
+{
+	if (Player.Hitpoints != DisplayedHitpoints)
+	{
+		Refresh();
 	}
+
+	Layer.Display();
 }
 
-inline void Game_HealthBarClass::Display() const
+inline void Game_HealthBarClass::Refresh()
 {
-	lwmf::Rectangle(Canvas, RectBlack2.X, RectBlack2.Y, RectBlack2.Width, RectBlack2.Height, Black);
-	lwmf::FilledRectangle(Canvas, RectOrange.X, RectOrange.Y, RectOrange.Width, RectOrange.Height, Orange, Orange);
-	lwmf::Rectangle(Canvas, RectBlack1.X, RectBlack1.Y, RectBlack1.Width, RectBlack1.Height, Black);
-	lwmf::FilledRectangle(Canvas, RectRed.X, RectRed.Y, RectRed.Width, RectRed.Height, Red, Red);
-	lwmf::FilledRectangle(Canvas, Pos.X, Pos.Y, Player.Hitpoints * HealthBarFactor, HealthBarWidth, Green, Green);
+	// Layer coords are relative to the outer frame
+	lwmf::TextureStruct& Texture{ Layer.Begin() };
+	const lwmf::IntPointStruct Origin{ RectBlack2.X, RectBlack2.Y };
+
+	lwmf::Rectangle(Texture, 0, 0, RectBlack2.Width, RectBlack2.Height, Black);
+	lwmf::FilledRectangle(Texture, RectOrange.X - Origin.X, RectOrange.Y - Origin.Y, RectOrange.Width, RectOrange.Height, Orange, Orange);
+	lwmf::Rectangle(Texture, RectBlack1.X - Origin.X, RectBlack1.Y - Origin.Y, RectBlack1.Width, RectBlack1.Height, Black);
+	lwmf::FilledRectangle(Texture, RectRed.X - Origin.X, RectRed.Y - Origin.Y, RectRed.Width, RectRed.Height, Red, Red);
+	lwmf::FilledRectangle(Texture, Pos.X - Origin.X, Pos.Y - Origin.Y, Player.Hitpoints * HealthBarFactor, HealthBarWidth, Green, Green);
+
+	Layer.Commit();
+	DisplayedHitpoints = Player.Hitpoints;
 }
\ No newline at end of file
@@ -0,0 +1,226 @@
+/*
+******************************************
+*                                        *
+* Game_Hitscan.hpp                       *
+*                                        *
+* (c) 2017 - 2020 Stefan Kubsch          *
+******************************************
+*/
+
+#pragma once
+
+#include <intrin.h>
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+#include "Game_GlobalDefinitions.hpp"
+#include "Game_DataStructures.hpp"
+#include "Game_LevelHandling.hpp"
+#include "Game_EntityHandling.hpp"
+
+namespace Game_Hitscan
+{
+
+
+	//
+	// Batched hitscan
+	//
+	// A ray starts at the player and runs through a point on the screen (camera x -1.0...1.0, screen row)
+	// Along such a ray the parameter equals the depth in view space, so a billboard at depth TransY is hit at exactly that parameter -
+	// no need to project the entities onto the screen per step like the old single ray did
+	//
+	// Per shot the visible entities are gathered once into padded columns, then every ray tests four entities per step (SSE)
+	// Geometric candidates in front of the nearest wall get the texel alpha test, the nearest opaque one is the hit of the ray
+	//
+
+	struct RayStruct final
+	{
+		float CameraX{};
+		float ScreenY{};
+	};
+
+	struct HitStruct final
+	{
+		std::int_fast32_t EntityNumber{ -1 };
+		float Depth{};
+	};
+
+	void SpreadRays(std::int_fast32_t Pellets, float Spread, std::vector<RayStruct>& Rays);
+	void CastRays(const std::vector<RayStruct>& Rays, std::vector<HitStruct>& Hits);
+	void GatherTargets();
+	float GetWallDepth(float CameraX);
+	bool IsOpaque(std::int_fast32_t Target, float Column, float ScreenY);
+
+	//
+	// Variables and constants
+	//
+
+	inline constexpr std::int_fast32_t Lanes{ 4 };
+
+	// Spread samples are taken from the weapon stream, one counter per number
+	inline std::uint64_t SpreadCounter{};
+	inline std::vector<float> SpreadSamples{};
+
+	// Targets of the current shot - depth, lateral position (camera x * depth), vertical offset and frame
+	// Columns are padded to a multiple of Lanes with a negative depth, which never passes the depth test
+	inline std::vector<float> TargetDepth{};
+	inline std::vector<float> TargetX{};
+	inline std::vector<float> TargetMoveV{};
+	inline std::vector<const std::int_fast32_t*> TargetFrame{};
+	inline std::vector<std::int_fast32_t> TargetNumber{};
+
+	//
+	// Functions
+	//
+
+	inline void SpreadRays(const std::int_fast32_t Pellets, const float Spread, std::vector<RayStruct>& Rays)
+	{
+		// Spread is the half angle of the cone in degrees - pellets are distributed uniformly over its cross section
+		const float PlaneLength{ std::sqrt(Plane.X * Plane.X + Plane.Y * Plane.Y) };
+		const float SpreadTan{ std::tan(Spread * lwmf::PI / 180.0F) };
+
+		Rays.resize(static_cast<std::size_t>(Pellets));
+		SpreadSamples.resize(static_cast<std::size_t>(Pellets) << 1);
+		lwmf::CounterRandomFloatBatch(GameSeed, static_cast<std::uint64_t>(RandomSubsystems::Weapons), SpreadCounter, SpreadSamples.data(), SpreadSamples.size());
+		SpreadCounter += SpreadSamples.size();
+
+		for (std::int_fast32_t Index{}; Index < Pellets; ++Index)
+		{
+			// Without spread every pellet goes exactly through the crosshair
+			const float Radius{ SpreadTan * std::sqrt(SpreadSamples[static_cast<std::size_t>(Index) << 1]) };
+			const float Angle{ lwmf::DoublePI * SpreadSamples[(static_cast<std::size_t>(Index) << 1) + 1] };
+
+			// Horizontal tangent -> camera x, vertical tangent -> screen rows
+			Rays[Index].CameraX = Radius * std::cos(Angle) / PlaneLength;
+			Rays[Index].ScreenY = static_cast<float>(Canvas.HeightMid) + Radius * std::sin(Angle) * static_cast<float>(Canvas.Height);
+		}
+	}
+
+	inline void CastRays(const std::vector<RayStruct>& Rays, std::vector<HitStruct>& Hits)
+	{
+		GatherTargets();
+
+		Hits.assign(Rays.size(), {});
+
+		// Sprites are as wide as high on screen - lateral offset (camera x * depth) -> texture column
+		const float WidthFactor{ static_cast<float>(Canvas.WidthMid) / static_cast<float>(Canvas.Height) };
+		const std::int_fast32_t NumberOfTargets{ static_cast<std::int_fast32_t>(TargetDepth.size()) };
+		const __m128 Zero{ _mm_setzero_ps() };
+		const __m128 One{ _mm_set1_ps(1.0F) };
+		const __m128 Half{ _mm_set1_ps(0.5F) };
+		const __m128 Width{ _mm_set1_ps(WidthFactor) };
+
+		for (std::size_t RayIndex{}; RayIndex < Rays.size(); ++RayIndex)
+		{
+			const RayStruct& Ray{ Rays[RayIndex] };
+			HitStruct& Hit{ Hits[RayIndex] };
+			float NearestDepth{ GetWallDepth(Ray.CameraX) };
+			const __m128 CameraX{ _mm_set1_ps(Ray.CameraX) };
+
+			for (std::int_fast32_t Target{}; Target < NumberOfTargets; Target += Lanes)
+			{
+				const __m128 Depth{ _mm_loadu_ps(TargetDepth.data() + Target) };
+				// Texture column 0.0...1.0 where the ray crosses the billboard
+				const __m128 Column{ _mm_add_ps(_mm_mul_ps(_mm_sub_ps(_mm_mul_ps(CameraX, Depth), _mm_loadu_ps(TargetX.data() + Target)), Width), Half) };
+				const __m128 Inside{ _mm_and_ps(_mm_and_ps(_mm_cmpgt_ps(Depth, Zero), _mm_cmplt_ps(Depth, _mm_set1_ps(NearestDepth))), _mm_and_ps(_mm_cmpge_ps(Column, Zero), _mm_cmplt_ps(Column, One))) };
+
+				for (std::uint32_t Mask{ static_cast<std::uint32_t>(_mm_movemask_ps(Inside)) }; Mask != 0; Mask &= Mask - 1)
+				{
+					const std::int_fast32_t Candidate{ Target + std::countr_zero(Mask) };
+
+					// Lanes are not sorted by depth - an earlier lane of this block may already be closer
+					if (TargetDepth[Candidate] < NearestDepth && IsOpaque(Candidate, (Ray.CameraX * TargetDepth[Candidate] - TargetX[Candidate]) * WidthFactor + 0.5F, Ray.ScreenY))
+					{
+						NearestDepth = TargetDepth[Candidate];
+						Hit = { TargetNumber[Candidate], NearestDepth };
+					}
+				}
+			}
+		}
+	}
+
+	inline void GatherTargets()
+	{
+		const float InverseMatrix{ 1.0F / (Plane.X * Player.Dir.Y - Player.Dir.X * Plane.Y) };
+		const std::int_fast32_t NumberOfEntities{ static_cast<std::int_fast32_t>(Game_EntityHandling::EntityOrder.size()) };
+
+		TargetDepth.clear();
+		TargetX.clear();
+		TargetMoveV.clear();
+		TargetFrame.clear();
+		TargetNumber.clear();
+
+		for (std::int_fast32_t Index{}; Index < NumberOfEntities; ++Index)
+		{
+			const std::int_fast32_t Number{ Game_EntityHandling::EntityOrder[Index].first };
+			const EntityStateComponent& State{ Entities.State[Number] };
+
+			if (State.IsDead)
+			{
+				continue;
+			}
+
+			const EntityTransformComponent& Transform{ Entities.Transform[Number] };
+			const EntityAssetStruct& Asset{ EntityAssets[State.TypeNumber] };
+			const lwmf::FloatPointStruct EntityPos{ Transform.Pos.X - Player.Pos.X, Transform.Pos.Y - Player.Pos.Y };
+
+			TargetDepth.emplace_back(InverseMatrix * (-Plane.Y * EntityPos.X + Plane.X * EntityPos.Y));
+			TargetX.emplace_back(InverseMatrix * (Player.Dir.Y * EntityPos.X - Player.Dir.X * EntityPos.Y));
+			TargetMoveV.emplace_back(Transform.MoveV);
+			TargetFrame.emplace_back(Game_EntityHandling::GetAnimFrame(Entities.Animation[Number], Asset, Game_EntityHandling::GetAnimState(State, Asset), Game_EntityHandling::GetEntityTextureIndex(Index)));
+			TargetNumber.emplace_back(Number);
+		}
+
+		const std::size_t PaddedSize{ (TargetDepth.size() + Lanes - 1) & ~static_cast<std::size_t>(Lanes - 1) };
+		TargetDepth.resize(PaddedSize, -1.0F);
+		TargetX.resize(PaddedSize);
+	}
+
+	inline float GetWallDepth(const float CameraX)
+	{
+		// DDA like in the raycaster - returns the perpendicular distance, which is the depth along the ray
+		const lwmf::FloatPointStruct RayDir{ Player.Dir.X + Plane.X * CameraX, Player.Dir.Y + Plane.Y * CameraX };
+		lwmf::IntPointStruct MapPos{ static_cast<std::int_fast32_t>(Player.Pos.X), static_cast<std::int_fast32_t>(Player.Pos.Y) };
+		const lwmf::FloatPointStruct DeltaDist{ std::fabs(1.0F / RayDir.X), std::fabs(1.0F / RayDir.Y) };
+		lwmf::FloatPointStruct SideDist{};
+		lwmf::IntPointStruct Step{};
+
+		RayDir.X < 0.0F ? (Step.X = -1, SideDist.X = (Player.Pos.X - static_cast<float>(MapPos.X)) * DeltaDist.X) : (Step.X = 1, SideDist.X = (static_cast<float>(MapPos.X) + 1.0F - Player.Pos.X) * DeltaDist.X);
+		RayDir.Y < 0.0F ? (Step.Y = -1, SideDist.Y = (Player.Pos.Y - static_cast<float>(MapPos.Y)) * DeltaDist.Y) : (Step.Y = 1, SideDist.Y = (static_cast<float>(MapPos.Y) + 1.0F - Player.Pos.Y) * DeltaDist.Y);
+
+		while (true)
+		{
+			float Depth{};
+
+			SideDist.X < SideDist.Y ? (Depth = SideDist.X, SideDist.X += DeltaDist.X, MapPos.X += Step.X) : (Depth = SideDist.Y, SideDist.Y += DeltaDist.Y, MapPos.Y += Step.Y);
+
+			if (static_cast<std::uint_fast32_t>(MapPos.X) >= static_cast<std::uint_fast32_t>(Game_LevelHandling::LevelMapWidth) || static_cast<std::uint_fast32_t>(MapPos.Y) >= static_cast<std::uint_fast32_t>(Game_LevelHandling::LevelMapHeight)
+				|| Game_LevelHandling::LevelMap[static_cast<std::int_fast32_t>(Game_LevelHandling::LevelMapLayers::Wall)][MapPos.X][MapPos.Y] > 0)
+			{
+				return Depth;
+			}
+		}
+	}
+
+	inline bool IsOpaque(const std::int_fast32_t Target, const float Column, const float ScreenY)
+	{
+		// Same mapping as RenderEntity(), in floating point
+		const float Depth{ TargetDepth[Target] };
+		const float Row{ ((ScreenY - TargetMoveV[Target] / Depth - static_cast<float>(Canvas.Height + VerticalLook) * 0.5F) * Depth / static_cast<float>(Canvas.Height) + 0.5F) };
+
+		if (Row < 0.0F || Row >= 1.0F)
+		{
+			return false;
+		}
+
+		const std::int_fast32_t TextureX{ std::min(static_cast<std::int_fast32_t>(Column * static_cast<float>(EntitySize)), EntitySize - 1) };
+		const std::int_fast32_t TextureY{ std::min(static_cast<std::int_fast32_t>(Row * static_cast<float>(EntitySize)), EntitySize - 1) };
+
+		return (TargetFrame[Target][TextureY * EntitySize + TextureX] & lwmf::AMask) != 0;
+	}
+
+
+} // namespace Game_Hitscan
@@ -12,13 +12,17 @@
 #include <cstdint>
 #include <string>
 #include <vector>
-#include <fstream>
 #include <sstream>
+#include <span>
 
 #include "Game_GlobalDefinitions.hpp"
 #include "Tools_ErrorHandling.hpp"
+#include "Tools_VFS.hpp"
 #include "GFX_ImageHandling.hpp"
 #include "GFX_LightingClass.hpp"
+#include "Game_BakedLevel.hpp"
+#include "Game_AssetLoader.hpp"
+#include "Game_TextureCache.hpp"
 
 namespace Game_LevelHandling
 {
@@ -35,8 +39,11 @@ namespace Game_LevelHandling
 
 	void InitConfig();
 	void ReadMapDataFile(const std::string& FileName, std::vector<std::vector<std::vector<std::int_fast32_t>>>& LevelMapVector, LevelMapLayers LevelMapLayer);
+	void ReadBakedMapLayer(std::vector<std::vector<std::vector<std::int_fast32_t>>>& LevelMapVector, LevelMapLayers LevelMapLayer);
 	void InitMapData();
+	void ReadLightsDataFile(const std::string& FileName, std::vector<Game_BakedLevel::LightRecordStruct>& Lights);
 	void InitLights();
+	std::vector<std::string> ReadTexturesDataFile(const std::string& FileName);
 	void InitTextures();
 	void InitBackgroundMusic();
 	void PlayBackgroundMusic(std::int_fast32_t Tracknumber);
@@ -49,15 +56,18 @@ namespace Game_LevelHandling
 	//
 
 	inline std::vector<std::vector<std::vector<std::int_fast32_t>>> LevelMap{};
-	inline std::vector<lwmf::TextureStruct> LevelTextures{};
+	inline std::vector<Game_TextureCache::TextureHandle> LevelTextures{};
 
 	inline std::vector<GFX_LightingClass> StaticLights{};
 	inline std::vector<lwmf::MP3Player> BackgroundMusic;
 
-	// Variables used for map dimensions (used for Level*Map and EntityMap)
+	// Variables used for map dimensions (used for Level*Map and the entity spatial index)
 	inline std::int_fast32_t LevelMapWidth{};
 	inline std::int_fast32_t LevelMapHeight{};
 
+	// Counts runtime changes of the wall layer (doors) - caches built from the map compare it with the revision they were built for
+	inline std::uint_fast32_t MapRevision{};
+
 	inline bool LightingFlag{};
 	inline bool BackgroundMusicEnabled{};
 
@@ -83,7 +93,7 @@ namespace Game_LevelHandling
 	{
 		if (Tools_ErrorHandling::CheckFileExistence(FileName, StopOnError))
 		{
-			std::ifstream LevelMapDataFile(FileName, std::ios::in);
+			std::istringstream LevelMapDataFile(Tools_VFS::ReadText(FileName));
 
 			std::vector<std::int_fast32_t> TempVectorCeiling{};
 			std::string Line;
@@ -113,10 +123,27 @@ namespace Game_LevelHandling
 		}
 	}
 
+	inline void ReadBakedMapLayer(std::vector<std::vector<std::vector<std::int_fast32_t>>>& LevelMapVector, const LevelMapLayers LevelMapLayer)
+	{
+		// Layers are baked in the order of LevelMapLayers, rows exactly like ReadMapDataFile() builds them (incl. the doubled last ceiling line)
+		const Game_BakedLevel::Sections Section{ static_cast<Game_BakedLevel::Sections>(static_cast<std::uint32_t>(Game_BakedLevel::Sections::FloorLayer) + static_cast<std::uint32_t>(LevelMapLayer)) };
+		const std::span<const std::int32_t> Cells{ Game_BakedLevel::GetSection<std::int32_t>(Section) };
+		// Game_BakedLevel::CheckSections() made sure there is at least one row and all rows have the same length
+		const std::size_t Rows{ Game_BakedLevel::GetSectionInfo(Section).Count };
+		const std::size_t Columns{ Cells.size() / Rows };
+
+		for (std::size_t Row{}; Row < Rows; ++Row)
+		{
+			LevelMapVector[static_cast<std::int_fast32_t>(LevelMapLayer)].emplace_back(Cells.begin() + static_cast<std::ptrdiff_t>(Row * Columns), Cells.begin() + static_cast<std::ptrdiff_t>((Row + 1) * Columns));
+		}
+	}
+
 	inline void InitMapData()
 	{
 		NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Init map data...");
 
+		++MapRevision;
+
 		LevelMap.clear();
 		LevelMap.shrink_to_fit();
 		LevelMap.resize(static_cast<std::int_fast32_t>(LevelMapLayers::Counter));
@@ -125,16 +152,37 @@ namespace Game_LevelHandling
 		LevelPath += std::to_string(SelectedLevel);
 		LevelPath += "/LevelData/";
 
-		ReadMapDataFile(LevelPath + "MapFloorData.conf", LevelMap, LevelMapLayers::Floor);
-		ReadMapDataFile(LevelPath + "MapWallData.conf", LevelMap, LevelMapLayers::Wall);
-		ReadMapDataFile(LevelPath + "MapCeilingData.conf", LevelMap, LevelMapLayers::Ceiling);
-		ReadMapDataFile(LevelPath + "MapDoorData.conf", LevelMap, LevelMapLayers::Door);
+		if (Game_BakedLevel::IsOpen())
+		{
+			ReadBakedMapLayer(LevelMap, LevelMapLayers::Floor);
+			ReadBakedMapLayer(LevelMap, LevelMapLayers::Wall);
+			ReadBakedMapLayer(LevelMap, LevelMapLayers::Ceiling);
+			ReadBakedMapLayer(LevelMap, LevelMapLayers::Door);
+		}
+		else
+		{
+			ReadMapDataFile(LevelPath + "MapFloorData.conf", LevelMap, LevelMapLayers::Floor);
+			ReadMapDataFile(LevelPath + "MapWallData.conf", LevelMap, LevelMapLayers::Wall);
+			ReadMapDataFile(LevelPath + "MapCeilingData.conf", LevelMap, LevelMapLayers::Ceiling);
+			ReadMapDataFile(LevelPath + "MapDoorData.conf", LevelMap, LevelMapLayers::Door);
+		}
 
 		LevelMapWidth = static_cast<std::int_fast32_t>(LevelMap[static_cast<std::int_fast32_t>(LevelMapLayers::Wall)].size());
 		LevelMapHeight = static_cast<std::int_fast32_t>(LevelMap[static_cast<std::int_fast32_t>(LevelMapLayers::Wall)][0].size());
 	}
 
 
+	inline void ReadLightsDataFile(const std::string& FileName, std::vector<Game_BakedLevel::LightRecordStruct>& Lights)
+	{
+		std::istringstream StaticLightsDataFile(Tools_VFS::ReadText(FileName));
+		Game_BakedLevel::LightRecordStruct Light{};
+
+		while (StaticLightsDataFile >> Light.PosX >> Light.PosY >> Light.Location >> Light.Radius >> Light.Intensity)
+		{
+			Lights.emplace_back(Light);
+		}
+	}
+
 	inline void InitLights()
 	{
 		NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Init lights...");
@@ -144,47 +192,83 @@ namespace Game_LevelHandling
 
 		if (LightingFlag)
 		{
-			std::string FileName{ LevelFolder };
-			FileName += std::to_string(SelectedLevel);
-			FileName += "/LevelData/StaticLightsData.conf";
+			std::vector<Game_BakedLevel::LightRecordStruct> Lights{};
 
-			if (Tools_ErrorHandling::CheckFileExistence(FileName, StopOnError))
+			if (Game_BakedLevel::IsOpen())
 			{
-				std::ifstream StaticLightsDataFile(FileName, std::ios::in);
-
-				std::int_fast32_t Location{};
-				lwmf::FloatPointStruct Pos{};
-				float Radius{};
-				float Intensity{};
+				const std::span<const Game_BakedLevel::LightRecordStruct> BakedLights{ Game_BakedLevel::GetSection<Game_BakedLevel::LightRecordStruct>(Game_BakedLevel::Sections::Lights) };
+				Lights.assign(BakedLights.begin(), BakedLights.end());
+			}
+			else
+			{
+				std::string FileName{ LevelFolder };
+				FileName += std::to_string(SelectedLevel);
+				FileName += "/LevelData/StaticLightsData.conf";
 
-				while (StaticLightsDataFile >> Pos.X >> Pos.Y >> Location >> Radius >> Intensity)
+				if (Tools_ErrorHandling::CheckFileExistence(FileName, StopOnError))
 				{
-					StaticLights.emplace_back(Pos.X, Pos.Y, Location, Radius, Intensity);
+					ReadLightsDataFile(FileName, Lights);
 				}
 			}
+
+			for (const auto& Light : Lights)
+			{
+				StaticLights.emplace_back(Light.PosX, Light.PosY, Light.Location, Light.Radius, Light.Intensity);
+			}
+		}
+	}
+
+	inline std::vector<std::string> ReadTexturesDataFile(const std::string& FileName)
+	{
+		std::vector<std::string> TextureFiles{};
+		std::istringstream LevelTexturesDataFile(Tools_VFS::ReadText(FileName));
+		std::string Line;
+
+		while (std::getline(LevelTexturesDataFile, Line))
+		{
+			TextureFiles.emplace_back(GFXLevelTexturesFolder + std::to_string(TextureSize) + "/" + Line);
 		}
+
+		return TextureFiles;
 	}
 
 	inline void InitTextures()
 	{
+		// Queued only - the textures are ready after the next Game_AssetLoader::Run()
 		NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Load level textures...");
 
 		LevelTextures.clear();
 		LevelTextures.shrink_to_fit();
 
+		if (Game_BakedLevel::IsOpen())
+		{
+			// Already decoded and checked for the right size by the baker - Game_BakedLevel::CheckSections() made sure all of them are there
+			const std::span<const std::int32_t> Pixels{ Game_BakedLevel::GetSection<std::int32_t>(Game_BakedLevel::Sections::Textures) };
+			const std::size_t NumberOfTextures{ Game_BakedLevel::GetSectionInfo(Game_BakedLevel::Sections::Textures).Count };
+			const std::size_t PixelsPerTexture{ static_cast<std::size_t>(TextureSize) * static_cast<std::size_t>(TextureSize) };
+
+			LevelTextures.resize(NumberOfTextures);
+
+			for (std::size_t Index{}; Index < NumberOfTextures; ++Index)
+			{
+				Game_AssetLoader::AddJob("Baked level texture " + std::to_string(Index), [Index, Pixels, PixelsPerTexture] { LevelTextures[Index] = Game_TextureCache::AcquirePixels(Pixels.subspan(Index * PixelsPerTexture, PixelsPerTexture), TextureSize); });
+			}
+
+			return;
+		}
+
 		std::string FileName{ LevelFolder };
 		FileName += std::to_string(SelectedLevel);
 		FileName += "/LevelData/TexturesData.conf";
 
 		if (Tools_ErrorHandling::CheckFileExistence(FileName, StopOnError))
 		{
-			std::ifstream LevelTexturesDataFile(FileName, std::ios::in);
-
-			std::string Line;
+			const std::vector<std::string> TextureFiles{ ReadTexturesDataFile(FileName) };
+			LevelTextures.resize(TextureFiles.size());
 
-			while (std::getline(LevelTexturesDataFile, Line))
+			for (std::size_t Index{}; Index < TextureFiles.size(); ++Index)
 			{
-				LevelTextures.emplace_back(GFX_ImageHandling::ImportTexture("./GFX/LevelTextures/" + std::to_string(TextureSize) + "/" + Line, TextureSize));
+				Game_AssetLoader::AddTextureJob(TextureFiles[Index], LevelTextures[Index], TextureSize);
 			}
 		}
 	}
@@ -12,11 +12,11 @@
 #include <cstdint>
 #include <string>
 #include <vector>
-#include <fstream>
 #include <sstream>
 
 #include "Game_GlobalDefinitions.hpp"
 #include "Tools_ErrorHandling.hpp"
+#include "Tools_VFS.hpp"
 #include "GFX_TextClass.hpp"
 
 class Game_MenuClass final
@@ -65,7 +65,7 @@ inline void Game_MenuClass::Init()
 
 	if (const std::string MenuDefinitionFileName{ GameConfigFolder + "MenuDefinition.txt" }; Tools_ErrorHandling::CheckFileExistence(MenuDefinitionFileName, StopOnError))
 	{
-		std::ifstream MenuDefinitionFile(MenuDefinitionFileName, std::ios::in);
+		std::istringstream MenuDefinitionFile(Tools_VFS::ReadText(MenuDefinitionFileName));
 
 		std::string Line;
 
@@ -10,18 +10,23 @@
 #pragma once
 
 #include <cstdint>
+#include <cstddef>
 #include <string>
+#include <algorithm>
 
 #include "Tools_ErrorHandling.hpp"
 #include "Game_DataStructures.hpp"
 #include "Game_LevelHandling.hpp"
 #include "Game_EntityHandling.hpp"
+#include "Game_SpatialIndex.hpp"
+#include "Game_Visibility.hpp"
 
 class Game_MinimapClass final
 {
 public:
 	void Init();
 	void PreRender();
+	void RefreshFogOfWar();
 	void DisplayRealtimeMap() const;
 	static void DisplayPreRenderedMap();
 
@@ -29,9 +34,12 @@ public:
 
 private:
 	void Clear() const;
+	void RenderTexture();
+	void DrawTile(std::int_fast32_t MapPosX, std::int_fast32_t MapPosY);
 
 	static inline lwmf::ShaderClass MiniMapShader{};
 
+	lwmf::TextureStruct MiniMapTexture{};
 	lwmf::IntPointStruct Pos{};
 	std::int_fast32_t TileSize{ 6 };
 	std::int_fast32_t StartPosY{};
@@ -44,6 +52,7 @@ private:
 	std::int_fast32_t WayPointColor{};
 	std::int_fast32_t WaypointOffset{};
 	bool ShowWaypoints{};
+	bool FogOfWar{};
 	bool IsPreRendered{};
 };
 
@@ -55,6 +64,7 @@ inline void Game_MinimapClass::Init()
 	{
 		Pos = { lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "GENERAL", "PosX"), lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "GENERAL", "PosY") };
 		ShowWaypoints = lwmf::ReadINIValue<bool>(INIFile, "GENERAL", "ShowWaypoints");
+		FogOfWar = lwmf::ReadINIValue<bool>(INIFile, "GENERAL", "FogOfWar");
 		PlayerColor = lwmf::ReadINIValueRGBA(INIFile, "PLAYER");
 		EnemyColor = lwmf::ReadINIValueRGBA(INIFile, "ENEMY");
 		NeutralColor = lwmf::ReadINIValueRGBA(INIFile, "NEUTRAL");
@@ -63,7 +73,10 @@ inline void Game_MinimapClass::Init()
 		DoorColor = lwmf::ReadINIValueRGBA(INIFile, "DOORS");
 		WayPointColor = lwmf::ReadINIValueRGBA(INIFile, "WAYPOINT");
 
-		MiniMapShader.LoadShader("Default", Canvas);
+		if (!Headless)
+		{
+			MiniMapShader.LoadShader("Default", Canvas);
+		}
 	}
 }
 
@@ -92,72 +105,130 @@ inline void Game_MinimapClass::PreRender()
 
 	WaypointOffset = TileSize >> 1;
 
-	// PreRender MiniMap
-	lwmf::TextureStruct MiniMapTexture;
+	// Set map position
+	StartPosY = Canvas.Height - Game_LevelHandling::LevelMapWidth * TileSize - Pos.Y;
+
+	// Headless runs draw the realtime map only
+	if (Headless)
+	{
+		return;
+	}
+
+	NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Load minimap texture into GPU RAM...");
+	RenderTexture();
+}
+
+inline void Game_MinimapClass::RefreshFogOfWar()
+{
+	// Draw the cells explored since the last frame and upload only the texture rows they cover
+	if (!FogOfWar || Game_Visibility::NewlyExplored.empty())
+	{
+		return;
+	}
+
+	std::int_fast32_t FirstRow{ MiniMapTexture.Height };
+	std::int_fast32_t LastRow{ -1 };
+
+	for (const std::int_fast32_t Index : Game_Visibility::NewlyExplored)
+	{
+		const std::int_fast32_t MapPosX{ Index % Game_LevelHandling::LevelMapWidth };
+		const std::int_fast32_t MapPosY{ Index / Game_LevelHandling::LevelMapWidth };
+
+		DrawTile(MapPosX, MapPosY);
+		FirstRow = std::min(FirstRow, MapPosX * TileSize);
+		LastRow = std::max(LastRow, MapPosX * TileSize + TileSize - 1);
+	}
+
+	Game_Visibility::NewlyExplored.clear();
+
+	glTextureSubImage2D(MiniMapShader.OGLTextureID, 0, 0, FirstRow, MiniMapTexture.Width, LastRow - FirstRow + 1, GL_RGBA, GL_UNSIGNED_BYTE, MiniMapTexture.Pixels.data() + static_cast<std::size_t>(FirstRow) * static_cast<std::size_t>(MiniMapTexture.Width));
+}
+
+inline void Game_MinimapClass::RenderTexture()
+{
 	lwmf::CreateTexture(MiniMapTexture, Game_LevelHandling::LevelMapHeight * TileSize, Game_LevelHandling::LevelMapWidth * TileSize, 0x000000FF);
 
-	for (std::int_fast32_t x{}, MapPosY{}; MapPosY < Game_LevelHandling::LevelMapHeight; ++MapPosY, x += TileSize)
+	for (std::int_fast32_t MapPosY{}; MapPosY < Game_LevelHandling::LevelMapHeight; ++MapPosY)
 	{
-		for (std::int_fast32_t y{}, MapPosX{}; MapPosX < Game_LevelHandling::LevelMapWidth; ++MapPosX, y += TileSize)
+		for (std::int_fast32_t MapPosX{}; MapPosX < Game_LevelHandling::LevelMapWidth; ++MapPosX)
 		{
-			if (Game_LevelHandling::LevelMap[static_cast<std::int_fast32_t>(Game_LevelHandling::LevelMapLayers::Wall)][MapPosX][MapPosY] != 0)
+			if (!FogOfWar || Game_Visibility::IsExplored(MapPosX, MapPosY))
 			{
-				lwmf::FilledRectangle(MiniMapTexture, x, y, TileSize, TileSize, WallColor, WallColor);
-			}
-
-			if (Game_LevelHandling::LevelMap[static_cast<std::int_fast32_t>(Game_LevelHandling::LevelMapLayers::Door)][MapPosX][MapPosY] != 0)
-			{
-				lwmf::FilledRectangle(MiniMapTexture, x, y, TileSize, TileSize, DoorColor, DoorColor);
+				DrawTile(MapPosX, MapPosY);
 			}
 		}
 	}
 
-	// Set map position
-	StartPosY = Canvas.Height - Game_LevelHandling::LevelMapWidth * TileSize - Pos.Y;
+	// Everything explored so far is in the texture now
+	Game_Visibility::NewlyExplored.clear();
 
-	NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Load minimap texture into GPU RAM...");
 	MiniMapShader.LoadStaticTextureInGPU(MiniMapTexture, &MiniMapShader.OGLTextureID, Pos.X, StartPosY, MiniMapTexture.Width, MiniMapTexture.Height);
 	IsPreRendered = true;
 }
 
+inline void Game_MinimapClass::DrawTile(const std::int_fast32_t MapPosX, const std::int_fast32_t MapPosY)
+{
+	// The map is drawn transposed - map x runs down the texture
+	const std::int_fast32_t x{ MapPosY * TileSize };
+	const std::int_fast32_t y{ MapPosX * TileSize };
+
+	if (Game_LevelHandling::LevelMap[static_cast<std::int_fast32_t>(Game_LevelHandling::LevelMapLayers::Wall)][MapPosX][MapPosY] != 0)
+	{
+		lwmf::FilledRectangle(MiniMapTexture, x, y, TileSize, TileSize, WallColor, WallColor);
+	}
+
+	if (Game_LevelHandling::LevelMap[static_cast<std::int_fast32_t>(Game_LevelHandling::LevelMapLayers::Door)][MapPosX][MapPosY] != 0)
+	{
+		lwmf::FilledRectangle(MiniMapTexture, x, y, TileSize, TileSize, DoorColor, DoorColor);
+	}
+}
+
 inline void Game_MinimapClass::DisplayRealtimeMap() const
 {
 	for (std::int_fast32_t x{ Pos.X }, MapPosY{}; MapPosY < Game_LevelHandling::LevelMapHeight; ++MapPosY, x += TileSize)
 	{
 		for (std::int_fast32_t y{ StartPosY }, MapPosX{}; MapPosX < Game_LevelHandling::LevelMapWidth; ++MapPosX, y += TileSize)
 		{
-			switch (Game_EntityHandling::EntityMap[MapPosX][MapPosY])
+			// Entities are only shown if the player can see them
+			if (FogOfWar && !Game_Visibility::IsVisible(MapPosX, MapPosY))
 			{
-				case EntityTypes::Player:
-				{
-					lwmf::FilledRectangle(Canvas, x, y, TileSize, TileSize, PlayerColor, PlayerColor);
-					break;
-				}
-				case EntityTypes::Enemy: case EntityTypes::Turret:
-				{
-					lwmf::FilledRectangle(Canvas, x, y, TileSize, TileSize, EnemyColor, EnemyColor);
-					break;
-				}
-				case EntityTypes::Neutral:
-				{
-					lwmf::FilledRectangle(Canvas, x, y, TileSize, TileSize, NeutralColor, NeutralColor);
-					break;
-				}
-				case EntityTypes::AmmoBox:
+				continue;
+			}
+
+			if (Game_SpatialIndex::IsPlayerCell(MapPosX, MapPosY))
+			{
+				lwmf::FilledRectangle(Canvas, x, y, TileSize, TileSize, PlayerColor, PlayerColor);
+			}
+			else if (const std::int_fast32_t EntityNumber{ Game_SpatialIndex::FirstInCell(MapPosX, MapPosY) }; EntityNumber != -1)
+			{
+				switch (Entities.State[EntityNumber].Type)
 				{
-					lwmf::FilledRectangle(Canvas, x, y, TileSize, TileSize, AmmoBoxColor, AmmoBoxColor);
-					break;
+					case EntityTypes::Enemy: case EntityTypes::Turret:
+					{
+						lwmf::FilledRectangle(Canvas, x, y, TileSize, TileSize, EnemyColor, EnemyColor);
+						break;
+					}
+					case EntityTypes::Neutral:
+					{
+						lwmf::FilledRectangle(Canvas, x, y, TileSize, TileSize, NeutralColor, NeutralColor);
+						break;
+					}
+					case EntityTypes::AmmoBox:
+					{
+						lwmf::FilledRectangle(Canvas, x, y, TileSize, TileSize, AmmoBoxColor, AmmoBoxColor);
+						break;
+					}
+					default: {}
 				}
-				default: {}
 			}
 
 			if (ShowWaypoints)
 			{
-				for (auto& Entity : Entities)
+				for (const std::int_fast32_t Number : Entities.Archetypes[static_cast<std::int_fast32_t>(EntityArchetypes::Mobile)])
 				{
-					if (!Entity.IsDead && (Entity.Type == EntityTypes::Neutral || Entity.Type == EntityTypes::Enemy))
+					if (!Entities.State[Number].IsDead && (Entities.State[Number].Type == EntityTypes::Neutral || Entities.State[Number].Type == EntityTypes::Enemy))
 					{
-						for (auto& WayPoint : Entity.PathFindingWayPoints)
+						for (const auto& WayPoint : Entities.Path[Number].PathFindingWayPoints)
 						{
 							if (WayPoint.X == MapPosX && WayPoint.Y == MapPosY)
 							{
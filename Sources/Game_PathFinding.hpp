@@ -14,6 +14,9 @@
 #include <array>
 #include <list>
 #include <queue>
+#include <algorithm>
+#include <string>
+#include <thread>
 
 #include "Game_GlobalDefinitions.hpp"
 #include "Game_LevelHandling.hpp"
@@ -22,8 +25,31 @@ namespace Game_PathFinding
 {
 
 
+	// Grid = plain A* on the given map
+	// Accelerated = next-hop tables or hierarchy if available - these are built from FlattenedMap, so only use it for searches on FlattenedMap
+	enum class PathModes : std::int_fast32_t
+	{
+		Grid,
+		Accelerated
+	};
+
 	void GenerateFlattenedMap(std::vector<float>& Map, std::int_fast32_t Width, std::int_fast32_t Height);
-	bool CalculatePath(std::vector<float>& Map, std::int_fast32_t Width, std::int_fast32_t Height, std::int_fast32_t Start, std::int_fast32_t Target, bool Diagonal, std::list<lwmf::IntPointStruct>& WayPoints);
+	bool CalculatePath(const std::vector<float>& Map, std::int_fast32_t Width, std::int_fast32_t Height, std::int_fast32_t Start, std::int_fast32_t Target, bool Diagonal, PathModes Mode, std::list<lwmf::IntPointStruct>& WayPoints);
+	bool CalculateGridPath(const std::vector<float>& Map, std::int_fast32_t Width, std::int_fast32_t Height, std::int_fast32_t Start, std::int_fast32_t Target, bool Diagonal, std::list<lwmf::IntPointStruct>& WayPoints);
+	void BuildHierarchy(const std::vector<float>& Map, std::int_fast32_t Width, std::int_fast32_t Height);
+	void UpdateHierarchy(const std::vector<float>& Map, std::int_fast32_t Index);
+	void BuildClusterNodes(const std::vector<float>& Map, std::int_fast32_t ClusterIndex);
+	void ScanClusterBorder(const std::vector<float>& Map, std::int_fast32_t ClusterIndex, std::int_fast32_t StepX, std::int_fast32_t StepY);
+	void BuildClusterDistances(const std::vector<float>& Map, std::int_fast32_t ClusterIndex);
+	void NumberAbstractNodes();
+	std::int_fast32_t GetClusterIndex(std::int_fast32_t Index);
+	bool ExploreRect(const std::vector<float>& Map, const lwmf::IntRectStruct& Rect, std::int_fast32_t Start, std::int_fast32_t Target, std::vector<float>& Costs, std::vector<std::int_fast32_t>& Paths);
+	bool RefinePath(const std::vector<float>& Map, const lwmf::IntRectStruct& Rect, std::int_fast32_t Start, std::int_fast32_t Target, std::list<lwmf::IntPointStruct>& WayPoints);
+	bool CalculateHierarchicalPath(const std::vector<float>& Map, std::int_fast32_t Start, std::int_fast32_t Target, std::list<lwmf::IntPointStruct>& WayPoints);
+	bool CalculateNextHopPath(std::int_fast32_t Start, std::int_fast32_t Target, std::list<lwmf::IntPointStruct>& WayPoints);
+	void BuildNextHopTables(const std::vector<float>& Map, std::int_fast32_t Width, std::int_fast32_t Height, const std::vector<std::int_fast32_t>& DoorIndices);
+	void BuildNextHopRows(std::int_fast32_t Variant, std::int_fast32_t FirstCell, std::int_fast32_t LastCell);
+	void UpdateDoorState(std::int_fast32_t Index, bool Open);
 
 	//
 	// Variables and constants
@@ -39,6 +65,67 @@ namespace Game_PathFinding
 
 	inline std::vector<float> FlattenedMap{};
 
+	// Hierarchical pathfinding (HPA*)
+	// The clusters are squares of ClusterSize x ClusterSize map cells, the entrances between them become the nodes of an abstract graph
+
+	struct ClusterStruct final
+	{
+		// Map indices of entrance cells in this cluster
+		std::vector<std::int_fast32_t> Nodes{};
+		// Intra-cluster path costs between all entrance cells (Nodes x Nodes)
+		std::vector<float> Distances{};
+		lwmf::IntRectStruct Rect{};
+		std::int_fast32_t FirstNode{};
+	};
+
+	inline std::vector<ClusterStruct> Clusters{};
+	inline std::vector<std::int_fast32_t> AbstractNodes{};
+	inline std::vector<std::int_fast32_t> AbstractNodeClusters{};
+	inline std::vector<std::int_fast32_t> NodeOfCell{};
+	inline std::int_fast32_t ClusterSize{ 16 };
+	inline std::int_fast32_t HierarchyMinMapSize{ 4096 };
+	inline std::int_fast32_t ClustersX{};
+	inline std::int_fast32_t ClustersY{};
+	inline std::int_fast32_t HierarchyMapWidth{};
+	inline std::int_fast32_t HierarchyMapHeight{};
+	inline constexpr std::int_fast32_t MaxEntranceWidth{ 6 };
+	inline bool HierarchyEnabled{};
+
+	// Next-hop tables (small maps)
+	// For every pair of walkable cells the direction of the first step on a shortest path is stored with 2 bits
+
+	enum class NextHopDirections : std::int_fast32_t
+	{
+		North,
+		West,
+		East,
+		South
+	};
+
+	struct NextHopTableStruct final
+	{
+		// Cells x NextHopRowSize bytes, four targets per byte
+		std::vector<std::uint8_t> Directions{};
+		// Connected area per cell (-1 = not walkable), cells in different areas are unreachable
+		std::vector<std::int_fast32_t> Components{};
+	};
+
+	// One table per door state combination (bit set = door open) - or only the "all doors closed" table if there are too many doors
+	inline std::vector<NextHopTableStruct> NextHopTables{};
+	inline std::vector<std::int_fast32_t> NextHopCells{};
+	inline std::vector<std::int_fast32_t> NextHopCellOfIndex{};
+	inline std::vector<std::int_fast32_t> NextHopNeighbours{};
+	inline std::vector<std::int_fast32_t> NextHopDoorCells{};
+	inline std::int_fast32_t NextHopRowSize{};
+	inline std::int_fast32_t NextHopMapWidth{};
+	inline std::int_fast32_t NextHopMaxCells{ 4096 };
+	inline std::int_fast32_t NextHopMaxDoors{ 4 };
+	// Memory for all next-hop tables together - fewer tables (or none) are built if they would not fit
+	inline std::int_fast32_t NextHopMaxMegabytes{ 64 };
+	inline std::int_fast32_t OpenDoors{};
+	inline std::uint_fast32_t DoorState{};
+	inline bool NextHopEnabled{};
+
 	//
 	// Functions
 	//
@@ -68,6 +155,26 @@ namespace Game_PathFinding
 		}
 	}
 
+	inline bool CalculatePath(const std::vector<float>& Map, const std::int_fast32_t Width, const std::int_fast32_t Height, const std::int_fast32_t Start, const std::int_fast32_t Target, const bool Diagonal, const PathModes Mode, std::list<lwmf::IntPointStruct>& WayPoints)
+	{
+		if (!Diagonal && Mode == PathModes::Accelerated)
+		{
+			// Small maps use the precomputed next-hop tables (as long as there is a table for the current door states)...
+			if (NextHopEnabled && (NextHopTables.size() > 1 || OpenDoors == 0))
+			{
+				return CalculateNextHopPath(Start, Target, WayPoints);
+			}
+
+			// ...large maps are searched on the abstract graph (4-way movement only)
+			if (HierarchyEnabled)
+			{
+				return CalculateHierarchicalPath(Map, Start, Target, WayPoints);
+			}
+		}
+
+		return CalculateGridPath(Map, Width, Height, Start, Target, Diagonal, WayPoints);
+	}
+
 	//
 	// A* pathfinding algorithm
 	//
@@ -77,7 +184,7 @@ namespace Game_PathFinding
 	// https://www.raywenderlich.com/3016-introduction-to-a-pathfinding
 	//
 
-	inline bool CalculatePath(std::vector<float>& Map, const std::int_fast32_t Width, const std::int_fast32_t Height, const std::int_fast32_t Start, const std::int_fast32_t Target, bool Diagonal, std::list<lwmf::IntPointStruct>& WayPoints)
+	inline bool CalculateGridPath(const std::vector<float>& Map, const std::int_fast32_t Width, const std::int_fast32_t Height, const std::int_fast32_t Start, const std::int_fast32_t Target, bool Diagonal, std::list<lwmf::IntPointStruct>& WayPoints)
 	{
 		const NodeStruct StartNode(Start, 0.0F);
 		const NodeStruct TargetNode(Target, 0.0F);
@@ -153,5 +260,701 @@ namespace Game_PathFinding
 		return PathFound;
 	}
 
+	//
+	// Hierarchical pathfinding (HPA*)
+	//
+	// The abstract graph is built at level load: entrances between neighbouring clusters become nodes, intra-cluster distances between
+	// all nodes of a cluster are precomputed. A search only walks the abstract graph and refines the result locally inside the clusters.
+	// If a door toggles, only the affected cluster (and its neighbours, if the door sits on a cluster border) gets rebuilt.
+	//
+	// See explanation here:
+	//
+	// https://webdocs.cs.ualberta.ca/~mmueller/ps/hpastar.pdf
+	//
+
+	inline void BuildHierarchy(const std::vector<float>& Map, const std::int_fast32_t Width, const std::int_fast32_t Height)
+	{
+		Clusters.clear();
+		AbstractNodes.clear();
+		AbstractNodeClusters.clear();
+		NodeOfCell.clear();
+
+		HierarchyEnabled = Width * Height >= HierarchyMinMapSize;
+
+		if (!HierarchyEnabled)
+		{
+			return;
+		}
+
+		NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Build hierarchical pathfinding graph...");
+
+		HierarchyMapWidth = Width;
+		HierarchyMapHeight = Height;
+		ClustersX = (Width + ClusterSize - 1) / ClusterSize;
+		ClustersY = (Height + ClusterSize - 1) / ClusterSize;
+		Clusters.resize(static_cast<std::size_t>(ClustersX) * static_cast<std::size_t>(ClustersY));
+		NodeOfCell.resize(static_cast<std::size_t>(Width) * static_cast<std::size_t>(Height), -1);
+
+		for (std::int_fast32_t y{}; y < ClustersY; ++y)
+		{
+			for (std::int_fast32_t x{}; x < ClustersX; ++x)
+			{
+				Clusters[y * ClustersX + x].Rect = { x * ClusterSize, y * ClusterSize, std::min(ClusterSize, Width - x * ClusterSize), std::min(ClusterSize, Height - y * ClusterSize) };
+			}
+		}
+
+		const std::int_fast32_t NumberOfClusters{ static_cast<std::int_fast32_t>(Clusters.size()) };
+
+		for (std::int_fast32_t i{}; i < NumberOfClusters; ++i)
+		{
+			BuildClusterNodes(Map, i);
+			BuildClusterDistances(Map, i);
+		}
+
+		NumberAbstractNodes();
+
+		NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Clusters: " + std::to_string(NumberOfClusters) + ", abstract nodes: " + std::to_string(AbstractNodes.size()));
+	}
+
+	inline void UpdateHierarchy(const std::vector<float>& Map, const std::int_fast32_t Index)
+	{
+		if (!HierarchyEnabled)
+		{
+			return;
+		}
+
+		const std::int_fast32_t ClusterIndex{ GetClusterIndex(Index) };
+		const std::int_fast32_t ClusterX{ ClusterIndex % ClustersX };
+		const std::int_fast32_t ClusterY{ ClusterIndex / ClustersX };
+		const lwmf::IntRectStruct& Rect{ Clusters[ClusterIndex].Rect };
+		const std::int_fast32_t x{ Index % HierarchyMapWidth };
+		const std::int_fast32_t y{ Index / HierarchyMapWidth };
+
+		// Entrances on a shared border also belong to the neighbour cluster
+		std::vector<std::int_fast32_t> AffectedClusters{ ClusterIndex };
+
+		if (x == Rect.X && ClusterX > 0)
+		{
+			AffectedClusters.emplace_back(ClusterIndex - 1);
+		}
+
+		if (x == Rect.X + Rect.Width - 1 && ClusterX + 1 < ClustersX)
+		{
+			AffectedClusters.emplace_back(ClusterIndex + 1);
+		}
+
+		if (y == Rect.Y && ClusterY > 0)
+		{
+			AffectedClusters.emplace_back(ClusterIndex - ClustersX);
+		}
+
+		if (y == Rect.Y + Rect.Height - 1 && ClusterY + 1 < ClustersY)
+		{
+			AffectedClusters.emplace_back(ClusterIndex + ClustersX);
+		}
+
+		for (const auto& Cluster : AffectedClusters)
+		{
+			BuildClusterNodes(Map, Cluster);
+			BuildClusterDistances(Map, Cluster);
+		}
+
+		NumberAbstractNodes();
+	}
+
+	inline void BuildClusterNodes(const std::vector<float>& Map, const std::int_fast32_t ClusterIndex)
+	{
+		ClusterStruct& Cluster{ Clusters[ClusterIndex] };
+		Cluster.Nodes.clear();
+
+		const std::int_fast32_t ClusterX{ ClusterIndex % ClustersX };
+		const std::int_fast32_t ClusterY{ ClusterIndex / ClustersX };
+
+		if (ClusterX > 0)
+		{
+			ScanClusterBorder(Map, ClusterIndex, -1, 0);
+		}
+
+		if (ClusterX + 1 < ClustersX)
+		{
+			ScanClusterBorder(Map, ClusterIndex, 1, 0);
+		}
+
+		if (ClusterY > 0)
+		{
+			ScanClusterBorder(Map, ClusterIndex, 0, -1);
+		}
+
+		if (ClusterY + 1 < ClustersY)
+		{
+			ScanClusterBorder(Map, ClusterIndex, 0, 1);
+		}
+
+		// Corner cells can be entrances of two borders
+		std::sort(Cluster.Nodes.begin(), Cluster.Nodes.end());
+		Cluster.Nodes.erase(std::unique(Cluster.Nodes.begin(), Cluster.Nodes.end()), Cluster.Nodes.end());
+	}
+
+	inline void ScanClusterBorder(const std::vector<float>& Map, const std::int_fast32_t ClusterIndex, const std::int_fast32_t StepX, const std::int_fast32_t StepY)
+	{
+		// Walk along one border of the cluster and collect runs of cells which are walkable on both sides
+		// Short runs get one entrance in the middle, long runs one entrance at each end
+		// Both neighbouring clusters scan the same border the same way, so their entrances always face each other
+
+		ClusterStruct& Cluster{ Clusters[ClusterIndex] };
+		const bool Vertical{ StepX != 0 };
+		const std::int_fast32_t Length{ Vertical ? Cluster.Rect.Height : Cluster.Rect.Width };
+		const std::int_fast32_t BorderX{ StepX < 0 ? Cluster.Rect.X : Cluster.Rect.X + Cluster.Rect.Width - 1 };
+		const std::int_fast32_t BorderY{ StepY < 0 ? Cluster.Rect.Y : Cluster.Rect.Y + Cluster.Rect.Height - 1 };
+		std::int_fast32_t RunStart{ -1 };
+
+		for (std::int_fast32_t i{}; i <= Length; ++i)
+		{
+			bool Walkable{};
+
+			if (i < Length)
+			{
+				const std::int_fast32_t Index{ Vertical ? (Cluster.Rect.Y + i) * HierarchyMapWidth + BorderX : BorderY * HierarchyMapWidth + Cluster.Rect.X + i };
+				Walkable = Map[Index] < FLT_MAX && Map[Index + StepY * HierarchyMapWidth + StepX] < FLT_MAX;
+			}
+
+			if (Walkable && RunStart == -1)
+			{
+				RunStart = i;
+			}
+			else if (!Walkable && RunStart != -1)
+			{
+				const std::int_fast32_t RunEnd{ i - 1 };
+
+				const auto AddNode{ [&](const std::int_fast32_t Pos)
+				{
+					Cluster.Nodes.emplace_back(Vertical ? (Cluster.Rect.Y + Pos) * HierarchyMapWidth + BorderX : BorderY * HierarchyMapWidth + Cluster.Rect.X + Pos);
+				} };
+
+				if (RunEnd - RunStart + 1 >= MaxEntranceWidth)
+				{
+					AddNode(RunStart);
+					AddNode(RunEnd);
+				}
+				else
+				{
+					AddNode((RunStart + RunEnd) / 2);
+				}
+
+				RunStart = -1;
+			}
+		}
+	}
+
+	inline void BuildClusterDistances(const std::vector<float>& Map, const std::int_fast32_t ClusterIndex)
+	{
+		ClusterStruct& Cluster{ Clusters[ClusterIndex] };
+		const std::int_fast32_t NumberOfNodes{ static_cast<std::int_fast32_t>(Cluster.Nodes.size()) };
+		std::vector<float> Costs{};
+		std::vector<std::int_fast32_t> Paths{};
+
+		Cluster.Distances.assign(static_cast<std::size_t>(NumberOfNodes) * static_cast<std::size_t>(NumberOfNodes), FLT_MAX);
+
+		for (std::int_fast32_t i{}; i < NumberOfNodes; ++i)
+		{
+			// One Dijkstra run per entrance gives the distances to all other entrances
+			ExploreRect(Map, Cluster.Rect, Cluster.Nodes[i], -1, Costs, Paths);
+
+			for (std::int_fast32_t j{}; j < NumberOfNodes; ++j)
+			{
+				Cluster.Distances[i * NumberOfNodes + j] = Costs[(Cluster.Nodes[j] / HierarchyMapWidth - Cluster.Rect.Y) * Cluster.Rect.Width + Cluster.Nodes[j] % HierarchyMapWidth - Cluster.Rect.X];
+			}
+		}
+	}
+
+	inline void NumberAbstractNodes()
+	{
+		for (const auto& Index : AbstractNodes)
+		{
+			NodeOfCell[Index] = -1;
+		}
+
+		AbstractNodes.clear();
+		AbstractNodeClusters.clear();
+
+		const std::int_fast32_t NumberOfClusters{ static_cast<std::int_fast32_t>(Clusters.size()) };
+
+		for (std::int_fast32_t i{}; i < NumberOfClusters; ++i)
+		{
+			Clusters[i].FirstNode = static_cast<std::int_fast32_t>(AbstractNodes.size());
+
+			for (const auto& Index : Clusters[i].Nodes)
+			{
+				NodeOfCell[Index] = static_cast<std::int_fast32_t>(AbstractNodes.size());
+				AbstractNodes.emplace_back(Index);
+				AbstractNodeClusters.emplace_back(i);
+			}
+		}
+	}
+
+	inline std::int_fast32_t GetClusterIndex(const std::int_fast32_t Index)
+	{
+		return (Index / HierarchyMapWidth / ClusterSize) * ClustersX + (Index % HierarchyMapWidth) / ClusterSize;
+	}
+
+	inline bool ExploreRect(const std::vector<float>& Map, const lwmf::IntRectStruct& Rect, const std::int_fast32_t Start, const std::int_fast32_t Target, std::vector<float>& Costs, std::vector<std::int_fast32_t>& Paths)
+	{
+		// Search restricted to the given rectangle, working on local indices
+		// Target -1 explores the whole rectangle (Dijkstra), otherwise stops once the target is reached (A*)
+
+		const auto ToLocal{ [&](const std::int_fast32_t Index) { return (Index / HierarchyMapWidth - Rect.Y) * Rect.Width + Index % HierarchyMapWidth - Rect.X; } };
+		const auto ToMap{ [&](const std::int_fast32_t Local) { return (Rect.Y + Local / Rect.Width) * HierarchyMapWidth + Rect.X + Local % Rect.Width; } };
+
+		const std::int_fast32_t LocalStart{ ToLocal(Start) };
+		const std::int_fast32_t LocalTarget{ Target == -1 ? -1 : ToLocal(Target) };
+		const std::int_fast32_t TargetX{ Target == -1 ? 0 : Target % HierarchyMapWidth };
+		const std::int_fast32_t TargetY{ Target == -1 ? 0 : Target / HierarchyMapWidth };
+		std::array<std::int_fast32_t, 4> Neighbours{};
+		std::priority_queue<NodeStruct> NodesToVisit{};
+
+		Costs.assign(static_cast<std::size_t>(Rect.Width) * static_cast<std::size_t>(Rect.Height), FLT_MAX);
+		Paths.assign(Costs.size(), -1);
+		Costs[LocalStart] = 0.0F;
+		NodesToVisit.push(NodeStruct(LocalStart, 0.0F));
+
+		while (!NodesToVisit.empty())
+		{
+			const NodeStruct Current{ NodesToVisit.top() };
+			NodesToVisit.pop();
+
+			if (Current.Index == LocalTarget)
+			{
+				return true;
+			}
+
+			const std::int_fast32_t Row{ Current.Index / Rect.Width };
+			const std::int_fast32_t Column{ Current.Index % Rect.Width };
+
+			Neighbours[0] = (Row > 0) ? Current.Index - Rect.Width : -1;
+			Neighbours[1] = (Column > 0) ? Current.Index - 1 : -1;
+			Neighbours[2] = (Column + 1 < Rect.Width) ? Current.Index + 1 : -1;
+			Neighbours[3] = (Row + 1 < Rect.Height) ? Current.Index + Rect.Width : -1;
+
+			for (const auto& Neighbour : Neighbours)
+			{
+				if (Neighbour >= 0)
+				{
+					const std::int_fast32_t Index{ ToMap(Neighbour) };
+
+					if (const float NewCost{ Costs[Current.Index] + Map[Index] }; Map[Index] < FLT_MAX && NewCost < Costs[Neighbour])
+					{
+						const float HeuristicCost{ Target == -1 ? 0.0F : lwmf::CalcManhattanDistance<float>(Index % HierarchyMapWidth, TargetX, Index / HierarchyMapWidth, TargetY) };
+
+						NodesToVisit.push(NodeStruct(Neighbour, NewCost + HeuristicCost));
+
+						Costs[Neighbour] = NewCost;
+						Paths[Neighbour] = Current.Index;
+					}
+				}
+			}
+		}
+
+		return Target == -1;
+	}
+
+	inline bool RefinePath(const std::vector<float>& Map, const lwmf::IntRectStruct& Rect, const std::int_fast32_t Start, const std::int_fast32_t Target, std::list<lwmf::IntPointStruct>& WayPoints)
+	{
+		std::vector<float> Costs{};
+		std::vector<std::int_fast32_t> Paths{};
+
+		if (!ExploreRect(Map, Rect, Start, Target, Costs, Paths))
+		{
+			return false;
+		}
+
+		// Append the cells from start up to (not including) target
+		const std::int_fast32_t LocalStart{ (Start / HierarchyMapWidth - Rect.Y) * Rect.Width + Start % HierarchyMapWidth - Rect.X };
+		std::int_fast32_t Local{ (Target / HierarchyMapWidth - Rect.Y) * Rect.Width + Target % HierarchyMapWidth - Rect.X };
+		auto Position{ WayPoints.end() };
+
+		while (Local != LocalStart)
+		{
+			Local = Paths[Local];
+			Position = WayPoints.insert(Position, { Rect.X + Local % Rect.Width, Rect.Y + Local / Rect.Width });
+		}
+
+		return true;
+	}
+
+	inline bool CalculateHierarchicalPath(const std::vector<float>& Map, const std::int_fast32_t Start, const std::int_fast32_t Target, std::list<lwmf::IntPointStruct>& WayPoints)
+	{
+		if (Map[Start] == FLT_MAX || Map[Target] == FLT_MAX)
+		{
+			return false;
+		}
+
+		const std::int_fast32_t StartCluster{ GetClusterIndex(Start) };
+		const std::int_fast32_t TargetCluster{ GetClusterIndex(Target) };
+
+		// Same cluster - try a local search first, the path might still need to leave the cluster though
+		if (StartCluster == TargetCluster && RefinePath(Map, Clusters[StartCluster].Rect, Start, Target, WayPoints))
+		{
+			return true;
+		}
+
+		// Connect start and target temporarily to the entrances of their clusters
+		std::vector<float> StartCosts{};
+		std::vector<float> TargetCosts{};
+		std::vector<std::int_fast32_t> Paths{};
+		ExploreRect(Map, Clusters[StartCluster].Rect, Start, -1, StartCosts, Paths);
+		ExploreRect(Map, Clusters[TargetCluster].Rect, Target, -1, TargetCosts, Paths);
+
+		const auto LocalCost{ [&](const std::vector<float>& Costs, const lwmf::IntRectStruct& Rect, const std::int_fast32_t Index)
+		{
+			return Costs[(Index / HierarchyMapWidth - Rect.Y) * Rect.Width + Index % HierarchyMapWidth - Rect.X];
+		} };
+
+		// A* on the abstract graph - start and target get the two node numbers after the entrances
+		const std::int_fast32_t NumberOfNodes{ static_cast<std::int_fast32_t>(AbstractNodes.size()) };
+		const std::int_fast32_t StartNode{ NumberOfNodes };
+		const std::int_fast32_t TargetNode{ NumberOfNodes + 1 };
+		const std::int_fast32_t TargetX{ Target % HierarchyMapWidth };
+		const std::int_fast32_t TargetY{ Target / HierarchyMapWidth };
+		std::vector<float> Costs(static_cast<std::size_t>(NumberOfNodes) + 2, FLT_MAX);
+		std::vector<std::int_fast32_t> Parents(Costs.size(), -1);
+		std::priority_queue<NodeStruct> NodesToVisit{};
+		bool PathFound{};
+
+		const auto Visit{ [&](const std::int_fast32_t From, const std::int_fast32_t To, const float EdgeCost)
+		{
+			if (const float NewCost{ Costs[From] + EdgeCost }; EdgeCost < FLT_MAX && NewCost < Costs[To])
+			{
+				const std::int_fast32_t Index{ To == TargetNode ? Target : AbstractNodes[To] };
+
+				Costs[To] = NewCost;
+				Parents[To] = From;
+				NodesToVisit.push(NodeStruct(To, NewCost + lwmf::CalcManhattanDistance<float>(Index % HierarchyMapWidth, TargetX, Index / HierarchyMapWidth, TargetY)));
+			}
+		} };
+
+		Costs[StartNode] = 0.0F;
+		NodesToVisit.push(NodeStruct(StartNode, 0.0F));
+
+		while (!NodesToVisit.empty())
+		{
+			const NodeStruct Current{ NodesToVisit.top() };
+			NodesToVisit.pop();
+
+			if (Current.Index == TargetNode)
+			{
+				PathFound = true;
+				break;
+			}
+
+			if (Current.Index == StartNode)
+			{
+				const ClusterStruct& Cluster{ Clusters[StartCluster] };
+				const std::int_fast32_t ClusterNodes{ static_cast<std::int_fast32_t>(Cluster.Nodes.size()) };
+
+				for (std::int_fast32_t i{}; i < ClusterNodes; ++i)
+				{
+					Visit(StartNode, Cluster.FirstNode + i, LocalCost(StartCosts, Cluster.Rect, Cluster.Nodes[i]));
+				}
+
+				continue;
+			}
+
+			const std::int_fast32_t ClusterIndex{ AbstractNodeClusters[Current.Index] };
+			const ClusterStruct& Cluster{ Clusters[ClusterIndex] };
+			const std::int_fast32_t ClusterNodes{ static_cast<std::int_fast32_t>(Cluster.Nodes.size()) };
+			const std::int_fast32_t LocalNode{ Current.Index - Cluster.FirstNode };
+			const std::int_fast32_t Index{ AbstractNodes[Current.Index] };
+
+			// Intra-cluster edges
+			for (std::int_fast32_t i{}; i < ClusterNodes; ++i)
+			{
+				if (i != LocalNode)
+				{
+					Visit(Current.Index, Cluster.FirstNode + i, Cluster.Distances[LocalNode * ClusterNodes + i]);
+				}
+			}
+
+			// Inter-cluster edges - the facing entrance is always the direct neighbour cell
+			const std::int_fast32_t x{ Index % HierarchyMapWidth };
+			const std::int_fast32_t y{ Index / HierarchyMapWidth };
+			const std::array<std::int_fast32_t, 4> Neighbours{ y > 0 ? Index - HierarchyMapWidth : -1, x > 0 ? Index - 1 : -1, x + 1 < HierarchyMapWidth ? Index + 1 : -1, y + 1 < HierarchyMapHeight ? Index + HierarchyMapWidth : -1 };
+
+			for (const auto& Neighbour : Neighbours)
+			{
+				if (Neighbour >= 0 && NodeOfCell[Neighbour] >= 0 && AbstractNodeClusters[NodeOfCell[Neighbour]] != ClusterIndex)
+				{
+					Visit(Current.Index, NodeOfCell[Neighbour], Map[Neighbour]);
+				}
+			}
+
+			if (ClusterIndex == TargetCluster)
+			{
+				Visit(Current.Index, TargetNode, LocalCost(TargetCosts, Cluster.Rect, Index));
+			}
+		}
+
+		if (!PathFound)
+		{
+			return false;
+		}
+
+		// Refine the abstract path: intra-cluster steps get searched locally, inter-cluster steps are direct neighbours
+		std::vector<std::int_fast32_t> AbstractPath{ Target };
+
+		for (std::int_fast32_t Node{ Parents[TargetNode] }; Node != StartNode; Node = Parents[Node])
+		{
+			AbstractPath.emplace_back(AbstractNodes[Node]);
+		}
+
+		AbstractPath.emplace_back(Start);
+
+		for (std::int_fast32_t i{ static_cast<std::int_fast32_t>(AbstractPath.size()) - 1 }; i > 0; --i)
+		{
+			const std::int_fast32_t From{ AbstractPath[i] };
+			const std::int_fast32_t To{ AbstractPath[i - 1] };
+
+			if (From == To)
+			{
+				continue;
+			}
+
+			if (const std::int_fast32_t ClusterIndex{ GetClusterIndex(From) }; ClusterIndex == GetClusterIndex(To))
+			{
+				// The abstract graph says there is a way through this cluster - if the local search disagrees, the grid search decides
+				if (!RefinePath(Map, Clusters[ClusterIndex].Rect, From, To, WayPoints))
+				{
+					WayPoints.clear();
+					return CalculateGridPath(Map, HierarchyMapWidth, HierarchyMapHeight, Start, Target, false, WayPoints);
+				}
+			}
+			else
+			{
+				WayPoints.emplace_back(lwmf::IntPointStruct{ From % HierarchyMapWidth, From / HierarchyMapWidth });
+			}
+		}
+
+		return true;
+	}
+
+	//
+	// Next-hop tables
+	//
+	// Built at level load for maps with only a few walkable cells: a BFS from every walkable cell (in parallel on the threadpool) stores
+	// the direction of the first step towards every other cell. A path query just follows the stored directions.
+	//
+
+	inline void BuildNextHopTables(const std::vector<float>& Map, const std::int_fast32_t Width, const std::int_fast32_t Height, const std::vector<std::int_fast32_t>& DoorIndices)
+	{
+		NextHopTables.clear();
+		NextHopTables.shrink_to_fit();
+		NextHopCells.clear();
+		NextHopCellOfIndex.assign(static_cast<std::size_t>(Width) * static_cast<std::size_t>(Height), -1);
+		NextHopNeighbours.clear();
+		NextHopDoorCells.clear();
+		NextHopMapWidth = Width;
+		OpenDoors = 0;
+		DoorState = 0;
+
+		// Doors are part of the tables whether they are open or not
+		for (std::int_fast32_t Index{}; Index < Width * Height; ++Index)
+		{
+			if (Map[Index] < FLT_MAX || std::find(DoorIndices.begin(), DoorIndices.end(), Index) != DoorIndices.end())
+			{
+				NextHopCellOfIndex[Index] = static_cast<std::int_fast32_t>(NextHopCells.size());
+				NextHopCells.emplace_back(Index);
+			}
+		}
+
+		const std::int_fast32_t NumberOfCells{ static_cast<std::int_fast32_t>(NextHopCells.size()) };
+		NextHopRowSize = (NumberOfCells + 3) / 4;
+		const std::size_t TableBytes{ static_cast<std::size_t>(NumberOfCells) * static_cast<std::size_t>(NextHopRowSize) };
+		const std::size_t MaxBytes{ static_cast<std::size_t>(NextHopMaxMegabytes) << 20 };
+		NextHopEnabled = NumberOfCells > 0 && NumberOfCells <= NextHopMaxCells && TableBytes <= MaxBytes;
+
+		if (!NextHopEnabled)
+		{
+			return;
+		}
+
+		NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Build pathfinding next-hop tables...");
+
+		for (const auto& Index : DoorIndices)
+		{
+			NextHopDoorCells.emplace_back(NextHopCellOfIndex[Index]);
+		}
+
+		NextHopNeighbours.resize(static_cast<std::size_t>(NumberOfCells) * 4);
+
+		for (std::int_fast32_t Cell{}; Cell < NumberOfCells; ++Cell)
+		{
+			const std::int_fast32_t x{ NextHopCells[Cell] % Width };
+			const std::int_fast32_t y{ NextHopCells[Cell] / Width };
+
+			NextHopNeighbours[Cell * 4 + static_cast<std::int_fast32_t>(NextHopDirections::North)] = y > 0 ? NextHopCellOfIndex[NextHopCells[Cell] - Width] : -1;
+			NextHopNeighbours[Cell * 4 + static_cast<std::int_fast32_t>(NextHopDirections::West)] = x > 0 ? NextHopCellOfIndex[NextHopCells[Cell] - 1] : -1;
+			NextHopNeighbours[Cell * 4 + static_cast<std::int_fast32_t>(NextHopDirections::East)] = x + 1 < Width ? NextHopCellOfIndex[NextHopCells[Cell] + 1] : -1;
+			NextHopNeighbours[Cell * 4 + static_cast<std::int_fast32_t>(NextHopDirections::South)] = y + 1 < Height ? NextHopCellOfIndex[NextHopCells[Cell] + Width] : -1;
+		}
+
+		// One table per door state combination only if all of them fit into the memory budget - a table costs Cells * Cells / 4 bytes
+		const std::int_fast32_t NumberOfDoors{ static_cast<std::int_fast32_t>(NextHopDoorCells.size()) };
+		const std::int_fast32_t NumberOfVariants{ NumberOfDoors <= NextHopMaxDoors && (TableBytes << NumberOfDoors) <= MaxBytes ? 1 << NumberOfDoors : 1 };
+		NextHopTables.resize(NumberOfVariants);
+
+		for (std::int_fast32_t Variant{}; Variant < NumberOfVariants; ++Variant)
+		{
+			NextHopTableStruct& Table{ NextHopTables[Variant] };
+			Table.Directions.assign(static_cast<std::size_t>(NumberOfCells) * static_cast<std::size_t>(NextHopRowSize), 0);
+			Table.Components.assign(NumberOfCells, 0);
+
+			// Mark closed doors as not walkable...
+			for (std::int_fast32_t Door{}; Door < NumberOfDoors; ++Door)
+			{
+				if ((Variant & (1 << Door)) == 0)
+				{
+					Table.Components[NextHopDoorCells[Door]] = -1;
+				}
+			}
+
+			// ...and flood fill the connected areas
+			std::int_fast32_t Component{ 1 };
+			std::vector<std::int_fast32_t> Queue{};
+
+			for (std::int_fast32_t Cell{}; Cell < NumberOfCells; ++Cell)
+			{
+				if (Table.Components[Cell] == 0)
+				{
+					Table.Components[Cell] = Component;
+					Queue.assign(1, Cell);
+
+					for (std::size_t i{}; i < Queue.size(); ++i)
+					{
+						for (std::int_fast32_t Direction{}; Direction < 4; ++Direction)
+						{
+							if (const std::int_fast32_t Neighbour{ NextHopNeighbours[Queue[i] * 4 + Direction] }; Neighbour >= 0 && Table.Components[Neighbour] == 0)
+							{
+								Table.Components[Neighbour] = Component;
+								Queue.emplace_back(Neighbour);
+							}
+						}
+					}
+
+					++Component;
+				}
+			}
+
+			// Each job fills its own rows of the table
+			const std::int_fast32_t NumberOfJobs{ std::max(static_cast<std::int_fast32_t>(std::thread::hardware_concurrency()), static_cast<std::int_fast32_t>(1)) };
+			const std::int_fast32_t CellsPerJob{ (NumberOfCells + NumberOfJobs - 1) / NumberOfJobs };
+
+			for (std::int_fast32_t FirstCell{}; FirstCell < NumberOfCells; FirstCell += CellsPerJob)
+			{
+				ThreadPool.AddThread(&BuildNextHopRows, Variant, FirstCell, std::min(FirstCell + CellsPerJob, NumberOfCells));
+			}
+		}
+
+		ThreadPool.WaitForThreads();
+
+		NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Walkable cells: " + std::to_string(NumberOfCells) + ", tables: " + std::to_string(NumberOfVariants) + ", bytes per table: " + std::to_string(NumberOfCells * NextHopRowSize));
+	}
+
+	inline void BuildNextHopRows(const std::int_fast32_t Variant, const std::int_fast32_t FirstCell, const std::int_fast32_t LastCell)
+	{
+		NextHopTableStruct& Table{ NextHopTables[Variant] };
+		const std::int_fast32_t NumberOfCells{ static_cast<std::int_fast32_t>(NextHopCells.size()) };
+		std::vector<std::int_fast32_t> Queue(NumberOfCells);
+		std::vector<std::int_fast32_t> Visited(NumberOfCells, -1);
+		std::vector<std::uint8_t> FirstStep(NumberOfCells);
+
+		for (std::int_fast32_t Cell{ FirstCell }; Cell < LastCell; ++Cell)
+		{
+			if (Table.Components[Cell] == -1)
+			{
+				continue;
+			}
+
+			// BFS - every cell inherits the first step of the cell it was reached from
+			std::int_fast32_t Head{};
+			std::int_fast32_t Tail{};
+			Visited[Cell] = Cell;
+
+			for (std::int_fast32_t Direction{}; Direction < 4; ++Direction)
+			{
+				if (const std::int_fast32_t Neighbour{ NextHopNeighbours[Cell * 4 + Direction] }; Neighbour >= 0 && Table.Components[Neighbour] != -1)
+				{
+					Visited[Neighbour] = Cell;
+					FirstStep[Neighbour] = static_cast<std::uint8_t>(Direction);
+					Queue[Tail++] = Neighbour;
+				}
+			}
+
+			std::uint8_t* const Row{ Table.Directions.data() + static_cast<std::size_t>(Cell) * static_cast<std::size_t>(NextHopRowSize) };
+
+			while (Head < Tail)
+			{
+				const std::int_fast32_t Current{ Queue[Head++] };
+				Row[Current >> 2] |= static_cast<std::uint8_t>(FirstStep[Current] << ((Current & 3) << 1));
+
+				for (std::int_fast32_t Direction{}; Direction < 4; ++Direction)
+				{
+					if (const std::int_fast32_t Neighbour{ NextHopNeighbours[Current * 4 + Direction] }; Neighbour >= 0 && Visited[Neighbour] != Cell && Table.Components[Neighbour] != -1)
+					{
+						Visited[Neighbour] = Cell;
+						FirstStep[Neighbour] = FirstStep[Current];
+						Queue[Tail++] = Neighbour;
+					}
+				}
+			}
+		}
+	}
+
+	inline void UpdateDoorState(const std::int_fast32_t Index, const bool Open)
+	{
+		if (!NextHopEnabled)
+		{
+			return;
+		}
+
+		const std::int_fast32_t NumberOfDoors{ static_cast<std::int_fast32_t>(NextHopDoorCells.size()) };
+
+		for (std::int_fast32_t Door{}; Door < NumberOfDoors; ++Door)
+		{
+			if (NextHopCells[NextHopDoorCells[Door]] == Index)
+			{
+				Open ? ++OpenDoors : --OpenDoors;
+
+				if (Door < 32)
+				{
+					Open ? DoorState |= (1U << Door) : DoorState &= ~(1U << Door);
+				}
+
+				break;
+			}
+		}
+	}
+
+	inline bool CalculateNextHopPath(const std::int_fast32_t Start, const std::int_fast32_t Target, std::list<lwmf::IntPointStruct>& WayPoints)
+	{
+		const NextHopTableStruct& Table{ NextHopTables[NextHopTables.size() == 1 ? 0 : DoorState] };
+		const std::int_fast32_t StartCell{ NextHopCellOfIndex[Start] };
+		const std::int_fast32_t TargetCell{ NextHopCellOfIndex[Target] };
+
+		if (StartCell == -1 || TargetCell == -1 || Table.Components[StartCell] == -1 || Table.Components[StartCell] != Table.Components[TargetCell])
+		{
+			return false;
+		}
+
+		const std::size_t TargetByte{ static_cast<std::size_t>(TargetCell >> 2) };
+		const std::int_fast32_t TargetShift{ (TargetCell & 3) << 1 };
+
+		for (std::int_fast32_t Cell{ StartCell }; Cell != TargetCell;)
+		{
+			WayPoints.emplace_back(lwmf::IntPointStruct{ NextHopCells[Cell] % NextHopMapWidth, NextHopCells[Cell] / NextHopMapWidth });
+			Cell = NextHopNeighbours[Cell * 4 + ((Table.Directions[static_cast<std::size_t>(Cell) * static_cast<std::size_t>(NextHopRowSize) + TargetByte] >> TargetShift) & 3)];
+		}
+
+		return true;
+	}
+
 
 } // namespace Game_PathFinding
\ No newline at end of file
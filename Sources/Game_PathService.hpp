@@ -0,0 +1,305 @@
+/*
+******************************************
+*                                        *
+* Game_PathService.hpp                   *
+*                                        *
+* (c) 2017 - 2020 Stefan Kubsch          *
+******************************************
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <list>
+#include <future>
+#include <chrono>
+#include <algorithm>
+#include <utility>
+
+#include "Game_GlobalDefinitions.hpp"
+#include "Game_DataStructures.hpp"
+#include "Game_LevelHandling.hpp"
+#include "Game_PathFinding.hpp"
+#include "Tools_ErrorHandling.hpp"
+
+namespace Game_PathService
+{
+
+
+	//
+	// Entities submit path requests, the requests get solved by the threadpool and the results are applied at the start of the next tick
+	// While a request is pending, the entity keeps its last valid path
+	//
+	// Cell cost changes (doors) never wait for running jobs - they are queued and applied by DispatchRequests() as soon as no job is running anymore
+	// Until then no new jobs are dispatched, so the workers always see one consistent map
+	//
+
+	struct PathJobStruct final
+	{
+		std::list<lwmf::IntPointStruct> WayPoints{};
+		std::future<void> Result{};
+		std::chrono::steady_clock::time_point SubmitTime{};
+		EntityHandleStruct Entity{};
+		std::int_fast32_t EntityNumber{};
+		std::int_fast32_t Start{};
+		std::int_fast32_t Target{};
+		float Priority{};
+		bool PathFound{};
+	};
+
+	void Init();
+	void Reset();
+	void RequestPath(std::int_fast32_t EntityNumber, std::int_fast32_t Start, std::int_fast32_t Target, float Priority);
+	void SetCellCost(std::int_fast32_t Index, float Cost);
+	void ApplyCellCosts();
+	void SolveJob(PathJobStruct* Job);
+	void DispatchRequests(lwmf::Multithreading& ThreadPool);
+	void ApplyResults();
+	std::int_fast32_t GetQueueDepth();
+	void LogStatistics();
+
+	//
+	// Variables and constants
+	//
+
+	enum class RequestStates : std::int_fast32_t
+	{
+		None,
+		Pending,
+		Running
+	};
+
+	// Not yet dispatched requests (one per entity at most)
+	inline std::vector<PathJobStruct> PendingJobs{};
+	// Jobs handed over to the threadpool - std::list keeps the addresses stable while the workers write into them
+	inline std::list<PathJobStruct> RunningJobs{};
+	inline std::vector<RequestStates> RequestState{};
+	// Cell cost changes which wait for the running jobs to finish
+	inline std::vector<std::pair<std::int_fast32_t, float>> PendingCellCosts{};
+
+	// Budget: maximum number of jobs which are running on the threadpool at the same time
+	// (keeps the render threads from waiting behind a burst of path requests)
+	inline std::int_fast32_t JobsPerTick{ 4 };
+	inline constexpr std::int_fast32_t JobsPerTickMin{ 1 };
+	inline constexpr std::int_fast32_t JobsPerTickMax{ 64 };
+	inline constexpr std::int_fast32_t ClusterSizeMin{ 4 };
+	inline constexpr std::int_fast32_t ClusterSizeMax{ 64 };
+	inline constexpr std::int_fast32_t NextHopMaxDoorsMin{ 0 };
+	inline constexpr std::int_fast32_t NextHopMaxDoorsMax{ 6 };
+	inline constexpr std::int_fast32_t NextHopMaxMegabytesMin{ 1 };
+	inline constexpr std::int_fast32_t NextHopMaxMegabytesMax{ 512 };
+
+	// Statistics for profiling
+	inline std::int_fast32_t MaxQueueDepth{};
+	inline std::int_fast32_t CompletedJobs{};
+	inline float LastLatency{};
+	inline float AverageLatency{};
+	inline float MaxLatency{};
+
+	//
+	// Functions
+	//
+
+	inline void Init()
+	{
+		NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Init path service config...");
+
+		if (const std::string INIFile{ GameConfigFolder + "PathFindingConfig.ini" }; Tools_ErrorHandling::CheckFileExistence(INIFile, StopOnError))
+		{
+			JobsPerTick = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "PATHFINDING", "JobsPerTick");
+			Tools_ErrorHandling::CheckAndClampRange(JobsPerTick, JobsPerTickMin, JobsPerTickMax, __FILENAME__, "JobsPerTick");
+
+			Game_PathFinding::ClusterSize = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "HIERARCHY", "ClusterSize");
+			Tools_ErrorHandling::CheckAndClampRange(Game_PathFinding::ClusterSize, ClusterSizeMin, ClusterSizeMax, __FILENAME__, "ClusterSize");
+			Game_PathFinding::HierarchyMinMapSize = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "HIERARCHY", "MinMapSize");
+
+			Game_PathFinding::NextHopMaxCells = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "NEXTHOP", "MaxCells");
+			Game_PathFinding::NextHopMaxDoors = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "NEXTHOP", "MaxDoors");
+			Tools_ErrorHandling::CheckAndClampRange(Game_PathFinding::NextHopMaxDoors, NextHopMaxDoorsMin, NextHopMaxDoorsMax, __FILENAME__, "MaxDoors");
+			Game_PathFinding::NextHopMaxMegabytes = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "NEXTHOP", "MaxMegabytes");
+			Tools_ErrorHandling::CheckAndClampRange(Game_PathFinding::NextHopMaxMegabytes, NextHopMaxMegabytesMin, NextHopMaxMegabytesMax, __FILENAME__, "MaxMegabytes");
+		}
+	}
+
+	inline void Reset()
+	{
+		// Workers read the flattened map, so all running jobs need to be finished before a new level is generated
+		for (auto&& Job : RunningJobs)
+		{
+			Job.Result.wait();
+		}
+
+		if (CompletedJobs > 0)
+		{
+			LogStatistics();
+		}
+
+		RunningJobs.clear();
+		PendingJobs.clear();
+		RequestState.clear();
+		PendingCellCosts.clear();
+
+		MaxQueueDepth = 0;
+		CompletedJobs = 0;
+		LastLatency = 0.0F;
+		AverageLatency = 0.0F;
+		MaxLatency = 0.0F;
+	}
+
+	inline void RequestPath(const std::int_fast32_t EntityNumber, const std::int_fast32_t Start, const std::int_fast32_t Target, const float Priority)
+	{
+		if (EntityNumber >= static_cast<std::int_fast32_t>(RequestState.size()))
+		{
+			RequestState.resize(static_cast<std::size_t>(EntityNumber) + 1, RequestStates::None);
+		}
+
+		switch (RequestState[EntityNumber])
+		{
+			case RequestStates::None:
+			{
+				PathJobStruct Job{};
+				Job.SubmitTime = std::chrono::steady_clock::now();
+				Job.Entity = Entities.GetHandle(EntityNumber);
+				Job.EntityNumber = EntityNumber;
+				Job.Start = Start;
+				Job.Target = Target;
+				Job.Priority = Priority;
+				PendingJobs.emplace_back(std::move(Job));
+
+				RequestState[EntityNumber] = RequestStates::Pending;
+				MaxQueueDepth = std::max(MaxQueueDepth, GetQueueDepth());
+				break;
+			}
+			case RequestStates::Pending:
+			{
+				// Refresh the already queued request with the latest positions
+				for (auto&& Job : PendingJobs)
+				{
+					if (Job.EntityNumber == EntityNumber)
+					{
+						Job.Start = Start;
+						Job.Target = Target;
+						Job.Priority = Priority;
+						break;
+					}
+				}
+				break;
+			}
+			default: {}
+		}
+	}
+
+	inline void SetCellCost(const std::int_fast32_t Index, const float Cost)
+	{
+		// Workers read the flattened map, the abstract graph and the door states - so they are only modified while no job is running
+		PendingCellCosts.emplace_back(Index, Cost);
+
+		if (RunningJobs.empty())
+		{
+			ApplyCellCosts();
+		}
+	}
+
+	inline void ApplyCellCosts()
+	{
+		for (const auto& [Index, Cost] : PendingCellCosts)
+		{
+			Game_PathFinding::FlattenedMap[Index] = Cost;
+			Game_PathFinding::UpdateHierarchy(Game_PathFinding::FlattenedMap, Index);
+			Game_PathFinding::UpdateDoorState(Index, Cost < FLT_MAX);
+		}
+
+		PendingCellCosts.clear();
+	}
+
+	inline void SolveJob(PathJobStruct* Job)
+	{
+		Job->PathFound = Game_PathFinding::CalculatePath(Game_PathFinding::FlattenedMap, Game_LevelHandling::LevelMapWidth, Game_LevelHandling::LevelMapHeight, Job->Start, Job->Target, false, Game_PathFinding::PathModes::Accelerated, Job->WayPoints);
+	}
+
+	inline void DispatchRequests(lwmf::Multithreading& ThreadPool)
+	{
+		// Queued cost changes first - new jobs have to wait until the running ones are done and the changes are in
+		if (!PendingCellCosts.empty())
+		{
+			if (!RunningJobs.empty())
+			{
+				return;
+			}
+
+			ApplyCellCosts();
+		}
+
+		const std::int_fast32_t FreeSlots{ JobsPerTick - static_cast<std::int_fast32_t>(RunningJobs.size()) };
+
+		if (FreeSlots <= 0 || PendingJobs.empty())
+		{
+			return;
+		}
+
+		// Entities near the player get their paths first
+		const std::int_fast32_t NumberOfJobs{ std::min(FreeSlots, static_cast<std::int_fast32_t>(PendingJobs.size())) };
+		std::partial_sort(PendingJobs.begin(), PendingJobs.begin() + NumberOfJobs, PendingJobs.end(), [](const PathJobStruct& Left, const PathJobStruct& Right) { return Left.Priority < Right.Priority; });
+
+		for (std::int_fast32_t i{}; i < NumberOfJobs; ++i)
+		{
+			PathJobStruct& Job{ RunningJobs.emplace_back(std::move(PendingJobs[i])) };
+			RequestState[Job.EntityNumber] = RequestStates::Running;
+			Job.Result = ThreadPool.AddBackgroundThread(&SolveJob, &Job);
+		}
+
+		PendingJobs.erase(PendingJobs.begin(), PendingJobs.begin() + NumberOfJobs);
+	}
+
+	inline void ApplyResults()
+	{
+		for (auto Job{ RunningJobs.begin() }; Job != RunningJobs.end();)
+		{
+			if (Job->Result.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+			{
+				++Job;
+				continue;
+			}
+
+			// Entity was destroyed while the job was running - the result is stale
+			if (Entities.IsValid(Job->Entity))
+			{
+				EntityPathComponent& Path{ Entities.Path[Job->EntityNumber] };
+
+				if (Job->PathFound)
+				{
+					Path.PathFindingWayPoints.swap(Job->WayPoints);
+					Path.ValidPathFound = true;
+				}
+				else
+				{
+					Path.PathFindingWayPoints.clear();
+					Path.ValidPathFound = false;
+				}
+			}
+
+			LastLatency = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - Job->SubmitTime).count();
+			MaxLatency = std::max(MaxLatency, LastLatency);
+			++CompletedJobs;
+			AverageLatency += (LastLatency - AverageLatency) / static_cast<float>(CompletedJobs);
+
+			RequestState[Job->EntityNumber] = RequestStates::None;
+			Job = RunningJobs.erase(Job);
+		}
+	}
+
+	inline std::int_fast32_t GetQueueDepth()
+	{
+		return static_cast<std::int_fast32_t>(PendingJobs.size() + RunningJobs.size());
+	}
+
+	inline void LogStatistics()
+	{
+		NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Path service statistics - completed jobs: " + std::to_string(CompletedJobs) + ", max queue depth: " + std::to_string(MaxQueueDepth)
+			+ ", average latency: " + std::to_string(AverageLatency) + " ms, max latency: " + std::to_string(MaxLatency) + " ms");
+	}
+
+
+} // namespace Game_PathService
@@ -11,12 +11,13 @@
 
 
 #include <string>
-#include <fstream>
+#include <sstream>
 #include <iostream>
 
 #include "Game_GlobalDefinitions.hpp"
 #include "Tools_Console.hpp"
 #include "Tools_ErrorHandling.hpp"
+#include "Tools_VFS.hpp"
 
 namespace Game_PreGame
 {
@@ -35,7 +36,7 @@ namespace Game_PreGame
 
 		if (const std::string FileName{ GameConfigFolder + "IntroHeader.txt" }; Tools_ErrorHandling::CheckFileExistence(FileName, ContinueOnError))
 		{
-			std::ifstream IntroHeaderFile(FileName, std::ios::in);
+			std::istringstream IntroHeaderFile(Tools_VFS::ReadText(FileName));
 
 			std::string Line;
 
@@ -0,0 +1,328 @@
+/*
+******************************************
+*                                        *
+* Game_Projectiles.hpp                   *
+*                                        *
+* (c) 2017 - 2020 Stefan Kubsch          *
+******************************************
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <cmath>
+
+#include "Game_GlobalDefinitions.hpp"
+#include "Game_DataStructures.hpp"
+#include "Game_LevelHandling.hpp"
+#include "Game_EntityHandling.hpp"
+#include "Game_SpatialIndex.hpp"
+
+namespace Game_Projectiles
+{
+
+
+	//
+	// Projectile pool
+	//
+	// Projectiles are no entities - they live in preallocated columns, live ones are packed into [0, Count)
+	// A projectile which is removed is replaced by the last one, so spawning and removing never allocates
+	//
+	// Per tick every projectile moves along its velocity - the nearest entity along the swept segment is looked up in the cells
+	// around the segment (spatial index), then the cells up to it are walked (DDA): a wall or closed door in front of it stops the projectile
+	// Only the player fires projectiles (weapons with WeaponType=Projectile)
+	//
+
+	void Reset();
+	void Spawn(const lwmf::FloatPointStruct& Pos, const lwmf::FloatPointStruct& Velocity, float Radius, std::int_fast32_t Color, std::int_fast32_t Damage, std::int_fast32_t LifeTime);
+	void Remove(std::int_fast32_t Index);
+	void Update();
+	bool Sweep(std::int_fast32_t Index);
+	std::int_fast32_t FindEntityHit(std::int_fast32_t Index, const lwmf::FloatPointStruct& Start, const lwmf::FloatPointStruct& Direction, float& HitDistance);
+	float IntersectSegment(const lwmf::FloatPointStruct& Start, const lwmf::FloatPointStruct& Direction, float Length, const lwmf::FloatPointStruct& Center, float Radius);
+	void UpdateDepthOrder();
+	void RenderSprites();
+	void RenderProjectile(std::int_fast32_t Index, float TransX, float TransY);
+
+	//
+	// Variables and constants
+	//
+
+	inline constexpr std::int_fast32_t ProjectilePoolCapacity{ 4096 };
+	inline constexpr float EntityHitRadius{ 0.3F };
+
+	// Columns (indexed 0...Count - 1)
+	inline std::vector<float> PosX{};
+	inline std::vector<float> PosY{};
+	inline std::vector<float> VelocityX{};
+	inline std::vector<float> VelocityY{};
+	inline std::vector<float> Radius{};
+	inline std::vector<std::int_fast32_t> Color{};
+	inline std::vector<std::int_fast32_t> Damage{};
+	inline std::vector<std::int_fast32_t> TicksLeft{};
+	inline std::int_fast32_t Count{};
+
+	// Visible projectiles of the current frame - number and view-space depth, sorted back to front
+	inline std::vector<std::pair<std::int_fast32_t, float>> ProjectileOrder{};
+
+	//
+	// Functions
+	//
+
+	inline void Reset()
+	{
+		NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Reset projectile pool...");
+
+		PosX.resize(ProjectilePoolCapacity);
+		PosY.resize(ProjectilePoolCapacity);
+		VelocityX.resize(ProjectilePoolCapacity);
+		VelocityY.resize(ProjectilePoolCapacity);
+		Radius.resize(ProjectilePoolCapacity);
+		Color.resize(ProjectilePoolCapacity);
+		Damage.resize(ProjectilePoolCapacity);
+		TicksLeft.resize(ProjectilePoolCapacity);
+		ProjectileOrder.reserve(ProjectilePoolCapacity);
+
+		Count = 0;
+		ProjectileOrder.clear();
+	}
+
+	inline void Spawn(const lwmf::FloatPointStruct& Pos, const lwmf::FloatPointStruct& Velocity, const float ProjectileRadius, const std::int_fast32_t ProjectileColor, const std::int_fast32_t ProjectileDamage, const std::int_fast32_t LifeTime)
+	{
+		// Pool is full - the shot is dropped instead of growing the pool mid-game
+		if (Count >= ProjectilePoolCapacity)
+		{
+			return;
+		}
+
+		PosX[Count] = Pos.X;
+		PosY[Count] = Pos.Y;
+		VelocityX[Count] = Velocity.X;
+		VelocityY[Count] = Velocity.Y;
+		Radius[Count] = ProjectileRadius;
+		Color[Count] = ProjectileColor;
+		Damage[Count] = ProjectileDamage;
+		TicksLeft[Count] = LifeTime;
+		++Count;
+	}
+
+	inline void Remove(const std::int_fast32_t Index)
+	{
+		const std::int_fast32_t Last{ --Count };
+
+		if (Index != Last)
+		{
+			PosX[Index] = PosX[Last];
+			PosY[Index] = PosY[Last];
+			VelocityX[Index] = VelocityX[Last];
+			VelocityY[Index] = VelocityY[Last];
+			Radius[Index] = Radius[Last];
+			Color[Index] = Color[Last];
+			Damage[Index] = Damage[Last];
+			TicksLeft[Index] = TicksLeft[Last];
+		}
+	}
+
+	inline void Update()
+	{
+		// Backwards - a removed projectile is replaced by one which was already moved this tick
+		for (std::int_fast32_t Index{ Count - 1 }; Index >= 0; --Index)
+		{
+			if (--TicksLeft[Index] < 0 || Sweep(Index))
+			{
+				Remove(Index);
+			}
+		}
+	}
+
+	inline bool Sweep(const std::int_fast32_t Index)
+	{
+		// Returns true if the projectile hit something and has to be removed
+		const float Length{ std::sqrt(VelocityX[Index] * VelocityX[Index] + VelocityY[Index] * VelocityY[Index]) };
+
+		if (Length <= 0.0F)
+		{
+			return false;
+		}
+
+		const lwmf::FloatPointStruct Start{ PosX[Index], PosY[Index] };
+		const lwmf::FloatPointStruct Direction{ VelocityX[Index] / Length, VelocityY[Index] / Length };
+
+		// Nearest entity along the segment first...
+		float HitDistance{ Length };
+		const std::int_fast32_t HitEntity{ FindEntityHit(Index, Start, Direction, HitDistance) };
+
+		// ...then the cells up to it - a wall or closed door in front of it stops the projectile first
+		lwmf::IntPointStruct MapPos{ static_cast<std::int_fast32_t>(Start.X), static_cast<std::int_fast32_t>(Start.Y) };
+		const lwmf::FloatPointStruct DeltaDist{ std::fabs(1.0F / Direction.X), std::fabs(1.0F / Direction.Y) };
+		lwmf::FloatPointStruct SideDist{};
+		lwmf::IntPointStruct Step{};
+
+		Direction.X < 0.0F ? (Step.X = -1, SideDist.X = (Start.X - static_cast<float>(MapPos.X)) * DeltaDist.X) : (Step.X = 1, SideDist.X = (static_cast<float>(MapPos.X) + 1.0F - Start.X) * DeltaDist.X);
+		Direction.Y < 0.0F ? (Step.Y = -1, SideDist.Y = (Start.Y - static_cast<float>(MapPos.Y)) * DeltaDist.Y) : (Step.Y = 1, SideDist.Y = (static_cast<float>(MapPos.Y) + 1.0F - Start.Y) * DeltaDist.Y);
+
+		while (true)
+		{
+			if (static_cast<std::uint_fast32_t>(MapPos.X) >= static_cast<std::uint_fast32_t>(Game_LevelHandling::LevelMapWidth) || static_cast<std::uint_fast32_t>(MapPos.Y) >= static_cast<std::uint_fast32_t>(Game_LevelHandling::LevelMapHeight)
+				|| Game_LevelHandling::LevelMap[static_cast<std::int_fast32_t>(Game_LevelHandling::LevelMapLayers::Wall)][MapPos.X][MapPos.Y] > 0)
+			{
+				return true;
+			}
+
+			// Segment (or the way to the hit entity) ends inside this cell
+			if (std::min(SideDist.X, SideDist.Y) > HitDistance)
+			{
+				break;
+			}
+
+			SideDist.X < SideDist.Y ? (SideDist.X += DeltaDist.X, MapPos.X += Step.X) : (SideDist.Y += DeltaDist.Y, MapPos.Y += Step.Y);
+		}
+
+		if (HitEntity != -1)
+		{
+			Game_EntityHandling::HandleEntityHit(HitEntity, Damage[Index]);
+			return true;
+		}
+
+		PosX[Index] += VelocityX[Index];
+		PosY[Index] += VelocityY[Index];
+
+		return false;
+	}
+
+	inline std::int_fast32_t FindEntityHit(const std::int_fast32_t Index, const lwmf::FloatPointStruct& Start, const lwmf::FloatPointStruct& Direction, float& HitDistance)
+	{
+		// An entity is hit up to EntityHitRadius + Radius away from its center, so the cells next to the segment are searched, too
+		// Returns the entity nearest along the segment (or -1), HitDistance is set to where the segment reaches it
+		const float Reach{ EntityHitRadius + Radius[Index] };
+		const lwmf::FloatPointStruct End{ Start.X + Direction.X * HitDistance, Start.Y + Direction.Y * HitDistance };
+		const std::int_fast32_t FirstX{ std::max(static_cast<std::int_fast32_t>(std::floor(std::min(Start.X, End.X) - Reach)), static_cast<std::int_fast32_t>(0)) };
+		const std::int_fast32_t FirstY{ std::max(static_cast<std::int_fast32_t>(std::floor(std::min(Start.Y, End.Y) - Reach)), static_cast<std::int_fast32_t>(0)) };
+		const std::int_fast32_t LastX{ std::min(static_cast<std::int_fast32_t>(std::max(Start.X, End.X) + Reach), Game_LevelHandling::LevelMapWidth - 1) };
+		const std::int_fast32_t LastY{ std::min(static_cast<std::int_fast32_t>(std::max(Start.Y, End.Y) + Reach), Game_LevelHandling::LevelMapHeight - 1) };
+		std::int_fast32_t HitEntity{ -1 };
+
+		for (std::int_fast32_t y{ FirstY }; y <= LastY; ++y)
+		{
+			for (std::int_fast32_t x{ FirstX }; x <= LastX; ++x)
+			{
+				for (std::int_fast32_t Number{ Game_SpatialIndex::FirstInCell(x, y) }; Number != -1; Number = Game_SpatialIndex::NextInCell[Number])
+				{
+					if (const EntityStateComponent& State{ Entities.State[Number] }; State.IsDead || State.Type == EntityTypes::AmmoBox)
+					{
+						continue;
+					}
+
+					if (const float Distance{ IntersectSegment(Start, Direction, HitDistance, Entities.Transform[Number].Pos, Reach) }; Distance >= 0.0F && Distance <= HitDistance)
+					{
+						HitEntity = Number;
+						HitDistance = Distance;
+					}
+				}
+			}
+		}
+
+		return HitEntity;
+	}
+
+	inline float IntersectSegment(const lwmf::FloatPointStruct& Start, const lwmf::FloatPointStruct& Direction, const float Length, const lwmf::FloatPointStruct& Center, const float HitRadius)
+	{
+		// Distance along the segment where it enters the circle, -1.0 if it misses
+		const lwmf::FloatPointStruct ToCenter{ Center.X - Start.X, Center.Y - Start.Y };
+		const float Projection{ ToCenter.X * Direction.X + ToCenter.Y * Direction.Y };
+		const float Discriminant{ HitRadius * HitRadius - (ToCenter.X * ToCenter.X + ToCenter.Y * ToCenter.Y - Projection * Projection) };
+
+		if (Discriminant < 0.0F)
+		{
+			return -1.0F;
+		}
+
+		const float Distance{ std::max(Projection - std::sqrt(Discriminant), 0.0F) };
+
+		// Circle lies behind the start or beyond the end of the segment
+		return (Projection + std::sqrt(Discriminant) < 0.0F || Distance > Length) ? -1.0F : Distance;
+	}
+
+	inline void UpdateDepthOrder()
+	{
+		const float InverseMatrix{ 1.0F / (Plane.X * Player.Dir.Y - Player.Dir.X * Plane.Y) };
+
+		ProjectileOrder.clear();
+
+		for (std::int_fast32_t Index{}; Index < Count; ++Index)
+		{
+			const lwmf::FloatPointStruct ProjectilePos{ PosX[Index] - Player.Pos.X, PosY[Index] - Player.Pos.Y };
+
+			// Behind the player
+			if (const float TransY{ InverseMatrix * (-Plane.Y * ProjectilePos.X + Plane.X * ProjectilePos.Y) }; TransY > 0.0F)
+			{
+				ProjectileOrder.emplace_back(Index, TransY);
+			}
+		}
+
+		std::sort(ProjectileOrder.begin(), ProjectileOrder.end(), [](const auto& a, const auto& b) { return a.second > b.second; });
+	}
+
+	inline void RenderSprites()
+	{
+		//
+		// Sprite pass - entities and projectiles back to front in one merge
+		// EntityOrder is sorted front to back, ProjectileOrder back to front
+		//
+
+		UpdateDepthOrder();
+
+		const float InverseMatrix{ 1.0F / (Plane.X * Player.Dir.Y - Player.Dir.X * Plane.Y) };
+		std::int_fast32_t EntityIndex{ static_cast<std::int_fast32_t>(Game_EntityHandling::EntityOrder.size()) - 1 };
+
+		for (const auto& [Index, TransY] : ProjectileOrder)
+		{
+			while (EntityIndex >= 0 && Game_EntityHandling::EntityOrder[EntityIndex].second >= TransY)
+			{
+				Game_EntityHandling::RenderEntity(EntityIndex--);
+			}
+
+			const lwmf::FloatPointStruct ProjectilePos{ PosX[Index] - Player.Pos.X, PosY[Index] - Player.Pos.Y };
+			RenderProjectile(Index, InverseMatrix * (Player.Dir.Y * ProjectilePos.X - Player.Dir.X * ProjectilePos.Y), TransY);
+		}
+
+		while (EntityIndex >= 0)
+		{
+			Game_EntityHandling::RenderEntity(EntityIndex--);
+		}
+	}
+
+	inline void RenderProjectile(const std::int_fast32_t Index, const float TransX, const float TransY)
+	{
+		// Untextured billboard - a disc at eye height, scaled like the entities
+		const std::int_fast32_t CenterX{ static_cast<std::int_fast32_t>(static_cast<float>(Canvas.WidthMid) * (1.0F + TransX / TransY)) };
+		const std::int_fast32_t CenterY{ (Canvas.Height + VerticalLook) >> 1 };
+		const std::int_fast32_t ScreenRadius{ std::max(static_cast<std::int_fast32_t>(Radius[Index] * static_cast<float>(Canvas.Height) / TransY), static_cast<std::int_fast32_t>(1)) };
+		const std::int_fast32_t RadiusSquared{ ScreenRadius * ScreenRadius };
+		const std::int_fast32_t LineStartX{ std::max(CenterX - ScreenRadius, static_cast<std::int_fast32_t>(0)) };
+		const std::int_fast32_t LineEndX{ std::min(CenterX + ScreenRadius, Canvas.Width) };
+		const std::int_fast32_t LineStartY{ std::max(CenterY - ScreenRadius, static_cast<std::int_fast32_t>(0)) };
+		const std::int_fast32_t LineEndY{ std::min(CenterY + ScreenRadius, Canvas.Height) };
+
+		for (std::int_fast32_t x{ LineStartX }; x < LineEndX; ++x)
+		{
+			if (TransY < Game_EntityHandling::ZBuffer[x])
+			{
+				const std::int_fast32_t DistX{ x - CenterX };
+
+				for (std::int_fast32_t y{ LineStartY }; y < LineEndY; ++y)
+				{
+					if (const std::int_fast32_t DistY{ y - CenterY }; DistX * DistX + DistY * DistY <= RadiusSquared)
+					{
+						lwmf::SetPixel(Canvas, x, y, Color[Index]);
+					}
+				}
+			}
+		}
+	}
+
+
+} // namespace Game_Projectiles
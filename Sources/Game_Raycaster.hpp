@@ -19,6 +19,7 @@
 #include "Game_DataStructures.hpp"
 #include "Game_LevelHandling.hpp"
 #include "Game_EntityHandling.hpp"
+#include "Game_Doors.hpp"
 
 namespace Game_Raycaster
 {
@@ -120,44 +121,44 @@ namespace Game_Raycaster
 			{
 				SideDist.X < SideDist.Y ? (SideDist.X += DeltaDist.X, MapPos.X += Step.X, WallSide = false) : (SideDist.Y += DeltaDist.Y, MapPos.Y += Step.Y, WallSide = true);
 
-				for (const auto& Door : Doors)
+				// Doors are found via the cell index - no need to compare against every door per step
+				if (const std::int_fast32_t FoundDoor{ Game_Doors::GetDoorAt(static_cast<std::int_fast32_t>(MapPos.X), static_cast<std::int_fast32_t>(MapPos.Y)) }; FoundDoor > -1)
 				{
-					if (std::fabs(Door.Pos.X - MapPos.X) < FLT_EPSILON && std::fabs(Door.Pos.Y - MapPos.Y) < FLT_EPSILON)
+					const DoorStruct& Door{ Doors[FoundDoor] };
+
+					lwmf::FloatPointStruct MapPos2{ MapPos };
+
+					if (Player.Pos.X < MapPos2.X)
 					{
-						lwmf::FloatPointStruct MapPos2{ MapPos };
+						MapPos2.X -= 1.0F;
+					}
 
-						if (Player.Pos.X < MapPos2.X)
-						{
-							MapPos2.X -= 1.0F;
-						}
+					if (Player.Pos.Y > MapPos2.Y)
+					{
+						MapPos2.Y += 1.0F;
+					}
 
-						if (Player.Pos.Y > MapPos2.Y)
-						{
-							MapPos2.Y += 1.0F;
-						}
+					const float RayMulti{ WallSide ? (MapPos2.Y - Player.Pos.Y) / RayDir.Y : ((MapPos2.X - Player.Pos.X) + 1.0F) / RayDir.X };
+					const lwmf::FloatPointStruct TempResult{ Player.Pos.X + RayDir.X * RayMulti, Player.Pos.Y + RayDir.Y * RayMulti };
 
-						const float RayMulti{ WallSide ? (MapPos2.Y - Player.Pos.Y) / RayDir.Y : ((MapPos2.X - Player.Pos.X) + 1.0F) / RayDir.X };
-						const lwmf::FloatPointStruct TempResult{ Player.Pos.X + RayDir.X * RayMulti, Player.Pos.Y + RayDir.Y * RayMulti };
+					if (!WallSide)
+					{
+						const float StepY{ std::sqrtf(DeltaDist.X * DeltaDist.X - 1.0F) };
 
-						if (!WallSide)
+						if (std::fabs(std::floorf(TempResult.Y + (Step.Y * StepY) * 0.5F) - std::floorf(MapPos.Y)) < FLT_EPSILON && ((TempResult.Y + (Step.Y * StepY) * 0.5F) - MapPos.Y > Door.CurrentOpenPercent / 100.0F))
 						{
-							const float StepY{ std::sqrtf(DeltaDist.X * DeltaDist.X - 1.0F) };
-
-							if (std::fabs(std::floorf(TempResult.Y + (Step.Y * StepY) * 0.5F) - std::floorf(MapPos.Y)) < FLT_EPSILON && ((TempResult.Y + (Step.Y * StepY) * 0.5F) - MapPos.Y > Door.CurrentOpenPercent / 100.0F))
-							{
-								WallHit = true;
-								DoorNumber = Door.Number;
-							}
+							WallHit = true;
+							DoorNumber = Door.Number;
 						}
-						else
-						{
-							const float StepX{ std::sqrtf(DeltaDist.Y * DeltaDist.Y - 1.0F) };
+					}
+					else
+					{
+						const float StepX{ std::sqrtf(DeltaDist.Y * DeltaDist.Y - 1.0F) };
 
-							if (std::fabs(std::floorf(TempResult.X + (Step.X * StepX) * 0.5F) - std::floorf(MapPos.X)) < FLT_EPSILON && ((TempResult.X + (Step.X * StepX) * 0.5F) - MapPos.X > Door.CurrentOpenPercent / 100.0F))
-							{
-								WallHit = true;
-								DoorNumber = Door.Number;
-							}
+						if (std::fabs(std::floorf(TempResult.X + (Step.X * StepX) * 0.5F) - std::floorf(MapPos.X)) < FLT_EPSILON && ((TempResult.X + (Step.X * StepX) * 0.5F) - MapPos.X > Door.CurrentOpenPercent / 100.0F))
+						{
+							WallHit = true;
+							DoorNumber = Door.Number;
 						}
 					}
 				}
@@ -200,15 +201,28 @@ namespace Game_Raycaster
 			if (Part == Renderpart::WallLeft || Part == Renderpart::WalLRight)
 			{
 				std::int_fast32_t TextureX{ static_cast<std::int_fast32_t>(WallX * TextureSize) & (TextureSize - 1) };
+				const std::int_fast32_t* WallTexture{};
 
 				if (DoorNumber > -1)
 				{
-					if (Doors[DoorNumber].CurrentOpenPercent > DoorTypes[Doors[DoorNumber].DoorType].MinimumOpenPercent)
+					const DoorStruct& Door{ Doors[DoorNumber] };
+
+					if (Door.CurrentOpenPercent > DoorTypes[Door.DoorType].MinimumOpenPercent)
 					{
 						TextureX += 1;
 					}
 
-					TextureX -= static_cast<std::int_fast32_t>(Doors[DoorNumber].CurrentOpenPercent / DoorTypes[Doors[DoorNumber].DoorType].MaximumOpenPercent);
+					TextureX -= static_cast<std::int_fast32_t>(Door.CurrentOpenPercent / DoorTypes[Door.DoorType].MaximumOpenPercent);
+
+					// The door slides by the open offset - sample the shared door texture shifted back by it
+					// Columns within the opened part are never hit (see door check above), clamping just keeps the index valid
+					const std::int_fast32_t OpenOffset{ static_cast<std::int_fast32_t>(Door.CurrentOpenPercent * static_cast<float>(TextureSize) / 100.0F) };
+					TextureX = std::clamp(TextureX - OpenOffset, static_cast<std::int_fast32_t>(0), TextureSize - 1);
+					WallTexture = DoorTypes[Door.DoorType].OriginalTexture->Pixels.data();
+				}
+				else
+				{
+					WallTexture = Game_LevelHandling::LevelTextures[Game_LevelHandling::LevelMap[static_cast<std::int_fast32_t>(Game_LevelHandling::LevelMapLayers::Wall)][static_cast<std::int_fast32_t>(MapPos.X)][static_cast<std::int_fast32_t>(MapPos.Y)] - 1]->Pixels.data();
 				}
 
 				for (std::int_fast32_t y{ LineStart }; y < LineEnd; ++y)
@@ -216,8 +230,7 @@ namespace Game_Raycaster
 					float WallY{ static_cast<std::int_fast32_t>((y + y - VerticalLookTemp + LineHeight) / LineHeight) * 0.5F };
 					WallY -= static_cast<std::int_fast32_t>(WallY);
 					const std::int_fast32_t TextureY{ ((y + y - VerticalLookTemp + LineHeight) * TextureSize / LineHeight) >> 1 };
-					const std::int_fast32_t WallTexel{ DoorNumber > -1 ? Doors[DoorNumber].AnimTexture.Pixels[TextureY * TextureSize + TextureX] :
-						Game_LevelHandling::LevelTextures[Game_LevelHandling::LevelMap[static_cast<std::int_fast32_t>(Game_LevelHandling::LevelMapLayers::Wall)][static_cast<std::int_fast32_t>(MapPos.X)][static_cast<std::int_fast32_t>(MapPos.Y)] - 1].Pixels[TextureY * TextureSize + TextureX] };
+					const std::int_fast32_t WallTexel{ WallTexture[TextureY * TextureSize + TextureX] };
 
 					if (Game_LevelHandling::LightingFlag)
 					{
@@ -284,7 +297,7 @@ namespace Game_Raycaster
 							// Draw floor
 							if (y < Canvas.Height)
 							{
-								const std::int_fast32_t FloorTexel{ Game_LevelHandling::LevelTextures[Game_LevelHandling::LevelMap[static_cast<std::int_fast32_t>(Game_LevelHandling::LevelMapLayers::Floor)][static_cast<std::int_fast32_t>(Floor.X)][static_cast<std::int_fast32_t>(Floor.Y)] - 1].Pixels[(static_cast<std::int_fast32_t>(Floor.Y * TextureSize) & (TextureSize - 1)) * TextureSize + (static_cast<std::int_fast32_t>(Floor.X * TextureSize) & (TextureSize - 1))] };
+								const std::int_fast32_t FloorTexel{ Game_LevelHandling::LevelTextures[Game_LevelHandling::LevelMap[static_cast<std::int_fast32_t>(Game_LevelHandling::LevelMapLayers::Floor)][static_cast<std::int_fast32_t>(Floor.X)][static_cast<std::int_fast32_t>(Floor.Y)] - 1]->Pixels[(static_cast<std::int_fast32_t>(Floor.Y * TextureSize) & (TextureSize - 1)) * TextureSize + (static_cast<std::int_fast32_t>(Floor.X * TextureSize) & (TextureSize - 1))] };
 
 								if (Game_LevelHandling::LightingFlag)
 								{
@@ -321,7 +334,7 @@ namespace Game_Raycaster
 							// Transparent ceiling tile is marked as "-1" in "Level_MapCeilingData.conf"
 							if (LevelCeilingMapPos >= 0 && (TempY >= 0 && TempY <= LineStart))
 							{
-								const std::int_fast32_t CeilingTexel{ Game_LevelHandling::LevelTextures[LevelCeilingMapPos].Pixels[(static_cast<std::int_fast32_t>(Floor.Y * TextureSize) & (TextureSize - 1)) * TextureSize + (static_cast<std::int_fast32_t>(Floor.X * TextureSize) & (TextureSize - 1))] };
+								const std::int_fast32_t CeilingTexel{ Game_LevelHandling::LevelTextures[LevelCeilingMapPos]->Pixels[(static_cast<std::int_fast32_t>(Floor.Y * TextureSize) & (TextureSize - 1)) * TextureSize + (static_cast<std::int_fast32_t>(Floor.X * TextureSize) & (TextureSize - 1))] };
 
 								if (Game_LevelHandling::LightingFlag)
 								{
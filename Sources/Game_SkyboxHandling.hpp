@@ -16,6 +16,7 @@
 #include "Game_GlobalDefinitions.hpp"
 #include "Tools_ErrorHandling.hpp"
 #include "GFX_ImageHandling.hpp"
+#include "Game_AssetLoader.hpp"
 
 namespace Game_SkyboxHandling
 {
@@ -62,13 +63,7 @@ namespace Game_SkyboxHandling
 			{
 				NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Load skybox image...");
 
-				const lwmf::TextureStruct TempTexture { GFX_ImageHandling::ImportImage(lwmf::ReadINIValue<std::string>(INIFile, "SKYBOX", "SkyBoxImageName"))	};
-
-				SkyboxWidth = TempTexture.Width;
-				SkyboxHeight = TempTexture.Height;
-
-				NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Load skybox texture into GPU RAM...");
-				SkyboxShader.LoadTextureInGPU(TempTexture, &SkyboxShader.OGLTextureID);
+				Game_AssetLoader::AddUploadJob(lwmf::ReadINIValue<std::string>(INIFile, "SKYBOX", "SkyBoxImageName"), [](const lwmf::TextureStruct& Texture) { SkyboxWidth = Texture.Width; SkyboxHeight = Texture.Height; SkyboxShader.LoadTextureInGPU(Texture, &SkyboxShader.OGLTextureID); });
 			}
 		}
 	}
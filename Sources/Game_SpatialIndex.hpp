@@ -0,0 +1,210 @@
+/*
+******************************************
+*                                        *
+* Game_SpatialIndex.hpp                  *
+*                                        *
+* (c) 2017 - 2020 Stefan Kubsch          *
+******************************************
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+
+#include "Game_GlobalDefinitions.hpp"
+#include "Game_DataStructures.hpp"
+
+namespace Game_SpatialIndex
+{
+
+
+	//
+	// Spatial index for entities
+	//
+	// Every map cell holds a bucket (intrusive doubly linked list) of entity numbers, so any number of entities can share a cell
+	// Insert, move and remove are O(1)
+	//
+	// Iterate a cell like this:
+	//
+	// for (std::int_fast32_t Number{ Game_SpatialIndex::FirstInCell(x, y) }; Number != -1; Number = Game_SpatialIndex::NextInCell[Number])
+	//
+
+	void Init(std::int_fast32_t MapWidth, std::int_fast32_t MapHeight);
+	void Insert(std::int_fast32_t EntityNumber, std::int_fast32_t x, std::int_fast32_t y);
+	void Remove(std::int_fast32_t EntityNumber);
+	void Move(std::int_fast32_t EntityNumber, std::int_fast32_t x, std::int_fast32_t y);
+	void UpdateEntity(std::int_fast32_t EntityNumber);
+	void SetPlayerPosition(const lwmf::FloatPointStruct& Pos);
+	std::int_fast32_t FirstInCell(std::int_fast32_t x, std::int_fast32_t y);
+	bool IsPlayerCell(std::int_fast32_t x, std::int_fast32_t y);
+	bool IsBlocked(std::int_fast32_t x, std::int_fast32_t y, std::int_fast32_t IgnoreEntity);
+	bool IsCellEmpty(std::int_fast32_t x, std::int_fast32_t y);
+	void QueryRadius(const lwmf::FloatPointStruct& Center, float Radius, std::vector<std::int_fast32_t>& Result);
+
+	//
+	// Variables and constants
+	//
+
+	// First entity per cell (-1 = empty), indexed y * Width + x
+	inline std::vector<std::int_fast32_t> CellHeads{};
+
+	// Per entity (indexed by entity number)
+	inline std::vector<std::int_fast32_t> NextInCell{};
+	inline std::vector<std::int_fast32_t> PreviousInCell{};
+	inline std::vector<std::int_fast32_t> EntityCells{};
+
+	inline std::int_fast32_t PlayerCell{ -1 };
+	inline std::int_fast32_t Width{};
+	inline std::int_fast32_t Height{};
+
+	//
+	// Functions
+	//
+
+	inline void Init(const std::int_fast32_t MapWidth, const std::int_fast32_t MapHeight)
+	{
+		Width = MapWidth;
+		Height = MapHeight;
+		CellHeads.assign(static_cast<std::size_t>(Width) * static_cast<std::size_t>(Height), -1);
+		NextInCell.clear();
+		PreviousInCell.clear();
+		EntityCells.clear();
+		PlayerCell = -1;
+	}
+
+	inline void Insert(const std::int_fast32_t EntityNumber, const std::int_fast32_t x, const std::int_fast32_t y)
+	{
+		if (EntityNumber >= static_cast<std::int_fast32_t>(EntityCells.size()))
+		{
+			const std::size_t NewSize{ static_cast<std::size_t>(EntityNumber) + 1 };
+			NextInCell.resize(NewSize, -1);
+			PreviousInCell.resize(NewSize, -1);
+			EntityCells.resize(NewSize, -1);
+		}
+
+		const std::int_fast32_t Cell{ y * Width + x };
+
+		NextInCell[EntityNumber] = CellHeads[Cell];
+		PreviousInCell[EntityNumber] = -1;
+
+		if (CellHeads[Cell] != -1)
+		{
+			PreviousInCell[CellHeads[Cell]] = EntityNumber;
+		}
+
+		CellHeads[Cell] = EntityNumber;
+		EntityCells[EntityNumber] = Cell;
+	}
+
+	inline void Remove(const std::int_fast32_t EntityNumber)
+	{
+		if (EntityNumber >= static_cast<std::int_fast32_t>(EntityCells.size()) || EntityCells[EntityNumber] == -1)
+		{
+			return;
+		}
+
+		const std::int_fast32_t Next{ NextInCell[EntityNumber] };
+		const std::int_fast32_t Previous{ PreviousInCell[EntityNumber] };
+
+		if (Previous != -1)
+		{
+			NextInCell[Previous] = Next;
+		}
+		else
+		{
+			CellHeads[EntityCells[EntityNumber]] = Next;
+		}
+
+		if (Next != -1)
+		{
+			PreviousInCell[Next] = Previous;
+		}
+
+		NextInCell[EntityNumber] = -1;
+		PreviousInCell[EntityNumber] = -1;
+		EntityCells[EntityNumber] = -1;
+	}
+
+	inline void Move(const std::int_fast32_t EntityNumber, const std::int_fast32_t x, const std::int_fast32_t y)
+	{
+		if (EntityNumber < static_cast<std::int_fast32_t>(EntityCells.size()) && EntityCells[EntityNumber] == y * Width + x)
+		{
+			return;
+		}
+
+		Remove(EntityNumber);
+		Insert(EntityNumber, x, y);
+	}
+
+	inline void UpdateEntity(const std::int_fast32_t EntityNumber)
+	{
+		Move(EntityNumber, static_cast<std::int_fast32_t>(Entities.Transform[EntityNumber].Pos.X), static_cast<std::int_fast32_t>(Entities.Transform[EntityNumber].Pos.Y));
+	}
+
+	inline void SetPlayerPosition(const lwmf::FloatPointStruct& Pos)
+	{
+		PlayerCell = static_cast<std::int_fast32_t>(Pos.Y) * Width + static_cast<std::int_fast32_t>(Pos.X);
+	}
+
+	inline std::int_fast32_t FirstInCell(const std::int_fast32_t x, const std::int_fast32_t y)
+	{
+		return (x >= 0 && x < Width && y >= 0 && y < Height) ? CellHeads[y * Width + x] : -1;
+	}
+
+	inline bool IsPlayerCell(const std::int_fast32_t x, const std::int_fast32_t y)
+	{
+		return PlayerCell == y * Width + x;
+	}
+
+	inline bool IsBlocked(const std::int_fast32_t x, const std::int_fast32_t y, const std::int_fast32_t IgnoreEntity)
+	{
+		// Living enemies, neutrals and turrets block a cell, pickups do not
+		for (std::int_fast32_t Number{ FirstInCell(x, y) }; Number != -1; Number = NextInCell[Number])
+		{
+			if (const EntityStateComponent& State{ Entities.State[Number] }; Number != IgnoreEntity && !State.IsDead
+				&& (State.Type == EntityTypes::Enemy || State.Type == EntityTypes::Neutral || State.Type == EntityTypes::Turret))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	inline bool IsCellEmpty(const std::int_fast32_t x, const std::int_fast32_t y)
+	{
+		return FirstInCell(x, y) == -1 && !IsPlayerCell(x, y);
+	}
+
+	inline void QueryRadius(const lwmf::FloatPointStruct& Center, const float Radius, std::vector<std::int_fast32_t>& Result)
+	{
+		Result.clear();
+
+		const float RadiusSquared{ Radius * Radius };
+		const std::int_fast32_t StartX{ std::max(static_cast<std::int_fast32_t>(Center.X - Radius), static_cast<std::int_fast32_t>(0)) };
+		const std::int_fast32_t EndX{ std::min(static_cast<std::int_fast32_t>(Center.X + Radius), Width - 1) };
+		const std::int_fast32_t StartY{ std::max(static_cast<std::int_fast32_t>(Center.Y - Radius), static_cast<std::int_fast32_t>(0)) };
+		const std::int_fast32_t EndY{ std::min(static_cast<std::int_fast32_t>(Center.Y + Radius), Height - 1) };
+
+		for (std::int_fast32_t y{ StartY }; y <= EndY; ++y)
+		{
+			for (std::int_fast32_t x{ StartX }; x <= EndX; ++x)
+			{
+				for (std::int_fast32_t Number{ CellHeads[y * Width + x] }; Number != -1; Number = NextInCell[Number])
+				{
+					const float DistX{ Entities.Transform[Number].Pos.X - Center.X };
+					const float DistY{ Entities.Transform[Number].Pos.Y - Center.Y };
+
+					if (DistX * DistX + DistY * DistY <= RadiusSquared)
+					{
+						Result.emplace_back(Number);
+					}
+				}
+			}
+		}
+	}
+
+
+} // namespace Game_SpatialIndex
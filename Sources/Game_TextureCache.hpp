@@ -0,0 +1,240 @@
+/*
+******************************************
+*                                        *
+* Game_TextureCache.hpp                  *
+*                                        *
+* (c) 2017 - 2020 Stefan Kubsch          *
+******************************************
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <memory>
+#include <future>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <algorithm>
+
+#include "Game_GlobalDefinitions.hpp"
+#include "Tools_ErrorHandling.hpp"
+#include "Tools_VFS.hpp"
+
+namespace Game_TextureCache
+{
+
+
+	//
+	// Texture cache
+	//
+	// Textures are keyed by the hash of their content plus the requested size and format, not by their file name
+	// The same image referenced by several levels, doors, entities or weapons is decoded once and stored once
+	// Users hold shared handles; a texture nobody holds anymore stays resident until Trim() needs the memory
+	// Trim() evicts the least recently used of these textures until the cache fits into TextureCacheBudget
+	//
+	// Acquire() is called from asset jobs on several threads - a texture which is decoded right now is waited for, not decoded twice
+	//
+
+	using TextureHandle = std::shared_ptr<const lwmf::TextureStruct>;
+
+	enum class TextureFormats : std::int_fast32_t
+	{
+		PNG,
+		Baked
+	};
+
+	struct CacheKeyStruct final
+	{
+		std::uint64_t ContentHash{};
+		std::int_fast32_t Size{};
+		TextureFormats Format{};
+
+		bool operator==(const CacheKeyStruct&) const = default;
+	};
+
+	struct CacheKeyHash final
+	{
+		std::size_t operator()(const CacheKeyStruct& Key) const
+		{
+			return static_cast<std::size_t>(Key.ContentHash ^ lwmf::SplitMix64((static_cast<std::uint64_t>(Key.Size) << 8) | static_cast<std::uint64_t>(Key.Format)));
+		}
+	};
+
+	struct CacheEntryStruct final
+	{
+		std::shared_future<TextureHandle> Texture;
+		std::size_t Bytes{};
+		std::uint_fast64_t LastUse{};
+	};
+
+	TextureHandle Acquire(const std::string& FileName, std::int_fast32_t Size = 0);
+	TextureHandle AcquirePixels(std::span<const std::int32_t> Pixels, std::int_fast32_t Size);
+	template<typename Decoder>TextureHandle Lookup(const CacheKeyStruct& Key, Decoder&& Decode);
+	lwmf::TextureStruct DecodeFile(const std::vector<unsigned char>& Buffer, const std::string& FileName, std::int_fast32_t Size);
+	lwmf::TextureStruct CopyPixels(std::span<const std::int32_t> Pixels, std::int_fast32_t Size);
+	std::vector<unsigned char> ReadFile(const std::string& FileName);
+	void Trim();
+
+	//
+	// Variables and constants
+	//
+
+	inline std::unordered_map<CacheKeyStruct, CacheEntryStruct, CacheKeyHash> Entries{};
+	inline std::mutex CacheMutex;
+	inline std::size_t TotalBytes{};
+	inline std::uint_fast64_t UseCounter{};
+	inline std::uint_fast64_t Hits{};
+	inline std::uint_fast64_t Misses{};
+
+	//
+	// Functions
+	//
+
+	inline TextureHandle Acquire(const std::string& FileName, const std::int_fast32_t Size)
+	{
+		// Size 0 = no fixed size (HUD images, skybox...)
+		// The file is read anyway to get its hash - it is only decoded if its content is not cached yet
+		// A file which cannot be read throws before the lookup, so it never ends up in the cache (all missing files would share the hash of an empty buffer)
+		const std::vector<unsigned char> Buffer{ ReadFile(FileName) };
+
+		return Lookup({ lwmf::HashBytes(Buffer.data(), Buffer.size(), 0), Size, TextureFormats::PNG }, [&] { return DecodeFile(Buffer, FileName, Size); });
+	}
+
+	inline TextureHandle AcquirePixels(const std::span<const std::int32_t> Pixels, const std::int_fast32_t Size)
+	{
+		// Already decoded pixels (baked levels) of a Size * Size texture
+		return Lookup({ lwmf::HashBytes(Pixels.data(), Pixels.size_bytes(), 0), Size, TextureFormats::Baked }, [&] { return CopyPixels(Pixels, Size); });
+	}
+
+	template<typename Decoder>
+	inline TextureHandle Lookup(const CacheKeyStruct& Key, Decoder&& Decode)
+	{
+		std::shared_future<TextureHandle> Cached{};
+		std::promise<TextureHandle> Promise;
+
+		{
+			const std::scoped_lock Lock(CacheMutex);
+
+			if (const auto Entry{ Entries.find(Key) }; Entry != Entries.end())
+			{
+				Entry->second.LastUse = ++UseCounter;
+				Cached = Entry->second.Texture;
+				++Hits;
+			}
+			else
+			{
+				Entries.emplace(Key, CacheEntryStruct{ Promise.get_future().share(), 0, ++UseCounter });
+				++Misses;
+			}
+		}
+
+		if (Cached.valid())
+		{
+			// Waits if another thread is still decoding it
+			return Cached.get();
+		}
+
+		try
+		{
+			const TextureHandle Texture{ std::make_shared<const lwmf::TextureStruct>(Decode()) };
+
+			{
+				const std::scoped_lock Lock(CacheMutex);
+				CacheEntryStruct& Entry{ Entries[Key] };
+				Entry.Bytes = Texture->Pixels.size() * sizeof(Texture->Pixels[0]);
+				TotalBytes += Entry.Bytes;
+			}
+
+			Promise.set_value(Texture);
+			return Texture;
+		}
+		catch (...)
+		{
+			// Waiting threads get the same error, the next Acquire() tries again
+			{
+				const std::scoped_lock Lock(CacheMutex);
+				Entries.erase(Key);
+			}
+
+			Promise.set_exception(std::current_exception());
+			throw;
+		}
+	}
+
+	inline lwmf::TextureStruct DecodeFile(const std::vector<unsigned char>& Buffer, const std::string& FileName, const std::int_fast32_t Size)
+	{
+		lwmf::TextureStruct Texture{};
+		lwmf::DecodePNG(Texture, Buffer, FileName);
+
+		if (Size != 0)
+		{
+			Tools_ErrorHandling::CheckTextureSize(Texture.Width, Texture.Height, Size, StopOnError);
+		}
+
+		return Texture;
+	}
+
+	inline lwmf::TextureStruct CopyPixels(const std::span<const std::int32_t> Pixels, const std::int_fast32_t Size)
+	{
+		lwmf::TextureStruct Texture{};
+		lwmf::SetTextureMetrics(Texture, Size, Size);
+		Texture.Pixels.assign(Pixels.begin(), Pixels.end());
+
+		return Texture;
+	}
+
+	inline std::vector<unsigned char> ReadFile(const std::string& FileName)
+	{
+		std::vector<unsigned char> Buffer{};
+
+		if (!Tools_VFS::ReadFile(FileName, Buffer))
+		{
+			// The log only throws if logging is enabled
+			NARCLog.AddEntry(lwmf::LogLevel::Error, __FILENAME__, __LINE__, "ReadFile(): Error loading " + FileName + ": File not found!");
+			throw std::runtime_error("Error loading " + FileName);
+		}
+
+		return Buffer;
+	}
+
+	inline void Trim()
+	{
+		// Called between loads (no jobs running) - textures which are still in use are never evicted
+		const std::scoped_lock Lock(CacheMutex);
+
+		std::vector<std::pair<std::uint_fast64_t, CacheKeyStruct>> Unused{};
+
+		for (const auto& [Key, Entry] : Entries)
+		{
+			if (Entry.Texture.get().use_count() == 1)
+			{
+				Unused.emplace_back(Entry.LastUse, Key);
+			}
+		}
+
+		std::sort(Unused.begin(), Unused.end(), [](const auto& Left, const auto& Right) { return Left.first < Right.first; });
+
+		std::size_t Evicted{};
+
+		for (const auto& [LastUse, Key] : Unused)
+		{
+			if (TotalBytes <= TextureCacheBudget)
+			{
+				break;
+			}
+
+			TotalBytes -= Entries[Key].Bytes;
+			Entries.erase(Key);
+			++Evicted;
+		}
+
+		NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Texture cache: " + std::to_string(Entries.size()) + " textures (" + std::to_string(TotalBytes >> 10) + " KB), " + std::to_string(Hits) + " hits, " + std::to_string(Misses) + " decodes, " + std::to_string(Evicted) + " evicted.");
+	}
+
+
+} // namespace Game_TextureCache
@@ -0,0 +1,260 @@
+/*
+******************************************
+*                                        *
+* Game_TimingWheel.hpp                   *
+*                                        *
+* (c) 2017 - 2020 Stefan Kubsch          *
+******************************************
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <array>
+#include <functional>
+#include <algorithm>
+#include <utility>
+
+#include "Game_GlobalDefinitions.hpp"
+
+//
+// Handle of a timing wheel timer
+//
+
+struct TimerHandleStruct final
+{
+	std::int_fast32_t Index{ -1 };
+	std::uint_fast32_t Generation{};
+};
+
+namespace Game_TimingWheel
+{
+
+
+	//
+	// Hierarchical timing wheel for game tick timers
+	//
+	// Systems schedule a callback "in n ticks" instead of decrementing a counter every tick
+	// Four levels of 256 slots each - level 0 holds timers due within the current 256 ticks, every higher level covers 256 times the range of the level below
+	// When the tick crosses a level boundary, the matching slot of the upper level is cascaded down
+	// Work per tick is proportional to the timers which are due (plus the rare cascades), not to the number of timers
+	//
+	// A handle stays valid until its timer fired or was cancelled - a stale handle is simply "not pending"
+	//
+
+	struct TimerStruct final
+	{
+		std::function<void()> Callback{};
+		std::uint64_t Deadline{};
+		std::int_fast32_t Next{ -1 };
+		std::uint_fast32_t Generation{};
+		bool Active{};
+	};
+
+	void Reset();
+	TimerHandleStruct Schedule(std::int_fast32_t Delay, std::function<void()> Callback);
+	void Cancel(TimerHandleStruct& Handle);
+	bool IsPending(const TimerHandleStruct& Handle);
+	std::int_fast32_t TicksLeft(const TimerHandleStruct& Handle);
+	void Advance();
+	void Insert(std::int_fast32_t Index);
+	void Release(std::int_fast32_t Index);
+	void Cascade(std::int_fast32_t Level);
+
+	//
+	// Variables and constants
+	//
+
+	inline constexpr std::int_fast32_t NumberOfLevels{ 4 };
+	inline constexpr std::int_fast32_t SlotBits{ 8 };
+	inline constexpr std::int_fast32_t SlotsPerLevel{ 1 << SlotBits };
+	inline constexpr std::uint64_t SlotMask{ SlotsPerLevel - 1 };
+
+	// Current game tick - advanced once per fixed timestep
+	inline std::uint64_t CurrentTick{};
+
+	// First timer per slot (-1 = empty)
+	inline std::array<std::array<std::int_fast32_t, SlotsPerLevel>, NumberOfLevels> Slots{};
+
+	// Timer pool, released timers are reused
+	inline std::vector<TimerStruct> Timers{};
+	inline std::vector<std::int_fast32_t> FreeTimers{};
+	inline std::vector<std::int_fast32_t> DueTimers{};
+
+	//
+	// Functions
+	//
+
+	inline void Reset()
+	{
+		NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Reset timing wheel...");
+
+		for (auto&& Level : Slots)
+		{
+			Level.fill(-1);
+		}
+
+		// Generations survive the reset, so handles held from before never match a reused timer
+		FreeTimers.clear();
+
+		for (std::int_fast32_t Index{ static_cast<std::int_fast32_t>(Timers.size()) - 1 }; Index >= 0; --Index)
+		{
+			if (Timers[Index].Active)
+			{
+				++Timers[Index].Generation;
+			}
+
+			Timers[Index].Callback = nullptr;
+			Timers[Index].Active = false;
+			Timers[Index].Next = -1;
+			FreeTimers.emplace_back(Index);
+		}
+
+		CurrentTick = 0;
+	}
+
+	inline TimerHandleStruct Schedule(const std::int_fast32_t Delay, std::function<void()> Callback)
+	{
+		std::int_fast32_t Index{};
+
+		if (FreeTimers.empty())
+		{
+			Index = static_cast<std::int_fast32_t>(Timers.size());
+			Timers.emplace_back();
+		}
+		else
+		{
+			Index = FreeTimers.back();
+			FreeTimers.pop_back();
+		}
+
+		TimerStruct& Timer{ Timers[Index] };
+		Timer.Callback = std::move(Callback);
+		// Fires at the earliest with the next tick
+		Timer.Deadline = CurrentTick + static_cast<std::uint64_t>(std::max(Delay, static_cast<std::int_fast32_t>(1)));
+		Timer.Active = true;
+
+		Insert(Index);
+
+		return { Index, Timer.Generation };
+	}
+
+	inline void Cancel(TimerHandleStruct& Handle)
+	{
+		if (IsPending(Handle))
+		{
+			// The timer stays linked in its slot and is released when the slot is processed
+			TimerStruct& Timer{ Timers[Handle.Index] };
+			Timer.Active = false;
+			Timer.Callback = nullptr;
+			++Timer.Generation;
+		}
+
+		Handle = {};
+	}
+
+	inline bool IsPending(const TimerHandleStruct& Handle)
+	{
+		return Handle.Index >= 0 && Handle.Index < static_cast<std::int_fast32_t>(Timers.size()) && Timers[Handle.Index].Active && Timers[Handle.Index].Generation == Handle.Generation;
+	}
+
+	inline std::int_fast32_t TicksLeft(const TimerHandleStruct& Handle)
+	{
+		return IsPending(Handle) ? static_cast<std::int_fast32_t>(Timers[Handle.Index].Deadline - CurrentTick) : 0;
+	}
+
+	inline void Advance()
+	{
+		++CurrentTick;
+
+		// Cascade upper levels whose slot boundary was crossed - top down, so timers can fall through several levels at once
+		if ((CurrentTick & SlotMask) == 0)
+		{
+			for (std::int_fast32_t Level{ NumberOfLevels - 1 }; Level > 0; --Level)
+			{
+				if ((CurrentTick & ((static_cast<std::uint64_t>(1) << (SlotBits * Level)) - 1)) == 0)
+				{
+					Cascade(Level);
+				}
+			}
+		}
+
+		// Detach the due slot first - callbacks may schedule new timers
+		std::int_fast32_t& Head{ Slots[0][CurrentTick & SlotMask] };
+		DueTimers.clear();
+
+		for (std::int_fast32_t Index{ Head }; Index != -1; Index = Timers[Index].Next)
+		{
+			DueTimers.emplace_back(Index);
+		}
+
+		Head = -1;
+
+		for (const std::int_fast32_t Index : DueTimers)
+		{
+			if (Timers[Index].Active)
+			{
+				std::function<void()> Callback{ std::move(Timers[Index].Callback) };
+				Release(Index);
+
+				if (Callback)
+				{
+					Callback();
+				}
+			}
+			else
+			{
+				Release(Index);
+			}
+		}
+	}
+
+	inline void Insert(const std::int_fast32_t Index)
+	{
+		TimerStruct& Timer{ Timers[Index] };
+
+		// The level is the lowest one where deadline and current tick share all higher bits
+		std::int_fast32_t Level{};
+
+		while (Level < NumberOfLevels - 1 && (Timer.Deadline >> (SlotBits * (Level + 1))) != (CurrentTick >> (SlotBits * (Level + 1))))
+		{
+			++Level;
+		}
+
+		std::int_fast32_t& Head{ Slots[Level][(Timer.Deadline >> (SlotBits * Level)) & SlotMask] };
+		Timer.Next = Head;
+		Head = Index;
+	}
+
+	inline void Release(const std::int_fast32_t Index)
+	{
+		TimerStruct& Timer{ Timers[Index] };
+
+		if (Timer.Active)
+		{
+			++Timer.Generation;
+		}
+
+		Timer.Active = false;
+		Timer.Callback = nullptr;
+		Timer.Next = -1;
+		FreeTimers.emplace_back(Index);
+	}
+
+	inline void Cascade(const std::int_fast32_t Level)
+	{
+		std::int_fast32_t& Head{ Slots[Level][(CurrentTick >> (SlotBits * Level)) & SlotMask] };
+		std::int_fast32_t Index{ Head };
+		Head = -1;
+
+		while (Index != -1)
+		{
+			const std::int_fast32_t Next{ Timers[Index].Next };
+			Timers[Index].Active ? Insert(Index) : Release(Index);
+			Index = Next;
+		}
+	}
+
+
+} // namespace Game_TimingWheel
@@ -0,0 +1,228 @@
+/*
+******************************************
+*                                        *
+* Game_Visibility.hpp                    *
+*                                        *
+* (c) 2017 - 2020 Stefan Kubsch          *
+******************************************
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <array>
+#include <algorithm>
+
+#include "Game_GlobalDefinitions.hpp"
+#include "Tools_ErrorHandling.hpp"
+#include "Game_DataStructures.hpp"
+#include "Game_LevelHandling.hpp"
+
+namespace Game_Visibility
+{
+
+
+	//
+	// Player-centric visibility field
+	//
+	// Computed from the player's tile with recursive shadowcasting over the wall layer (closed doors are walls, too)
+	// Recomputed only if the player changes the tile or a door changes its state - every entity can then check in O(1) if it sees the player
+	//
+	// See explanation here:
+	//
+	// http://www.roguebasin.com/index.php?title=FOV_using_recursive_shadowcasting
+	//
+
+	void Init();
+	void Reset();
+	void Invalidate();
+	void Update();
+	void CastLight(std::int_fast32_t Row, float StartSlope, float EndSlope, std::int_fast32_t xx, std::int_fast32_t xy, std::int_fast32_t yx, std::int_fast32_t yy);
+	bool IsOpaque(std::int_fast32_t x, std::int_fast32_t y);
+	bool IsVisible(std::int_fast32_t x, std::int_fast32_t y);
+	bool IsExplored(std::int_fast32_t x, std::int_fast32_t y);
+	bool CanSeePlayer(std::int_fast32_t EntityNumber);
+
+	//
+	// Variables and constants
+	//
+
+	// Multipliers for transforming coordinates into the eight octants
+	inline constexpr std::array<std::array<std::int_fast32_t, 8>, 4> OctantMultipliers
+	{ {
+		{ 1, 0, 0, -1, -1, 0, 0, 1 },
+		{ 0, 1, -1, 0, 0, -1, 1, 0 },
+		{ 0, 1, 1, 0, 0, -1, -1, 0 },
+		{ 1, 0, 0, 1, -1, 0, 0, -1 }
+	} };
+
+	inline constexpr std::int_fast32_t RadiusMin{ 1 };
+	inline constexpr std::int_fast32_t RadiusMax{ 256 };
+
+	// Both indexed y * LevelMapWidth + x
+	inline std::vector<std::uint8_t> VisibleMap{};
+	inline std::vector<std::uint8_t> ExploredMap{};
+
+	inline lwmf::IntPointStruct Origin{ -1, -1 };
+	inline std::int_fast32_t Radius{ 16 };
+	inline std::int_fast32_t MapWidth{};
+	inline std::int_fast32_t MapHeight{};
+	inline bool NeedsUpdate{ true };
+	// Cells explored since the minimap last drew them (indices as above) - used for the minimap fog of war
+	inline std::vector<std::int_fast32_t> NewlyExplored{};
+
+	//
+	// Functions
+	//
+
+	inline void Init()
+	{
+		NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Init visibility config...");
+
+		if (const std::string INIFile{ GameConfigFolder + "VisibilityConfig.ini" }; Tools_ErrorHandling::CheckFileExistence(INIFile, StopOnError))
+		{
+			Radius = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "VISIBILITY", "Radius");
+			Tools_ErrorHandling::CheckAndClampRange(Radius, RadiusMin, RadiusMax, __FILENAME__, "Radius");
+		}
+	}
+
+	inline void Reset()
+	{
+		MapWidth = Game_LevelHandling::LevelMapWidth;
+		MapHeight = Game_LevelHandling::LevelMapHeight;
+		VisibleMap.assign(static_cast<std::size_t>(MapWidth) * static_cast<std::size_t>(MapHeight), 0);
+		ExploredMap.assign(VisibleMap.size(), 0);
+		Origin = { -1, -1 };
+		NeedsUpdate = true;
+		NewlyExplored.clear();
+	}
+
+	inline void Invalidate()
+	{
+		NeedsUpdate = true;
+	}
+
+	inline void Update()
+	{
+		const lwmf::IntPointStruct PlayerTile{ static_cast<std::int_fast32_t>(Player.Pos.X), static_cast<std::int_fast32_t>(Player.Pos.Y) };
+
+		if (!NeedsUpdate && PlayerTile.X == Origin.X && PlayerTile.Y == Origin.Y)
+		{
+			return;
+		}
+
+		Origin = PlayerTile;
+		NeedsUpdate = false;
+
+		std::fill(VisibleMap.begin(), VisibleMap.end(), static_cast<std::uint8_t>(0));
+
+		const std::int_fast32_t OriginIndex{ Origin.Y * MapWidth + Origin.X };
+		VisibleMap[OriginIndex] = 1;
+
+		if (ExploredMap[OriginIndex] == 0)
+		{
+			ExploredMap[OriginIndex] = 1;
+			NewlyExplored.emplace_back(OriginIndex);
+		}
+
+		for (std::int_fast32_t Octant{}; Octant < 8; ++Octant)
+		{
+			CastLight(1, 1.0F, 0.0F, OctantMultipliers[0][Octant], OctantMultipliers[1][Octant], OctantMultipliers[2][Octant], OctantMultipliers[3][Octant]);
+		}
+	}
+
+	inline void CastLight(const std::int_fast32_t Row, float StartSlope, const float EndSlope, const std::int_fast32_t xx, const std::int_fast32_t xy, const std::int_fast32_t yx, const std::int_fast32_t yy)
+	{
+		if (StartSlope < EndSlope)
+		{
+			return;
+		}
+
+		const std::int_fast32_t RadiusSquared{ Radius * Radius };
+		float NewStartSlope{};
+
+		for (std::int_fast32_t j{ Row }; j <= Radius; ++j)
+		{
+			const std::int_fast32_t dy{ -j };
+			bool Blocked{};
+
+			for (std::int_fast32_t dx{ -j }; dx <= 0; ++dx)
+			{
+				const std::int_fast32_t x{ Origin.X + dx * xx + dy * xy };
+				const std::int_fast32_t y{ Origin.Y + dx * yx + dy * yy };
+				const float LeftSlope{ (static_cast<float>(dx) - 0.5F) / (static_cast<float>(dy) + 0.5F) };
+				const float RightSlope{ (static_cast<float>(dx) + 0.5F) / (static_cast<float>(dy) - 0.5F) };
+
+				if (StartSlope < RightSlope)
+				{
+					continue;
+				}
+
+				if (EndSlope > LeftSlope)
+				{
+					break;
+				}
+
+				if (dx * dx + dy * dy < RadiusSquared && x >= 0 && x < MapWidth && y >= 0 && y < MapHeight)
+				{
+					const std::int_fast32_t Index{ y * MapWidth + x };
+					VisibleMap[Index] = 1;
+
+					if (ExploredMap[Index] == 0)
+					{
+						ExploredMap[Index] = 1;
+						NewlyExplored.emplace_back(Index);
+					}
+				}
+
+				if (Blocked)
+				{
+					if (IsOpaque(x, y))
+					{
+						NewStartSlope = RightSlope;
+						continue;
+					}
+
+					Blocked = false;
+					StartSlope = NewStartSlope;
+				}
+				else if (IsOpaque(x, y) && j < Radius)
+				{
+					// Scan the part of the next row which is not covered by this wall
+					Blocked = true;
+					CastLight(j + 1, StartSlope, LeftSlope, xx, xy, yx, yy);
+					NewStartSlope = RightSlope;
+				}
+			}
+
+			if (Blocked)
+			{
+				break;
+			}
+		}
+	}
+
+	inline bool IsOpaque(const std::int_fast32_t x, const std::int_fast32_t y)
+	{
+		return x < 0 || x >= MapWidth || y < 0 || y >= MapHeight || Game_LevelHandling::LevelMap[static_cast<std::int_fast32_t>(Game_LevelHandling::LevelMapLayers::Wall)][x][y] != 0;
+	}
+
+	inline bool IsVisible(const std::int_fast32_t x, const std::int_fast32_t y)
+	{
+		return VisibleMap[y * MapWidth + x] != 0;
+	}
+
+	inline bool IsExplored(const std::int_fast32_t x, const std::int_fast32_t y)
+	{
+		return ExploredMap[y * MapWidth + x] != 0;
+	}
+
+	inline bool CanSeePlayer(const std::int_fast32_t EntityNumber)
+	{
+		return IsVisible(static_cast<std::int_fast32_t>(Entities.Transform[EntityNumber].Pos.X), static_cast<std::int_fast32_t>(Entities.Transform[EntityNumber].Pos.Y));
+	}
+
+
+} // namespace Game_Visibility
@@ -11,11 +11,16 @@
 
 #include <cstdint>
 #include <string>
+#include <string_view>
+#include <array>
+#include <charconv>
+#include <algorithm>
 
 #include "Game_GlobalDefinitions.hpp"
 #include "Tools_ErrorHandling.hpp"
 #include "GFX_ImageHandling.hpp"
 #include "GFX_TextClass.hpp"
+#include "GFX_HUDLayerClass.hpp"
 #include "Game_DataStructures.hpp"
 
 class Game_WeaponDisplayClass final
@@ -25,6 +30,8 @@ public:
 	void Display();
 
 private:
+	void Refresh();
+
 	GFX_TextClass AmmoText{};
 	GFX_TextClass CarriedAmmoText{};
 	GFX_TextClass WeaponText{};
@@ -32,6 +39,15 @@ private:
 	lwmf::ShaderClass WeaponHUDShader{};
 	lwmf::IntRectStruct WeaponHUDRect{};
 	lwmf::ShaderClass CrosshairShader{};
+
+	// Texts are rendered into the layer only when one of the shown values changes
+	GFX_HUDLayerClass TextLayer{};
+	std::array<char, 16> AmmoInfo{};
+	std::array<char, 16> CarriedAmmoInfo{};
+	std::int_fast32_t DisplayedWeapon{ -1 };
+	std::int_fast32_t DisplayedLoadedRounds{ -1 };
+	std::int_fast32_t DisplayedCapacity{ -1 };
+	std::int_fast32_t DisplayedCarriedAmmo{ -1 };
 };
 
 inline void Game_WeaponDisplayClass::Init()
@@ -60,19 +76,53 @@ inline void Game_WeaponDisplayClass::Init()
 		AmmoText.InitFont(GameConfigFolder + "HUDWeaponDisplayConfig.ini", "HUDAMMOFONT");
 		CarriedAmmoText.InitFont(GameConfigFolder + "HUDWeaponDisplayConfig.ini", "HUDCARRIEDAMMOFONT");
 		WeaponText.InitFont(GameConfigFolder + "HUDWeaponDisplayConfig.ini", "HUDWEAPONFONT");
+
+		TextLayer.Init(WeaponHUDRect.X, WeaponHUDRect.Y, WeaponHUDRect.Width, WeaponHUDRect.Height, GFX_HUDLayerClass::Targets::GPU);
+		DisplayedWeapon = -1;
 	}
 }
 
 inline void Game_WeaponDisplayClass::Display()
 {
-	const lwmf::IntPointStruct WeaponTextPos{ WeaponHUDRect.X + WeaponText.GetOffset().X, WeaponHUDRect.Y + WeaponText.GetOffset().Y };
-	const lwmf::IntPointStruct CarriedAmmoTextPos{ WeaponHUDRect.X + CarriedAmmoText.GetOffset().X, WeaponHUDRect.Y + CarriedAmmoText.GetOffset().Y };
-	const lwmf::IntPointStruct AmmoTextPos{ WeaponHUDRect.X + AmmoText.GetOffset().X, WeaponHUDRect.Y + AmmoText.GetOffset().Y };
+	if (const WeaponStruct& Weapon{ Weapons[Player.SelectedWeapon] }; Player.SelectedWeapon != DisplayedWeapon || Weapon.LoadedRounds != DisplayedLoadedRounds || Weapon.Capacity != DisplayedCapacity || Weapon.CarriedAmmo != DisplayedCarriedAmmo)
+	{
+		Refresh();
+	}
 
 	CrosshairShader.RenderStaticTexture(&CrosshairShader.OGLTextureID, true, 1.0F);
 	WeaponHUDShader.RenderStaticTexture(&WeaponHUDShader.OGLTextureID, true, 1.0F);
+	TextLayer.Display();
+}
+
+inline void Game_WeaponDisplayClass::Refresh()
+{
+	const WeaponStruct& Weapon{ Weapons[Player.SelectedWeapon] };
+
+	// "07/35" - loaded rounds with at least two digits
+	char* AmmoInfoEnd{ AmmoInfo.data() };
+
+	if (Weapon.LoadedRounds < 10)
+	{
+		*AmmoInfoEnd++ = '0';
+	}
 
-	WeaponText.RenderText(Weapons[Player.SelectedWeapon].Name, WeaponTextPos.X, WeaponTextPos.Y);
-	CarriedAmmoText.RenderText(Weapons[Player.SelectedWeapon].HUDCarriedAmmoInfo, CarriedAmmoTextPos.X, CarriedAmmoTextPos.Y);
-	AmmoText.RenderText(Weapons[Player.SelectedWeapon].HUDAmmoInfo, AmmoTextPos.X, AmmoTextPos.Y);
+	AmmoInfoEnd = std::to_chars(AmmoInfoEnd, AmmoInfo.data() + AmmoInfo.size(), Weapon.LoadedRounds).ptr;
+	*AmmoInfoEnd++ = '/';
+	AmmoInfoEnd = std::to_chars(AmmoInfoEnd, AmmoInfo.data() + AmmoInfo.size(), Weapon.Capacity).ptr;
+
+	constexpr std::string_view CarriedAmmoLabel{ "Carried:" };
+	std::copy(CarriedAmmoLabel.begin(), CarriedAmmoLabel.end(), CarriedAmmoInfo.begin());
+	const char* const CarriedAmmoInfoEnd{ std::to_chars(CarriedAmmoInfo.data() + CarriedAmmoLabel.size(), CarriedAmmoInfo.data() + CarriedAmmoInfo.size(), Weapon.CarriedAmmo).ptr };
+
+	// Text positions are relative to the weapon HUD
+	lwmf::TextureStruct& Texture{ TextLayer.Begin() };
+	WeaponText.RenderTextToTexture(Texture, Weapon.Name, WeaponText.GetOffset().X, WeaponText.GetOffset().Y);
+	CarriedAmmoText.RenderTextToTexture(Texture, { CarriedAmmoInfo.data(), static_cast<std::size_t>(CarriedAmmoInfoEnd - CarriedAmmoInfo.data()) }, CarriedAmmoText.GetOffset().X, CarriedAmmoText.GetOffset().Y);
+	AmmoText.RenderTextToTexture(Texture, { AmmoInfo.data(), static_cast<std::size_t>(AmmoInfoEnd - AmmoInfo.data()) }, AmmoText.GetOffset().X, AmmoText.GetOffset().Y);
+	TextLayer.Commit();
+
+	DisplayedWeapon = Player.SelectedWeapon;
+	DisplayedLoadedRounds = Weapon.LoadedRounds;
+	DisplayedCapacity = Weapon.Capacity;
+	DisplayedCarriedAmmo = Weapon.CarriedAmmo;
 }
\ No newline at end of file
@@ -13,16 +13,21 @@
 #include <string>
 #include <cstring>
 #include <vector>
-#include <array>
-#include <fstream>
-#include <charconv>
+#include <sstream>
+#include <cmath>
 
 #include "Game_GlobalDefinitions.hpp"
 #include "Tools_ErrorHandling.hpp"
+#include "Tools_VFS.hpp"
 #include "GFX_ImageHandling.hpp"
+#include "Game_AssetLoader.hpp"
 #include "Game_DataStructures.hpp"
 #include "Game_LevelHandling.hpp"
 #include "Game_EntityHandling.hpp"
+#include "Game_SpatialIndex.hpp"
+#include "Game_TimingWheel.hpp"
+#include "Game_Hitscan.hpp"
+#include "Game_Projectiles.hpp"
 
 namespace Game_WeaponHandling
 {
@@ -30,7 +35,8 @@ namespace Game_WeaponHandling
 
 	enum class WeaponType : std::int_fast32_t
 	{
-		DirectHit
+		DirectHit,
+		Projectile
 	};
 
 	enum class WeaponsSounds : std::int_fast32_t
@@ -67,10 +73,8 @@ namespace Game_WeaponHandling
 	void InitiateWeaponChangeUp();
 	void InitiateWeaponChangeDown();
 	void FireWeapon();
-	void CheckReloadStatus();
+	void FinishReload();
 	void ChangeWeapon();
-	void CountdownMuzzleFlashCounter();
-	void CountdownCadenceCounter();
 	void DrawWeapon();
 	void PlayAudio(std::int_fast32_t SelectedPlayerWeapon, WeaponsSounds WeaponSound);
 	void CloseAudio();
@@ -79,9 +83,21 @@ namespace Game_WeaponHandling
 	// Variables and constants
 	//
 
-	inline constexpr std::int_fast32_t MaximumCarriedAmmoDigits{ 3 };
-	inline constexpr std::int_fast32_t MaximumAmmoCapacityDigits{ 3 };
-	inline constexpr std::int_fast32_t MaximumLoadedRoundsDigits{ 3 };
+	// Pellets per shot and half angle of the spread cone in degrees
+	inline constexpr std::int_fast32_t PelletsMin{ 1 };
+	inline constexpr std::int_fast32_t PelletsMax{ 64 };
+	inline constexpr float SpreadMin{ 0.0F };
+	inline constexpr float SpreadMax{ 30.0F };
+
+	// Projectile speed in cells per second, radius in cells, lifetime in seconds
+	inline constexpr float ProjectileSpeedMin{ 1.0F };
+	inline constexpr float ProjectileSpeedMax{ 100.0F };
+	inline constexpr float ProjectileRadiusMin{ 0.01F };
+	inline constexpr float ProjectileRadiusMax{ 0.5F };
+	inline constexpr std::int_fast32_t ProjectileLifeTimeMin{ 1 };
+	inline constexpr std::int_fast32_t ProjectileLifeTimeMax{ 30 };
+	inline std::vector<Game_Hitscan::RayStruct> ShotRays{};
+	inline std::vector<Game_Hitscan::HitStruct> ShotHits{};
 
 	inline WeaponState CurrentWeaponState{};
 	inline FiringState CurrentFiringState{};
@@ -92,6 +108,7 @@ namespace Game_WeaponHandling
 	inline float WeaponPace{};
 	inline bool WeaponPaceFlag{};
 	inline bool WeaponMuzzleFlashFlag{};
+	inline TimerHandleStruct MuzzleFlashTimer{};
 
 	//
 	// Functions
@@ -128,9 +145,32 @@ namespace Game_WeaponHandling
 				{
 					Weapons[Index].Type = static_cast<std::int_fast32_t>(WeaponType::DirectHit);
 				}
+				else if (WeaponTypeString == "Projectile")
+				{
+					Weapons[Index].Type = static_cast<std::int_fast32_t>(WeaponType::Projectile);
+				}
 
 				Weapons[Index].CarriedAmmo = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "DATA", "CarriedAmmo");
 				Weapons[Index].Cadence = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "DATA", "Cadence");
+				Weapons[Index].Pellets = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "DATA", "Pellets");
+				Weapons[Index].Spread = lwmf::ReadINIValue<float>(INIFile, "DATA", "Spread");
+				Tools_ErrorHandling::CheckAndClampRange(Weapons[Index].Pellets, PelletsMin, PelletsMax, __FILENAME__, "Pellets");
+				Tools_ErrorHandling::CheckAndClampRange(Weapons[Index].Spread, SpreadMin, SpreadMax, __FILENAME__, "Spread");
+
+				if (Weapons[Index].Type == static_cast<std::int_fast32_t>(WeaponType::Projectile))
+				{
+					float Speed{ lwmf::ReadINIValue<float>(INIFile, "PROJECTILE", "Speed") };
+					std::int_fast32_t LifeTime{ lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "PROJECTILE", "LifeTime") };
+					Weapons[Index].ProjectileRadius = lwmf::ReadINIValue<float>(INIFile, "PROJECTILE", "Radius");
+					Tools_ErrorHandling::CheckAndClampRange(Speed, ProjectileSpeedMin, ProjectileSpeedMax, __FILENAME__, "Speed");
+					Tools_ErrorHandling::CheckAndClampRange(LifeTime, ProjectileLifeTimeMin, ProjectileLifeTimeMax, __FILENAME__, "LifeTime");
+					Tools_ErrorHandling::CheckAndClampRange(Weapons[Index].ProjectileRadius, ProjectileRadiusMin, ProjectileRadiusMax, __FILENAME__, "Radius");
+
+					// Projectiles move once per game tick
+					Weapons[Index].ProjectileSpeed = Speed / static_cast<float>(FrameLock);
+					Weapons[Index].ProjectileLifeTime = LifeTime * static_cast<std::int_fast32_t>(FrameLock);
+					Weapons[Index].ProjectileColor = lwmf::ReadINIValueRGBA(INIFile, "PROJECTILECOLOR");
+				}
 				Weapons[Index].WeaponRect.X = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "POSITION", "PosX");
 				Weapons[Index].WeaponRect.Y = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "POSITION", "PosY");
 				Weapons[Index].FadeInOutSpeed = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "POSITION", "FadeInOutSpeed");
@@ -141,15 +181,6 @@ namespace Game_WeaponHandling
 				// pre-load weapon
 				Weapons[Index].LoadedRounds = Weapons[Index].Capacity;
 
-				// Initial built of ammo info HUD strings
-				std::array<char, MaximumAmmoCapacityDigits> CapacityString{};
-				std::to_chars(CapacityString.data(), CapacityString.data() + CapacityString.size(), Weapons[Index].Capacity);
-				Weapons[Index].HUDAmmoInfo = std::string(CapacityString.data()) + "/" + std::string(CapacityString.data());
-
-				std::array<char, MaximumCarriedAmmoDigits> CarriedAmmoString{};
-				std::to_chars(CarriedAmmoString.data(), CarriedAmmoString.data() + CarriedAmmoString.size(), Weapons[Index].CarriedAmmo);
-				Weapons[Index].HUDCarriedAmmoInfo = "Carried:" + std::string(CarriedAmmoString.data());
-
 				// Load Shader
 				Weapons[Index].WeaponShader.LoadShader("Default", Canvas);
 				Weapons[Index].MuzzleFlashShader.LoadShader("Default", Canvas);
@@ -171,6 +202,7 @@ namespace Game_WeaponHandling
 
 	inline void InitTextures()
 	{
+		// Queued only - the textures are in GPU RAM after the next Game_AssetLoader::Run()
 		NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Load weapon textures...");
 
 		for (auto&& Weapon : Weapons)
@@ -183,18 +215,13 @@ namespace Game_WeaponHandling
 
 			if (Tools_ErrorHandling::CheckFileExistence(WeaponTextureDataConfFile, StopOnError))
 			{
-				std::ifstream WeaponTexturesData(WeaponTextureDataConfFile, std::ios::in);
+				std::istringstream WeaponTexturesData(Tools_VFS::ReadText(WeaponTextureDataConfFile));
 
 				std::string Line;
 
 				while (std::getline(WeaponTexturesData, Line))
 				{
-					const lwmf::TextureStruct TempTextureWeapon{ GFX_ImageHandling::ImportImage(Line) };
-
-					Weapon.WeaponRect.Width = TempTextureWeapon.Width;
-					Weapon.WeaponRect.Height = TempTextureWeapon.Height;
-
-					Weapon.WeaponShader.LoadTextureInGPU(TempTextureWeapon, &Weapon.WeaponShader.OGLTextureID);
+					Game_AssetLoader::AddUploadJob(Line, [&Weapon](const lwmf::TextureStruct& Texture) { Weapon.WeaponRect.Width = Texture.Width; Weapon.WeaponRect.Height = Texture.Height; Weapon.WeaponShader.LoadTextureInGPU(Texture, &Weapon.WeaponShader.OGLTextureID); });
 				}
 			}
 
@@ -206,18 +233,13 @@ namespace Game_WeaponHandling
 
 			if (Tools_ErrorHandling::CheckFileExistence(MuzzleFlashTextureDataConfFile, StopOnError))
 			{
-				std::ifstream MuzzleFlashTextureData(MuzzleFlashTextureDataConfFile, std::ios::in);
+				std::istringstream MuzzleFlashTextureData(Tools_VFS::ReadText(MuzzleFlashTextureDataConfFile));
 
 				std::string Line;
 
 				while (std::getline(MuzzleFlashTextureData, Line))
 				{
-					const lwmf::TextureStruct TempTextureMuzzleFlash{ GFX_ImageHandling::ImportImage(Line) };
-
-					Weapon.MuzzleFlashRect.Width = TempTextureMuzzleFlash.Width;
-					Weapon.MuzzleFlashRect.Height = TempTextureMuzzleFlash.Height;
-
-					Weapon.MuzzleFlashShader.LoadTextureInGPU(TempTextureMuzzleFlash, &Weapon.MuzzleFlashShader.OGLTextureID);
+					Game_AssetLoader::AddUploadJob(Line, [&Weapon](const lwmf::TextureStruct& Texture) { Weapon.MuzzleFlashRect.Width = Texture.Width; Weapon.MuzzleFlashRect.Height = Texture.Height; Weapon.MuzzleFlashShader.LoadTextureInGPU(Texture, &Weapon.MuzzleFlashShader.OGLTextureID); });
 				}
 			}
 		}
@@ -260,107 +282,64 @@ namespace Game_WeaponHandling
 		if (Weapons[Player.SelectedWeapon].Type == static_cast<std::int_fast32_t>(WeaponType::DirectHit))
 		{
 			//
-			// Follow a ray to the middle of the screen (=center of crosshair) to check if part of entity was hit
+			// All pellets of the shot as one batch - every pellet hits the nearest opaque entity in front of the next wall
 			//
-			// Re-use code from CastGraphics and RenderEntities
-			// but deleted anything used for drawing lines...
-			//
-
-			const float Camera{ (Canvas.WidthMid << 1) / static_cast<float>(Canvas.Width) - 1 };
-			const lwmf::FloatPointStruct RayDir{ Player.Dir.X + Plane.X * Camera , Player.Dir.Y + Plane.Y * Camera };
-			lwmf::FloatPointStruct MapPos{ std::floorf(Player.Pos.X), std::floorf(Player.Pos.Y) };
-			const lwmf::FloatPointStruct DeltaDist{ std::fabs(1.0F / RayDir.X), std::fabs(1.0F / RayDir.Y) };
-			lwmf::FloatPointStruct SideDist{};
-			lwmf::FloatPointStruct Step{};
-
-			RayDir.X < 0.0F ? (Step.X = -1.0F, SideDist.X = (Player.Pos.X - MapPos.X) * DeltaDist.X) : (Step.X = 1.0F, SideDist.X = (MapPos.X + 1.0F - Player.Pos.X) * DeltaDist.X);
-			RayDir.Y < 0.0F ? (Step.Y = -1.0F, SideDist.Y = (Player.Pos.Y - MapPos.Y) * DeltaDist.Y) : (Step.Y = 1.0F, SideDist.Y = (MapPos.Y + 1.0F - Player.Pos.Y) * DeltaDist.Y);
 
-			bool Endloop{};
+			Game_Hitscan::SpreadRays(Weapons[Player.SelectedWeapon].Pellets, Weapons[Player.SelectedWeapon].Spread, ShotRays);
+			Game_Hitscan::CastRays(ShotRays, ShotHits);
 
-			while (!Endloop)
+			for (const auto& Hit : ShotHits)
 			{
-				SideDist.X < SideDist.Y ? (SideDist.X += DeltaDist.X, MapPos.X += Step.X) : (SideDist.Y += DeltaDist.Y, MapPos.Y += Step.Y);
-
-				// If wall was hit and no entity -> end while loop
-				if (Game_LevelHandling::LevelMap[static_cast<std::int_fast32_t>(Game_LevelHandling::LevelMapLayers::Wall)][static_cast<std::int_fast32_t>(MapPos.X)][static_cast<std::int_fast32_t>(MapPos.Y)] > 0)
+				if (Hit.EntityNumber != -1)
 				{
-					Endloop = true;
+					Game_EntityHandling::HandleEntityHit(Hit.EntityNumber, Weapons[Player.SelectedWeapon].Damage);
 				}
+			}
+		}
+		else if (Weapons[Player.SelectedWeapon].Type == static_cast<std::int_fast32_t>(WeaponType::Projectile))
+		{
+			//
+			// One projectile per pellet, flying along the same spread rays as a hitscan shot
+			//
 
-				//
-				// No wall was hit in this step, so check for entity
-				//
+			const WeaponStruct& SelectedWeapon{ Weapons[Player.SelectedWeapon] };
 
-				if (!Endloop)
-				{
-					const float InverseMatrix{ 1.0F / (Plane.X * Player.Dir.Y - Player.Dir.X * Plane.Y) };
-					const std::int_fast32_t NumberOfEntities{ static_cast<std::int_fast32_t>(Entities.size()) };
+			Game_Hitscan::SpreadRays(SelectedWeapon.Pellets, SelectedWeapon.Spread, ShotRays);
 
-					for (std::int_fast32_t Index{}; Index < NumberOfEntities; ++Index)
-					{
-						if (!Entities[Game_EntityHandling::EntityOrder[Index].first].IsDead && !Endloop)
-						{
-							const std::int_fast32_t TextureIndex{ Game_EntityHandling::GetEntityTextureIndex(Index) };
-							const lwmf::FloatPointStruct EntityPos{ Entities[Game_EntityHandling::EntityOrder[Index].first].Pos.X - Player.Pos.X, Entities[Game_EntityHandling::EntityOrder[Index].first].Pos.Y - Player.Pos.Y };
-							const float TransY{ InverseMatrix * (-Plane.Y * EntityPos.X + Plane.X * EntityPos.Y) };
-							const std::int_fast32_t vScreen{ static_cast<std::int_fast32_t>(Entities[Game_EntityHandling::EntityOrder[Index].first].MoveV / TransY) };
-							const std::int_fast32_t EntitySizeTemp{ static_cast<std::int_fast32_t>(Canvas.Height / TransY) };
-							const std::int_fast32_t EntitySX{ static_cast<std::int_fast32_t>(Canvas.WidthMid * (1.0F + InverseMatrix * (Player.Dir.Y * EntityPos.X - Player.Dir.X * EntityPos.Y) / TransY)) };
-							const std::int_fast32_t LineEndX{ std::min((EntitySizeTemp >> 1) + EntitySX, Canvas.Width) };
-							const std::int_fast32_t TextureY{ (((((Canvas.HeightMid - vScreen) << 8) - ((Canvas.Height + VerticalLook) << 7) + (EntitySizeTemp << 7)) * EntitySize) / EntitySizeTemp) >> 8 };
-
-							for (std::int_fast32_t x{ -(EntitySizeTemp >> 1) + EntitySX }; x < LineEndX; ++x)
-							{
-								// Only check if x = center of crosshair and if entity is in line of view
-								// Check if entity was hit in colored area
-
-								const std::int_fast32_t TextureX{ ((x - ((-EntitySizeTemp >> 1) + EntitySX)) * EntitySize / EntitySizeTemp) };
-
-								if ((x == Canvas.WidthMid && TransY < Game_EntityHandling::ZBuffer[x]) &&
-									((EntityAssets[Entities[Entities[Game_EntityHandling::EntityOrder[Index].first].Number].TypeNumber].WalkingTextures[TextureIndex][Entities[Game_EntityHandling::EntityOrder[Index].first].WalkAnimStep].Pixels[TextureY * TextureSize + TextureX] & lwmf::AMask) != 0))
-								{
-									Game_EntityHandling::HandleEntityHit(Entities[Entities[Game_EntityHandling::EntityOrder[Index].first].Number]);
-
-									// Shot found its way, end loop
-									Endloop = true;
-									break;
-								}
-							}
-						}
-					}
-				}
+			for (const auto& Ray : ShotRays)
+			{
+				const lwmf::FloatPointStruct RayDir{ Player.Dir.X + Plane.X * Ray.CameraX, Player.Dir.Y + Plane.Y * Ray.CameraX };
+				const float Speed{ SelectedWeapon.ProjectileSpeed / std::sqrt(RayDir.X * RayDir.X + RayDir.Y * RayDir.Y) };
+
+				Game_Projectiles::Spawn(Player.Pos, { RayDir.X * Speed, RayDir.Y * Speed }, SelectedWeapon.ProjectileRadius, SelectedWeapon.ProjectileColor, SelectedWeapon.Damage, SelectedWeapon.ProjectileLifeTime);
 			}
 		}
 	}
 
 	inline void HandleAmmoBoxPickup()
 	{
-		if (Game_EntityHandling::EntityMap[static_cast<std::int_fast32_t>(Player.Pos.X)][static_cast<std::int_fast32_t>(Player.Pos.Y)] == EntityTypes::AmmoBox)
+		for (std::int_fast32_t Number{ Game_SpatialIndex::FirstInCell(static_cast<std::int_fast32_t>(Player.Pos.X), static_cast<std::int_fast32_t>(Player.Pos.Y)) }; Number != -1; Number = Game_SpatialIndex::NextInCell[Number])
 		{
-			for (auto&& Entity : Entities)
+			if (EntityStateComponent& State{ Entities.State[Number] }; State.Type == EntityTypes::AmmoBox)
 			{
-				if (Entity.Type == EntityTypes::AmmoBox && static_cast<std::int_fast32_t>(Player.Pos.X) == static_cast<std::int_fast32_t>(Entity.Pos.X) && static_cast<std::int_fast32_t>(Player.Pos.Y) == static_cast<std::int_fast32_t>(Entity.Pos.Y))
-				{
-					Game_EntityHandling::PlayAudio(Entity.TypeNumber, Game_EntityHandling::EntitySounds::AmmoBoxPickup);
-					Entity.IsDead = true;
-					Entity.IsPickedUp = true;
+				Game_EntityHandling::PlayAudio(State.TypeNumber, Game_EntityHandling::EntitySounds::AmmoBoxPickup);
+				State.IsDead = true;
+				State.IsPickedUp = true;
+				Game_SpatialIndex::Remove(Number);
 
-					for (auto&& Weapon : Weapons)
+				for (auto&& Weapon : Weapons)
+				{
+					if (const auto WP{ Entities.Info[Number].ContainedItem.find(Weapon.Name) }; Weapon.Name == WP->first)
 					{
-						if (const auto WP{ Entity.ContainedItem.find(Weapon.Name) }; Weapon.Name == WP->first)
-						{
-							Weapon.CarriedAmmo += WP->second;
-							std::array<char, MaximumCarriedAmmoDigits> CarriedAmmoString{};
-							std::to_chars(CarriedAmmoString.data(), CarriedAmmoString.data() + CarriedAmmoString.size(), Weapon.CarriedAmmo);
-							Weapon.HUDCarriedAmmoInfo = "Carried:" + std::string(CarriedAmmoString.data());
-
-							break;
-						}
-					}
+						Weapon.CarriedAmmo += WP->second;
 
-					break;
+						break;
+					}
 				}
+
+				// Picked up - the slot goes back to the pool
+				Entities.Destroy(Number);
+				break;
 			}
 		}
 	}
@@ -391,9 +370,9 @@ namespace Game_WeaponHandling
 		if (CurrentFiringState == FiringState::None && CurrentWeaponState == WeaponState::Ready)
 		{
 			// Is reload currently not initiated and is there carried ammo left?
-			if (Weapons[Player.SelectedWeapon].ReloadCounter == 0 && Weapons[Player.SelectedWeapon].CarriedAmmo > 0)
+			if (!Game_TimingWheel::IsPending(Weapons[Player.SelectedWeapon].ReloadTimer) && Weapons[Player.SelectedWeapon].CarriedAmmo > 0)
 			{
-				Weapons[Player.SelectedWeapon].ReloadCounter = Weapons[Player.SelectedWeapon].ReloadDuration;
+				Weapons[Player.SelectedWeapon].ReloadTimer = Game_TimingWheel::Schedule(Weapons[Player.SelectedWeapon].ReloadDuration, &FinishReload);
 				CurrentWeaponState = WeaponState::ReloadInitiated;
 				PlayAudio(Player.SelectedWeapon, WeaponsSounds::Reload);
 			}
@@ -421,15 +400,23 @@ namespace Game_WeaponHandling
 		if (CurrentFiringState == FiringState::SingleShot || CurrentFiringState == FiringState::RapidFire)
 		{
 			// Is weapon loaded and ready?
-			if (Weapons[Player.SelectedWeapon].LoadedRounds > 0 && Weapons[Player.SelectedWeapon].CadenceCounter <= 0)
+			if (Weapons[Player.SelectedWeapon].LoadedRounds > 0 && !Game_TimingWheel::IsPending(Weapons[Player.SelectedWeapon].CadenceTimer))
 			{
-				Weapons[Player.SelectedWeapon].CadenceCounter = (3600 / Weapons[Player.SelectedWeapon].Cadence) ;
+				// Nothing to do when the timer fires - the weapon is ready again as soon as it is no longer pending
+				Weapons[Player.SelectedWeapon].CadenceTimer = Game_TimingWheel::Schedule(3600 / Weapons[Player.SelectedWeapon].Cadence, nullptr);
 
 				PlayAudio(Player.SelectedWeapon, WeaponsSounds::Shot);
 
+				// Shots are noise - entities within hearing distance wake up
+				Game_EntityHandling::WakeEntities(Player.Pos);
+
 				// Set flag and duration for rendering muzzleflash (used in DrawPlayerWeapon)
 				WeaponMuzzleFlashFlag = true;
-				Weapons[Player.SelectedWeapon].MuzzleFlashCounter = Weapons[Player.SelectedWeapon].MuzzleFlashDuration;
+				Game_TimingWheel::Cancel(MuzzleFlashTimer);
+				MuzzleFlashTimer = Game_TimingWheel::Schedule(Weapons[Player.SelectedWeapon].MuzzleFlashDuration, []
+				{
+					WeaponMuzzleFlashFlag = false;
+				});
 
 				--Weapons[Player.SelectedWeapon].LoadedRounds;
 
@@ -443,55 +430,32 @@ namespace Game_WeaponHandling
 			}
 		}
 
-		// Build ammo info HUD string
-		Weapons[Player.SelectedWeapon].LoadedRounds < 10 ? Weapons[Player.SelectedWeapon].HUDAmmoInfo = "0" + std::to_string(Weapons[Player.SelectedWeapon].LoadedRounds) + "/" + std::to_string(Weapons[Player.SelectedWeapon].Capacity) :
-			Weapons[Player.SelectedWeapon].HUDAmmoInfo = std::to_string(Weapons[Player.SelectedWeapon].LoadedRounds) + "/" + std::to_string(Weapons[Player.SelectedWeapon].Capacity);
-
 		if (CurrentFiringState == FiringState::SingleShot)
 		{
 			CurrentFiringState = FiringState::None;
 		}
 	}
 
-	inline void CheckReloadStatus()
+	inline void FinishReload()
 	{
+		// Called by the reload timer - reload weapon and calculate remaining ammo
 		if (CurrentWeaponState == WeaponState::ReloadInitiated)
 		{
-			// Is counter still running?
-			if (Weapons[Player.SelectedWeapon].ReloadCounter > 0)
+			// More ammo than needed?
+			if (const std::int_fast32_t TempAmmo{ Weapons[Player.SelectedWeapon].Capacity - Weapons[Player.SelectedWeapon].LoadedRounds }; Weapons[Player.SelectedWeapon].CarriedAmmo >= TempAmmo)
 			{
-				--Weapons[Player.SelectedWeapon].ReloadCounter;
+				Weapons[Player.SelectedWeapon].LoadedRounds += TempAmmo;
+				Weapons[Player.SelectedWeapon].CarriedAmmo -= TempAmmo;
 			}
-			// Counter is finished, reload weapon and calculate remaining ammo
+			// Not enough ammo to fill magazine completely?
 			else
 			{
-				// More ammo than needed?
-				if (const std::int_fast32_t TempAmmo{ Weapons[Player.SelectedWeapon].Capacity - Weapons[Player.SelectedWeapon].LoadedRounds }; Weapons[Player.SelectedWeapon].CarriedAmmo >= TempAmmo)
-				{
-					Weapons[Player.SelectedWeapon].LoadedRounds += TempAmmo;
-					Weapons[Player.SelectedWeapon].CarriedAmmo -= TempAmmo;
-				}
-				// Not enough ammo to fill magazine completely?
-				else
-				{
-					Weapons[Player.SelectedWeapon].LoadedRounds += Weapons[Player.SelectedWeapon].CarriedAmmo;
-					Weapons[Player.SelectedWeapon].CarriedAmmo = 0;
-				}
-
-				// Update HUD informations
-				std::array<char, MaximumLoadedRoundsDigits> LoadedRoundsString{};
-				std::to_chars(LoadedRoundsString.data(), LoadedRoundsString.data() + LoadedRoundsString.size(), Weapons[Player.SelectedWeapon].LoadedRounds);
-				std::array<char, MaximumAmmoCapacityDigits> CapacityString{};
-				std::to_chars(CapacityString.data(), CapacityString.data() + CapacityString.size(), Weapons[Player.SelectedWeapon].Capacity);
-				Weapons[Player.SelectedWeapon].HUDAmmoInfo = std::string(LoadedRoundsString.data()) + "/" + std::string(CapacityString.data());
-
-				std::array<char, MaximumCarriedAmmoDigits> CarriedAmmoString{};
-				std::to_chars(CarriedAmmoString.data(), CarriedAmmoString.data() + CarriedAmmoString.size(), Weapons[Player.SelectedWeapon].CarriedAmmo);
-				Weapons[Player.SelectedWeapon].HUDCarriedAmmoInfo = "Carried:" + std::string(CarriedAmmoString.data());
-
-				// Reloading is finished
-				CurrentWeaponState = WeaponState::Ready;
+				Weapons[Player.SelectedWeapon].LoadedRounds += Weapons[Player.SelectedWeapon].CarriedAmmo;
+				Weapons[Player.SelectedWeapon].CarriedAmmo = 0;
 			}
+
+			// Reloading is finished
+			CurrentWeaponState = WeaponState::Ready;
 		}
 	}
 
@@ -534,22 +498,6 @@ namespace Game_WeaponHandling
 		}
 	}
 
-	inline void CountdownMuzzleFlashCounter()
-	{
-		if (--Weapons[Player.SelectedWeapon].MuzzleFlashCounter == 0)
-		{
-			WeaponMuzzleFlashFlag = false;
-		}
-	}
-
-	inline void CountdownCadenceCounter()
-	{
-		if (Weapons[Player.SelectedWeapon].CadenceCounter > 0)
-		{
-			--Weapons[Player.SelectedWeapon].CadenceCounter;
-		}
-	}
-
 	inline void DrawWeapon()
 	{
 		const float PaceWeightProduct{ WeaponPace * Weapons[Player.SelectedWeapon].Weight };
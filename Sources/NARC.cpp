@@ -17,6 +17,7 @@
 #include <cstdint>
 #include <cmath>
 #include <chrono>
+#include <string_view>
 
 // Uncomment to find memory leaks in debug mode
 //
@@ -43,9 +44,13 @@ lwmf::Logging NARCLog("NARC.log");
 inline lwmf::TextureStruct Canvas{};
 inline lwmf::ShaderClass CanvasShader{};
 
+// Threadpool is used by the renderer, the path service and at level load
+inline lwmf::Multithreading ThreadPool{};
+
 #include "Game_Folder.hpp"
 #include "Game_GlobalDefinitions.hpp"
 #include "Tools_Console.hpp"
+#include "Tools_VFS.hpp"
 #include "Tools_ErrorHandling.hpp"
 #include "GFX_ImageHandling.hpp"
 #include "GFX_Window.hpp"
@@ -63,20 +68,32 @@ inline lwmf::ShaderClass CanvasShader{};
 #include "Game_DataStructures.hpp"
 #include "Game_PreGame.hpp"
 #include "Game_Config.hpp"
+#include "Game_TextureCache.hpp"
+#include "Game_AssetLoader.hpp"
+#include "Game_BakedLevel.hpp"
 #include "Game_LevelHandling.hpp"
 #include "Game_SkyboxHandling.hpp"
 #include "Game_PathFinding.hpp"
+#include "Game_PathService.hpp"
+#include "Game_Visibility.hpp"
+#include "Game_SpatialIndex.hpp"
+#include "Game_TimingWheel.hpp"
 #include "Game_EntityHandling.hpp"
 #include "Game_Effects.hpp"
 #include "Game_Doors.hpp"
+#include "Game_Projectiles.hpp"
 #include "Game_WeaponHandling.hpp"
 #include "Game_HealthBarClass.hpp"
+#include "Game_FPSDisplayClass.hpp"
 #include "Game_MinimapClass.hpp"
 #include "Game_WeaponDisplayClass.hpp"
 #include "Game_Transitions.hpp"
 #include "Game_MenuClass.hpp"
 #include "Game_Raycaster.hpp"
 #include "Tools_Cleanup.hpp"
+#include "Tools_Benchmark.hpp"
+#include "Tools_LevelBaker.hpp"
+#include "Tools_PackBuilder.hpp"
 
 //
 // Declare functions
@@ -86,25 +103,42 @@ void InitAndLoadGameConfig();
 void InitAndLoadLevel();
 void MovePlayerAndCheckCollision();
 void ControlPlayerMovement();
+void RunBenchmark();
 
 // Init objects
 inline Game_MenuClass MainMenu;
 inline Game_HealthBarClass HUDHealthBar;
 inline Game_MinimapClass HUDMinimap;
 inline Game_WeaponDisplayClass HUDWeaponDisplay;
+inline Game_FPSDisplayClass HUDFPSDisplay;
 
 inline bool HUDEnabled{ true };
 
 std::int_fast32_t WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _In_ LPSTR lpCmdLine, _In_ int nShowCmd)
 {
 	UNREFERENCED_PARAMETER(hPrevInstance);
-	UNREFERENCED_PARAMETER(lpCmdLine);
 	UNREFERENCED_PARAMETER(nShowCmd);
 
 	lwmf::WindowInstance = hInstance;
 
 	try
 	{
+		// Offline mode - bake all levels into the binary level container and quit
+		if (std::string_view(lpCmdLine) == "-bakelevels")
+		{
+			Game_Config::Init();
+			Game_Config::GatherNumberOfLevels();
+			return Tools_LevelBaker::BakeLevels() ? EXIT_SUCCESS : EXIT_FAILURE;
+		}
+
+		// Offline mode - pack all game files into the pack archive and quit
+		if (std::string_view(lpCmdLine) == "-buildpack")
+		{
+			return Tools_PackBuilder::BuildPack() ? EXIT_SUCCESS : EXIT_FAILURE;
+		}
+
+		// Both offline modes above work on the loose files - the game reads the pack archive, if there is one
+		Tools_VFS::Init();
 		InitAndLoadGameConfig();
 		InitAndLoadLevel();
 	}
@@ -113,11 +147,14 @@ std::int_fast32_t WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInst
 		return EXIT_FAILURE;
 	}
 
-	NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Init multithreading threadpool...");
-	lwmf::Multithreading ThreadPool;
+	// Benchmark mode runs its fixed workload, writes the report and skips the game loop
+	if (Tools_Benchmark::Enabled)
+	{
+		RunBenchmark();
+		QuitGameFlag = true;
+	}
 
 	const std::int_fast32_t BlackNoAlpha{ lwmf::RGBAtoINT(0, 0, 0, 0) };
-	const std::int_fast32_t White{ lwmf::RGBAtoINT(255, 255, 255, 255) };
 
 	// Main game loop
 	// fixed timestep method
@@ -160,28 +197,25 @@ std::int_fast32_t WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInst
 		{
 			if (!GamePausedFlag)
 			{
+				// Fires all timers which are due this tick (reload, muzzle flash, bloodstain, hit animations...)
+				Game_TimingWheel::Advance();
+				Game_PathService::ApplyResults();
 				ControlPlayerMovement();
+				Game_Visibility::Update();
 				Game_EntityHandling::MoveEntities();
+				Game_Projectiles::Update();
 				Game_Doors::OpenCloseDoors();
 				Game_WeaponHandling::ChangeWeapon();
-				Game_WeaponHandling::CheckReloadStatus();
-				Game_WeaponHandling::CountdownMuzzleFlashCounter();
-				Game_WeaponHandling::CountdownCadenceCounter();
-				Game_Effects::CountdownBloodstainCounter();
+				Game_PathService::DispatchRequests(ThreadPool);
 			}
 
 			Lag -= LengthOfFrame;
 		}
 
-		Game_EntityHandling::GetEntityDistance();
-
-		// Sort entities front to back for check if weapon hit first entity in front of player
-		SortEntities(Game_EntityHandling::SortOrder::FrontToBack);
+		// Entities are sorted front to back - weapon hit check walks the order forwards, rendering backwards
+		Game_EntityHandling::UpdateDepthOrder();
 		Game_WeaponHandling::FireWeapon();
 
-		// Sort entities back to front to draw them in right order
-		SortEntities(Game_EntityHandling::SortOrder::BackToFront);
-
 		lwmf::ClearTexture(Canvas, BlackNoAlpha);
 		lwmf::FPSCounter();
 
@@ -191,12 +225,13 @@ std::int_fast32_t WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInst
 		ThreadPool.AddThread(&Game_Raycaster::CastGraphics, Game_Raycaster::Renderpart::Ceiling);
 		ThreadPool.WaitForThreads();
 
-		Game_EntityHandling::RenderEntities();
+		Game_Projectiles::RenderSprites();
 
 		if (HUDEnabled)
 		{
+			// Retained layers - redrawn only when their values change, blitted into the canvas
 			HUDHealthBar.Display();
-			lwmf::DisplayFPSCounter(Canvas, Canvas.Width - 70, 7, White);
+			HUDFPSDisplay.Display();
 		}
 
 		if (Player.IsDead && !GamePausedFlag)
@@ -210,6 +245,8 @@ std::int_fast32_t WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInst
 
 		if (HUDMinimap.Enabled)
 		{
+			HUDMinimap.RefreshFogOfWar();
+
 			// Display realtime data (entities, waypoints etc.)
 			HUDMinimap.DisplayRealtimeMap();
 		}
@@ -245,8 +282,14 @@ std::int_fast32_t WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInst
 
 	// Cleanup everything and exit the program...
 
+	Game_PathService::Reset();
 	Tools_Cleanup::CloseAllAudio();
-	Tools_Cleanup::DestroySubsystems();
+
+	if (!Headless)
+	{
+		Tools_Cleanup::DestroySubsystems();
+	}
+
 	NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Exit program...");
 
 	// Uncomment to find memory leaks in debug mode
@@ -622,61 +665,117 @@ inline void InitAndLoadGameConfig()
 	lwmf::CheckForSSESupport();
 	Game_Config::Init();
 	Game_Config::GatherNumberOfLevels();
+	Tools_Benchmark::Init();
 
-	Tools_Console::CreateConsole();
-	Game_PreGame::ShowIntroHeader();
-	Game_PreGame::SetOptions();
-	Tools_Console::CloseConsole();
+	if (Tools_Benchmark::Enabled)
+	{
+		SelectedLevel = Tools_Benchmark::Level;
+		Headless = true;
+	}
+	else
+	{
+		Tools_Console::CreateConsole();
+		Game_PreGame::ShowIntroHeader();
+		Game_PreGame::SetOptions();
+		Tools_Console::CloseConsole();
+	}
 
 	GFX_Window::Init();
-	HID_Keyboard::Init();
-	HID_Mouse::Init();
-	HID_Gamepad::Init();
-	MainMenu.Init();
-	Game_Transitions::Init();
-
 	Game_Raycaster::Init();
-	Game_WeaponHandling::InitConfig();
-	Game_WeaponHandling::InitTextures();
-	Game_WeaponHandling::InitAudio();
-	Game_Effects::InitEffects();
-	HUDWeaponDisplay.Init();
-	HUDHealthBar.Init();
+
+	// Headless runs need the simulation and the canvas only - no input, menus, weapons, HUD or skybox
+	if (!Headless)
+	{
+		HID_Keyboard::Init();
+		HID_Mouse::Init();
+		HID_Gamepad::Init();
+		MainMenu.Init();
+		Game_Transitions::Init();
+
+		Game_WeaponHandling::InitConfig();
+		Game_WeaponHandling::InitTextures();
+		Game_WeaponHandling::InitAudio();
+		Game_Effects::InitEffects();
+		HUDWeaponDisplay.Init();
+		HUDHealthBar.Init();
+		HUDFPSDisplay.Init();
+		Game_SkyboxHandling::Init();
+	}
+
 	HUDMinimap.Init();
-	Game_SkyboxHandling::Init();
 	Game_Doors::InitDoorAssets();
+	// Barrier: weapon and door textures
+	Game_AssetLoader::Run("game assets");
+	Game_PathService::Init();
+	Game_Visibility::Init();
+
+	// Doors which opened or closed change the walkable cells and what can be seen
+	Game_Doors::Subscribe([](const DoorStruct& Door, const Game_Doors::DoorEvents Event) { Game_PathService::SetCellCost(Game_Doors::GetDoorCell(Door), Event == Game_Doors::DoorEvents::Opened ? 1.0F : FLT_MAX); });
+	Game_Doors::Subscribe([](const DoorStruct&, Game_Doors::DoorEvents) { Game_Visibility::Invalidate(); });
+
+	Game_TimingWheel::Reset();
 }
 
 inline void InitAndLoadLevel()
 {
-	Game_Transitions::LevelTransition();
+	// Running path jobs read level data - let them finish first
+	Game_PathService::Reset();
+
+	// Timers of the previous level (door stay-open times, entity hit animations...) are dropped
+	// Reload, muzzle flash and bloodstain are finished here, since their callbacks will not fire anymore
+	Game_WeaponHandling::FinishReload();
+	Game_WeaponHandling::WeaponMuzzleFlashFlag = false;
+	Game_Effects::BloodstainFlag = false;
+	Game_TimingWheel::Reset();
+
+	if (!Headless)
+	{
+		Game_Transitions::LevelTransition();
+	}
+
 	Game_LevelHandling::InitConfig();
+	// Map, lights, textures and entities come from the baked level if there is an up to date one
+	Game_BakedLevel::Open(SelectedLevel);
 	Game_LevelHandling::InitMapData();
 	Game_LevelHandling::InitLights();
 	Game_LevelHandling::InitTextures();
 	Game_LevelHandling::InitBackgroundMusic();
 
+	Game_Doors::InitDoors();
+
+	// Generated after the doors are placed, so closed doors are not walkable
 	Game_PathFinding::GenerateFlattenedMap(Game_PathFinding::FlattenedMap, Game_LevelHandling::LevelMapWidth, Game_LevelHandling::LevelMapHeight);
+	Game_PathFinding::BuildHierarchy(Game_PathFinding::FlattenedMap, Game_LevelHandling::LevelMapWidth, Game_LevelHandling::LevelMapHeight);
+	Game_PathFinding::BuildNextHopTables(Game_PathFinding::FlattenedMap, Game_LevelHandling::LevelMapWidth, Game_LevelHandling::LevelMapHeight, Game_Doors::GatherDoorIndices());
+
+	Game_Visibility::Reset();
+
+	if (!Headless)
+	{
+		Game_SkyboxHandling::LoadSkyboxImage();
+	}
 
-	Game_Doors::InitDoors();
-	Game_SkyboxHandling::LoadSkyboxImage();
 	HUDMinimap.PreRender();
 	Player.InitConfig();
 	Player.InitAudio();
 	Game_EntityHandling::InitEntityAssets();
+	// Barrier: level textures, skybox and entity animations - before the baked level is closed
+	Game_AssetLoader::Run("level assets");
+	// Textures of the previous level which are not used anymore stay cached as far as the budget allows
+	Game_TextureCache::Trim();
 	Game_EntityHandling::InitEntities();
+	Game_BakedLevel::Close();
+	Game_Projectiles::Reset();
 	Game_Raycaster::RefreshSettings();
 
-	Game_EntityHandling::EntityMap[static_cast<std::int_fast32_t>(Player.Pos.X)][static_cast<std::int_fast32_t>(Player.Pos.Y)] = EntityTypes::Player;
+	Game_SpatialIndex::SetPlayerPosition(Player.Pos);
 }
 
 inline void MovePlayerAndCheckCollision()
 {
 	if (Game_LevelHandling::LevelMap[static_cast<std::int_fast32_t>(Game_LevelHandling::LevelMapLayers::Wall)][Player.FuturePos.X][static_cast<std::int_fast32_t>(Player.Pos.Y)] == 0
 		&& Game_LevelHandling::LevelMap[static_cast<std::int_fast32_t>(Game_LevelHandling::LevelMapLayers::Wall)][static_cast<std::int_fast32_t>(Player.Pos.X)][Player.FuturePos.Y] == 0
-		&& Game_EntityHandling::EntityMap[Player.FuturePos.X][Player.FuturePos.Y] != EntityTypes::Enemy
-		&& Game_EntityHandling::EntityMap[Player.FuturePos.X][Player.FuturePos.Y] != EntityTypes::Neutral
-		&& Game_EntityHandling::EntityMap[Player.FuturePos.X][Player.FuturePos.Y] != EntityTypes::Turret)
+		&& !Game_SpatialIndex::IsBlocked(Player.FuturePos.X, Player.FuturePos.Y, -1))
 	{
 		Player.Pos.X += Player.StepWidth.X;
 		Player.Pos.Y += Player.StepWidth.Y;
@@ -694,7 +793,6 @@ inline void MovePlayerAndCheckCollision()
 
 inline void ControlPlayerMovement()
 {
-	Game_EntityHandling::EntityMap[static_cast<std::int_fast32_t>(Player.Pos.X)][static_cast<std::int_fast32_t>(Player.Pos.Y)] = EntityTypes::Clear;
 	Game_WeaponHandling::WeaponPaceFlag = false;
 
 	if (GameControllerFlag && HID_Gamepad::GameController.ControllerID != -1)
@@ -796,5 +894,71 @@ inline void ControlPlayerMovement()
 		MovePlayerAndCheckCollision();
 	}
 
-	Game_EntityHandling::EntityMap[static_cast<std::int_fast32_t>(Player.Pos.X)][static_cast<std::int_fast32_t>(Player.Pos.Y)] = EntityTypes::Player;
+	Game_SpatialIndex::SetPlayerPosition(Player.Pos);
+}
+
+inline void RunBenchmark()
+{
+	NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Run benchmark...");
+
+	Tools_Benchmark::SpawnEntities();
+
+	// Simulation ticks - same order as in the game loop, without player input and weapons
+	// Path requests are dispatched right after the results of the previous tick are applied, which keeps the one tick latency of the game loop
+	for (std::int_fast32_t Tick{}; Tick < Tools_Benchmark::Ticks; ++Tick)
+	{
+		Tools_Benchmark::Measure(Tools_Benchmark::Sections::Tick, []
+		{
+			Game_TimingWheel::Advance();
+			Tools_Benchmark::Measure(Tools_Benchmark::Sections::PathService, []
+			{
+				Game_PathService::ApplyResults();
+				Game_PathService::DispatchRequests(ThreadPool);
+			});
+			Tools_Benchmark::Measure(Tools_Benchmark::Sections::Visibility, &Game_Visibility::Update);
+			Tools_Benchmark::Measure(Tools_Benchmark::Sections::MoveEntities, &Game_EntityHandling::MoveEntities);
+			Tools_Benchmark::Measure(Tools_Benchmark::Sections::Projectiles, &Game_Projectiles::Update);
+			Tools_Benchmark::Measure(Tools_Benchmark::Sections::Doors, &Game_Doors::OpenCloseDoors);
+		});
+	}
+
+	// Path searches - the ticks above only measure the dispatch, the jobs are solved in the background
+	Game_PathService::Reset();
+	Tools_Benchmark::SolvePaths();
+
+	// Rendered frames - drawn into the canvas but never presented
+	// The player turns once around per run, so every direction of the level is rendered
+	const float RotationStep{ Tools_Benchmark::Frames > 0 ? lwmf::DoublePI / static_cast<float>(Tools_Benchmark::Frames) : 0.0F };
+	const float StepCos{ std::cosf(RotationStep) };
+	const float StepSin{ std::sinf(RotationStep) };
+
+	for (std::int_fast32_t Frame{}; Frame < Tools_Benchmark::Frames; ++Frame)
+	{
+		Player.Dir = { Player.Dir.X * StepCos - Player.Dir.Y * StepSin, Player.Dir.X * StepSin + Player.Dir.Y * StepCos };
+		Plane = { Plane.X * StepCos - Plane.Y * StepSin, Plane.X * StepSin + Plane.Y * StepCos };
+
+		Tools_Benchmark::Measure(Tools_Benchmark::Sections::Frame, []
+		{
+			Tools_Benchmark::Measure(Tools_Benchmark::Sections::DepthOrder, &Game_EntityHandling::UpdateDepthOrder);
+
+			lwmf::ClearTexture(Canvas, 0);
+
+			Tools_Benchmark::Measure(Tools_Benchmark::Sections::Raycaster, []
+			{
+				ThreadPool.AddThread(&Game_Raycaster::CastGraphics, Game_Raycaster::Renderpart::WallLeft);
+				ThreadPool.AddThread(&Game_Raycaster::CastGraphics, Game_Raycaster::Renderpart::WalLRight);
+				ThreadPool.AddThread(&Game_Raycaster::CastGraphics, Game_Raycaster::Renderpart::Floor);
+				ThreadPool.AddThread(&Game_Raycaster::CastGraphics, Game_Raycaster::Renderpart::Ceiling);
+				ThreadPool.WaitForThreads();
+			});
+
+			Tools_Benchmark::Measure(Tools_Benchmark::Sections::RenderSprites, &Game_Projectiles::RenderSprites);
+			Tools_Benchmark::Measure(Tools_Benchmark::Sections::Minimap, []
+			{
+				HUDMinimap.DisplayRealtimeMap();
+			});
+		});
+	}
+
+	Tools_Benchmark::WriteReport();
 }
\ No newline at end of file
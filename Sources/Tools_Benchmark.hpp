@@ -0,0 +1,328 @@
+/*
+******************************************
+*                                        *
+* Tools_Benchmark.hpp                    *
+*                                        *
+* (c) 2017 - 2020 Stefan Kubsch          *
+******************************************
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <list>
+#include <array>
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+#include <cfloat>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+
+#include "Game_GlobalDefinitions.hpp"
+#include "Tools_ErrorHandling.hpp"
+#include "Game_DataStructures.hpp"
+#include "Game_LevelHandling.hpp"
+#include "Game_EntityHandling.hpp"
+#include "Game_SpatialIndex.hpp"
+#include "Game_PathFinding.hpp"
+
+namespace Tools_Benchmark
+{
+
+
+	//
+	// Entity stress test
+	//
+	// Enabled in BenchmarkConfig.ini - the game then skips the option dialog, loads the configured level,
+	// clones the level's enemies and turrets up to NumberOfEntities, runs a fixed number of simulation ticks, path searches and
+	// rendered frames, writes per-subsystem timings (mean and percentiles) to OutputFile and exits
+	// The run is headless - no window, no OpenGL context and no input, frames are drawn into the canvas only
+	//
+
+	enum class Sections : std::int_fast32_t
+	{
+		PathService,
+		Visibility,
+		MoveEntities,
+		Projectiles,
+		Doors,
+		Tick,
+		PathSolve,
+		DepthOrder,
+		Raycaster,
+		RenderSprites,
+		Minimap,
+		Frame
+	};
+
+	void Init();
+	void SpawnEntities();
+	void SolvePaths();
+	template<typename T>void Measure(Sections Section, T&& Function);
+	double Percentile(const std::vector<double>& SortedSamples, double Rank);
+	void WriteReport();
+
+	//
+	// Variables and constants
+	//
+
+	inline constexpr std::int_fast32_t NumberOfSections{ static_cast<std::int_fast32_t>(Sections::Frame) + 1 };
+	inline const std::array<std::string, NumberOfSections> SectionNames
+	{
+		"PathService", "Visibility", "MoveEntities", "Projectiles", "Doors", "Tick", "PathSolve", "DepthOrder", "Raycaster", "RenderSprites", "Minimap", "Frame"
+	};
+
+	inline constexpr std::int_fast32_t NumberOfEntitiesMin{ 100 };
+	inline constexpr std::int_fast32_t NumberOfEntitiesMax{ 10000 };
+	inline constexpr std::int_fast32_t TicksMin{ 1 };
+	inline constexpr std::int_fast32_t TicksMax{ 1000000 };
+	inline constexpr std::int_fast32_t FramesMin{ 0 };
+	inline constexpr std::int_fast32_t FramesMax{ 100000 };
+	inline constexpr std::int_fast32_t PathQueriesMin{ 0 };
+	inline constexpr std::int_fast32_t PathQueriesMax{ 100000 };
+
+	inline bool Enabled{};
+	inline std::int_fast32_t Level{ 1 };
+	inline std::int_fast32_t NumberOfEntities{ 1000 };
+	inline std::int_fast32_t Ticks{ 1000 };
+	inline std::int_fast32_t Frames{ 300 };
+	inline std::int_fast32_t PathQueries{ 1000 };
+	inline std::uint_fast32_t Seed{ 1 };
+	inline std::string OutputFile{ "Benchmark.csv" };
+	inline bool OutputJSON{};
+
+	// Samples in milliseconds, one vector per section
+	inline std::array<std::vector<double>, NumberOfSections> Samples{};
+
+	//
+	// Functions
+	//
+
+	inline void Init()
+	{
+		NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Init benchmark config...");
+
+		if (const std::string INIFile{ GameConfigFolder + "BenchmarkConfig.ini" }; Tools_ErrorHandling::CheckFileExistence(INIFile, ContinueOnError))
+		{
+			Enabled = lwmf::ReadINIValue<bool>(INIFile, "BENCHMARK", "Enabled");
+
+			if (!Enabled)
+			{
+				return;
+			}
+
+			Level = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "BENCHMARK", "Level");
+			NumberOfEntities = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "BENCHMARK", "NumberOfEntities");
+			Ticks = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "BENCHMARK", "Ticks");
+			Frames = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "BENCHMARK", "Frames");
+			PathQueries = lwmf::ReadINIValue<std::int_fast32_t>(INIFile, "BENCHMARK", "PathQueries");
+			Seed = lwmf::ReadINIValue<std::uint_fast32_t>(INIFile, "BENCHMARK", "Seed");
+			OutputFile = lwmf::ReadINIValue<std::string>(INIFile, "OUTPUT", "OutputFile");
+			OutputJSON = lwmf::ReadINIValue<std::string>(INIFile, "OUTPUT", "Format") == "JSON";
+
+			Tools_ErrorHandling::CheckAndClampRange(Level, StartLevel, std::max(NumberOfLevels, StartLevel), __FILENAME__, "Level");
+			Tools_ErrorHandling::CheckAndClampRange(NumberOfEntities, NumberOfEntitiesMin, NumberOfEntitiesMax, __FILENAME__, "NumberOfEntities");
+			Tools_ErrorHandling::CheckAndClampRange(Ticks, TicksMin, TicksMax, __FILENAME__, "Ticks");
+			Tools_ErrorHandling::CheckAndClampRange(Frames, FramesMin, FramesMax, __FILENAME__, "Frames");
+			Tools_ErrorHandling::CheckAndClampRange(PathQueries, PathQueriesMin, PathQueriesMax, __FILENAME__, "PathQueries");
+
+			for (auto&& Section : Samples)
+			{
+				Section.clear();
+				Section.reserve(static_cast<std::size_t>(std::max({ Ticks, Frames, PathQueries })));
+			}
+
+			NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Benchmark enabled: " + std::to_string(NumberOfEntities) + " entities, " + std::to_string(Ticks) + " ticks, " + std::to_string(PathQueries) + " path queries, " + std::to_string(Frames) + " frames.");
+		}
+	}
+
+	inline void SpawnEntities()
+	{
+		// Templates are the enemies and turrets the level was loaded with
+		std::vector<std::int_fast32_t> Templates{};
+
+		for (const EntityArchetypes Archetype : { EntityArchetypes::Mobile, EntityArchetypes::Turret })
+		{
+			const std::vector<std::int_fast32_t>& Members{ Entities.Archetypes[static_cast<std::int_fast32_t>(Archetype)] };
+			Templates.insert(Templates.end(), Members.begin(), Members.end());
+		}
+
+		std::sort(Templates.begin(), Templates.end());
+
+		if (Templates.empty())
+		{
+			NARCLog.AddEntry(lwmf::LogLevel::Warn, __FILENAME__, __LINE__, "SpawnEntities(): Level has no mobile entities or turrets to clone!");
+			return;
+		}
+
+		// Free floor cells - shuffled with a fixed seed, so every run places the same entities on the same cells
+		std::vector<lwmf::IntPointStruct> FreeCells{};
+
+		for (std::int_fast32_t y{}; y < Game_LevelHandling::LevelMapHeight; ++y)
+		{
+			for (std::int_fast32_t x{}; x < Game_LevelHandling::LevelMapWidth; ++x)
+			{
+				if (Game_LevelHandling::LevelMap[static_cast<std::int_fast32_t>(Game_LevelHandling::LevelMapLayers::Wall)][x][y] == 0
+					&& !Game_SpatialIndex::IsBlocked(x, y, -1) && !Game_SpatialIndex::IsPlayerCell(x, y))
+				{
+					FreeCells.push_back({ x, y });
+				}
+			}
+		}
+
+		lwmf::Xoshiro256 BenchmarkRNG(Seed, static_cast<std::uint64_t>(RandomSubsystems::Benchmark));
+		std::shuffle(FreeCells.begin(), FreeCells.end(), BenchmarkRNG);
+
+		const std::int_fast32_t NumberOfSpawns{ std::min(NumberOfEntities - static_cast<std::int_fast32_t>(Templates.size()), static_cast<std::int_fast32_t>(FreeCells.size())) };
+
+		if (NumberOfSpawns < NumberOfEntities - static_cast<std::int_fast32_t>(Templates.size()))
+		{
+			NARCLog.AddEntry(lwmf::LogLevel::Warn, __FILENAME__, __LINE__, "SpawnEntities(): Not enough free cells, spawning " + std::to_string(NumberOfSpawns) + " entities only!");
+		}
+
+		// All clones fit into the reserved pool, so spawning does not reallocate the entity table
+		Entities.Reserve(std::max(NumberOfEntities, Game_EntityHandling::EntityPoolCapacity));
+
+		for (std::int_fast32_t Index{}; Index < NumberOfSpawns; ++Index)
+		{
+			const std::int_fast32_t Template{ Templates[static_cast<std::size_t>(Index) % Templates.size()] };
+			const std::int_fast32_t Number{ Entities.Create(Entities.Archetype[Template]) };
+
+			Entities.Transform[Number] = Entities.Transform[Template];
+			Entities.State[Number] = Entities.State[Template];
+			Entities.Animation[Number] = Entities.Animation[Template];
+			Entities.Combat[Number] = Entities.Combat[Template];
+			Entities.LOD[Number] = Entities.LOD[Template];
+			Entities.Path[Number] = {};
+			Entities.Info[Number] = Entities.Info[Template];
+
+			// Cell centre, like the positions in the entity data files
+			Entities.Transform[Number].Pos = { static_cast<float>(FreeCells[Index].X) + 0.5F, static_cast<float>(FreeCells[Index].Y) + 0.5F };
+
+			Game_SpatialIndex::UpdateEntity(Number);
+		}
+
+		NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Benchmark entities spawned: " + std::to_string(Entities.Size()) + " in total.");
+	}
+
+	inline void SolvePaths()
+	{
+		// Synchronous searches on the game thread - the ticks measure the path service dispatch only, this measures the search itself
+		// Start and target are random walkable cells (fixed seed), searched the same way the path service workers do
+		std::vector<std::int_fast32_t> WalkableCells{};
+
+		for (std::int_fast32_t Index{}; Index < static_cast<std::int_fast32_t>(Game_PathFinding::FlattenedMap.size()); ++Index)
+		{
+			if (Game_PathFinding::FlattenedMap[Index] < FLT_MAX)
+			{
+				WalkableCells.push_back(Index);
+			}
+		}
+
+		if (WalkableCells.size() < 2)
+		{
+			NARCLog.AddEntry(lwmf::LogLevel::Warn, __FILENAME__, __LINE__, "SolvePaths(): Level has not enough walkable cells for path searches!");
+			return;
+		}
+
+		lwmf::Xoshiro256 PathRNG(Seed, static_cast<std::uint64_t>(RandomSubsystems::BenchmarkPaths));
+		std::list<lwmf::IntPointStruct> WayPoints{};
+		std::int_fast32_t PathsFound{};
+
+		for (std::int_fast32_t Query{}; Query < PathQueries; ++Query)
+		{
+			const std::int_fast32_t Start{ WalkableCells[static_cast<std::size_t>(PathRNG() % WalkableCells.size())] };
+			const std::int_fast32_t Target{ WalkableCells[static_cast<std::size_t>(PathRNG() % WalkableCells.size())] };
+
+			WayPoints.clear();
+
+			Measure(Sections::PathSolve, [&]
+			{
+				PathsFound += Game_PathFinding::CalculatePath(Game_PathFinding::FlattenedMap, Game_LevelHandling::LevelMapWidth, Game_LevelHandling::LevelMapHeight, Start, Target, false, Game_PathFinding::PathModes::Accelerated, WayPoints) ? 1 : 0;
+			});
+		}
+
+		NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Benchmark path searches: " + std::to_string(PathsFound) + " of " + std::to_string(PathQueries) + " found a path.");
+	}
+
+	template<typename T>void Measure(const Sections Section, T&& Function)
+	{
+		const auto StartTime{ std::chrono::steady_clock::now() };
+		Function();
+		Samples[static_cast<std::int_fast32_t>(Section)].emplace_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - StartTime).count());
+	}
+
+	inline double Percentile(const std::vector<double>& SortedSamples, const double Rank)
+	{
+		// Nearest rank
+		const std::size_t Index{ static_cast<std::size_t>(std::ceil(Rank / 100.0 * static_cast<double>(SortedSamples.size()))) };
+		return SortedSamples[std::clamp(Index, static_cast<std::size_t>(1), SortedSamples.size()) - 1];
+	}
+
+	inline void WriteReport()
+	{
+		NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Write benchmark report " + OutputFile + "...");
+
+		std::ostringstream Report{};
+		Report << std::fixed << std::setprecision(4);
+
+		if (OutputJSON)
+		{
+			Report << "{\n\t\"Level\": " << Level << ",\n\t\"Entities\": " << Entities.Size() << ",\n\t\"Ticks\": " << Ticks << ",\n\t\"PathQueries\": " << PathQueries << ",\n\t\"Frames\": " << Frames << ",\n\t\"Sections\": [";
+		}
+		else
+		{
+			Report << "Section,Samples,MeanMs,P50Ms,P95Ms,P99Ms,MaxMs\n";
+		}
+
+		bool FirstSection{ true };
+
+		for (std::int_fast32_t Index{}; Index < NumberOfSections; ++Index)
+		{
+			std::vector<double> Sorted{ Samples[Index] };
+
+			if (Sorted.empty())
+			{
+				continue;
+			}
+
+			std::sort(Sorted.begin(), Sorted.end());
+
+			const double Mean{ std::accumulate(Sorted.begin(), Sorted.end(), 0.0) / static_cast<double>(Sorted.size()) };
+
+			if (OutputJSON)
+			{
+				Report << (FirstSection ? "\n" : ",\n") << "\t\t{ \"Section\": \"" << SectionNames[Index] << "\", \"Samples\": " << Sorted.size() << ", \"MeanMs\": " << Mean
+					<< ", \"P50Ms\": " << Percentile(Sorted, 50.0) << ", \"P95Ms\": " << Percentile(Sorted, 95.0) << ", \"P99Ms\": " << Percentile(Sorted, 99.0) << ", \"MaxMs\": " << Sorted.back() << " }";
+			}
+			else
+			{
+				Report << SectionNames[Index] << "," << Sorted.size() << "," << Mean << "," << Percentile(Sorted, 50.0) << "," << Percentile(Sorted, 95.0) << "," << Percentile(Sorted, 99.0) << "," << Sorted.back() << "\n";
+			}
+
+			NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Benchmark " + SectionNames[Index] + ": mean " + std::to_string(Mean) + " ms, p99 " + std::to_string(Percentile(Sorted, 99.0)) + " ms");
+			FirstSection = false;
+		}
+
+		if (OutputJSON)
+		{
+			Report << "\n\t]\n}\n";
+		}
+
+		if (std::ofstream File(OutputFile, std::ios::out | std::ios::trunc); File.fail())
+		{
+			NARCLog.AddEntry(lwmf::LogLevel::Error, __FILENAME__, __LINE__, "WriteReport(): Error writing " + OutputFile + "!");
+		}
+		else
+		{
+			File << Report.str();
+		}
+	}
+
+
+} // namespace Tools_Benchmark
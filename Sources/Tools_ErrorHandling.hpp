@@ -11,11 +11,9 @@
 
 #include <cstdint>
 #include <string>
-#include <array>
-#include <cstring>
-#include <fstream>
 #include <algorithm>
-#include <sys/stat.h>
+
+#include "Tools_VFS.hpp"
 
 inline constexpr bool ContinueOnError{ true };
 inline constexpr bool StopOnError{};
@@ -39,18 +37,16 @@ namespace Tools_ErrorHandling
 
 		bool Result{ true };
 
-		if (const std::ifstream File(FileName, std::ios::in); File.fail())
+		// Tools_VFS::Exists() does not touch errno (the pack is looked up in memory), so there is no system error message to show
+		if (!Tools_VFS::Exists(FileName))
 		{
-			std::array<char, 100> ErrorMessage{};
-			strerror_s(ErrorMessage.data(), 100, errno);
-
 			if (ActionFlag == StopOnError)
 			{
-				NARCLog.AddEntry(lwmf::LogLevel::Error, __FILENAME__, __LINE__, "CheckFileExistence(): Error loading " + FileName + ": " + std::string(ErrorMessage.data()));
+				NARCLog.AddEntry(lwmf::LogLevel::Error, __FILENAME__, __LINE__, "CheckFileExistence(): File " + FileName + " not found!");
 			}
 			else
 			{
-				NARCLog.AddEntry(lwmf::LogLevel::Warn, __FILENAME__, __LINE__, "CheckFileExistence(): Error loading " + FileName + ": " + std::string(ErrorMessage.data()));
+				NARCLog.AddEntry(lwmf::LogLevel::Warn, __FILENAME__, __LINE__, "CheckFileExistence(): File " + FileName + " not found!");
 				Result = false;
 			}
 		}
@@ -64,10 +60,7 @@ namespace Tools_ErrorHandling
 
 		bool Result{ true };
 
-		struct stat Info{};
-		stat(FolderName.c_str(), &Info);
-
-		if ((Info.st_mode & S_IFDIR) == 0)
+		if (!Tools_VFS::FolderExists(FolderName))
 		{
 			if (ActionFlag == StopOnError)
 			{
@@ -0,0 +1,161 @@
+/*
+******************************************
+*                                        *
+* Tools_LevelBaker.hpp                   *
+*                                        *
+* (c) 2017 - 2020 Stefan Kubsch          *
+******************************************
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <array>
+#include <fstream>
+
+#include "Game_GlobalDefinitions.hpp"
+#include "Game_Folder.hpp"
+#include "Tools_ErrorHandling.hpp"
+#include "GFX_ImageHandling.hpp"
+#include "Game_BakedLevel.hpp"
+#include "Game_LevelHandling.hpp"
+#include "Game_EntityHandling.hpp"
+
+namespace Tools_LevelBaker
+{
+
+
+	//
+	// Offline baker for the binary level container (see Game_BakedLevel.hpp)
+	//
+	// "NARC.exe -bakelevels" reads every level through the same functions the game uses for the text files and writes "Level.baked" next to them
+	//
+
+	bool BakeLevels();
+	bool BakeLevel(std::int_fast32_t Level);
+	void AddSection(std::vector<std::byte>& Data, Game_BakedLevel::Sections Section, std::uint32_t Count, const void* Payload, std::size_t Size);
+
+	//
+	// Variables and constants
+	//
+
+	inline std::vector<Game_BakedLevel::SectionStruct> SectionTable{};
+
+	//
+	// Functions
+	//
+
+	inline bool BakeLevels()
+	{
+		NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Bake levels...");
+
+		bool Result{ true };
+
+		for (std::int_fast32_t Level{ StartLevel }; Level <= NumberOfLevels; ++Level)
+		{
+			Result = BakeLevel(Level) && Result;
+		}
+
+		return Result;
+	}
+
+	inline bool BakeLevel(const std::int_fast32_t Level)
+	{
+		const std::string FileName{ Game_BakedLevel::GetFileName(Level) };
+		const std::string LevelPath{ LevelFolder + std::to_string(Level) + "/LevelData/" };
+
+		NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Bake level " + std::to_string(Level) + " into " + FileName + "...");
+
+		// Header and section table first, the sections are appended behind them
+		std::vector<std::byte> Data(sizeof(Game_BakedLevel::FileHeaderStruct) + sizeof(Game_BakedLevel::SectionStruct) * static_cast<std::size_t>(Game_BakedLevel::Sections::Counter));
+		SectionTable.clear();
+
+		// Map layers - rows are stored one after another and have to be of the same length
+		const std::array<std::string, 4> MapFiles{ "MapFloorData.conf", "MapWallData.conf", "MapCeilingData.conf", "MapDoorData.conf" };
+		std::vector<std::vector<std::vector<std::int_fast32_t>>> LevelMap(static_cast<std::size_t>(Game_LevelHandling::LevelMapLayers::Counter));
+
+		for (std::size_t Layer{}; Layer < MapFiles.size(); ++Layer)
+		{
+			Game_LevelHandling::ReadMapDataFile(LevelPath + MapFiles[Layer], LevelMap, static_cast<Game_LevelHandling::LevelMapLayers>(Layer));
+
+			std::vector<std::int32_t> Cells{};
+
+			for (const auto& Row : LevelMap[Layer])
+			{
+				if (Row.size() != LevelMap[Layer][0].size())
+				{
+					NARCLog.AddEntry(lwmf::LogLevel::Error, __FILENAME__, __LINE__, "BakeLevel(): Rows of " + MapFiles[Layer] + " differ in length!");
+					return false;
+				}
+
+				Cells.insert(Cells.end(), Row.begin(), Row.end());
+			}
+
+			AddSection(Data, static_cast<Game_BakedLevel::Sections>(static_cast<std::uint32_t>(Game_BakedLevel::Sections::FloorLayer) + static_cast<std::uint32_t>(Layer)), static_cast<std::uint32_t>(LevelMap[Layer].size()), Cells.data(), Cells.size() * sizeof(std::int32_t));
+		}
+
+		// Lights are baked even if lighting is switched off for the level - that is decided at load time
+		std::vector<Game_BakedLevel::LightRecordStruct> Lights{};
+		Game_LevelHandling::ReadLightsDataFile(LevelPath + "StaticLightsData.conf", Lights);
+		AddSection(Data, Game_BakedLevel::Sections::Lights, static_cast<std::uint32_t>(Lights.size()), Lights.data(), Lights.size() * sizeof(Game_BakedLevel::LightRecordStruct));
+
+		std::vector<Game_BakedLevel::EntityRecordStruct> EntityRecords{};
+		Game_EntityHandling::ReadEntityDataFiles(Level, EntityRecords);
+		AddSection(Data, Game_BakedLevel::Sections::Entities, static_cast<std::uint32_t>(EntityRecords.size()), EntityRecords.data(), EntityRecords.size() * sizeof(Game_BakedLevel::EntityRecordStruct));
+
+		// Textures are stored decoded, all of them in the configured TextureSize
+		std::vector<std::int32_t> Pixels{};
+		const std::vector<std::string> TextureFiles{ Game_LevelHandling::ReadTexturesDataFile(LevelPath + "TexturesData.conf") };
+
+		for (const auto& TextureFile : TextureFiles)
+		{
+			const lwmf::TextureStruct Texture{ GFX_ImageHandling::ImportTexture(TextureFile, TextureSize) };
+
+			if (Texture.Width != TextureSize || Texture.Height != TextureSize)
+			{
+				return false;
+			}
+
+			Pixels.insert(Pixels.end(), Texture.Pixels.begin(), Texture.Pixels.end());
+		}
+
+		AddSection(Data, Game_BakedLevel::Sections::Textures, static_cast<std::uint32_t>(TextureFiles.size()), Pixels.data(), Pixels.size() * sizeof(std::int32_t));
+
+		const Game_BakedLevel::FileHeaderStruct Header{ Game_BakedLevel::Magic, Game_BakedLevel::Version, static_cast<std::uint32_t>(Game_BakedLevel::Sections::Counter), static_cast<std::uint32_t>(TextureSize), Game_BakedLevel::GetSourceStamp(Level) };
+		std::memcpy(Data.data(), &Header, sizeof(Header));
+		std::memcpy(Data.data() + sizeof(Header), SectionTable.data(), SectionTable.size() * sizeof(Game_BakedLevel::SectionStruct));
+
+		std::ofstream File(FileName, std::ios::out | std::ios::binary | std::ios::trunc);
+		File.write(reinterpret_cast<const char*>(Data.data()), static_cast<std::streamsize>(Data.size()));
+
+		if (File.fail())
+		{
+			NARCLog.AddEntry(lwmf::LogLevel::Error, __FILENAME__, __LINE__, "BakeLevel(): Error writing " + FileName + "!");
+			return false;
+		}
+
+		NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, FileName + " written (" + std::to_string(Data.size()) + " bytes).");
+		return true;
+	}
+
+	inline void AddSection(std::vector<std::byte>& Data, const Game_BakedLevel::Sections Section, const std::uint32_t Count, const void* Payload, const std::size_t Size)
+	{
+		// Pad up to the next aligned offset
+		const std::size_t Offset{ (Data.size() + Game_BakedLevel::SectionAlignment - 1) & ~static_cast<std::size_t>(Game_BakedLevel::SectionAlignment - 1) };
+
+		Data.resize(Offset + Size);
+
+		if (Size > 0)
+		{
+			std::memcpy(Data.data() + Offset, Payload, Size);
+		}
+
+		SectionTable.push_back({ static_cast<std::uint32_t>(Section), Count, Offset, Size });
+	}
+
+
+} // namespace Tools_LevelBaker
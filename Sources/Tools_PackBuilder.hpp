@@ -0,0 +1,289 @@
+/*
+******************************************
+*                                        *
+* Tools_PackBuilder.hpp                  *
+*                                        *
+* (c) 2017 - 2020 Stefan Kubsch          *
+******************************************
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <unordered_set>
+
+#include "Game_GlobalDefinitions.hpp"
+#include "Game_Folder.hpp"
+#include "Game_BakedLevel.hpp"
+#include "Tools_VFS.hpp"
+
+namespace Tools_PackBuilder
+{
+
+
+	//
+	// Offline builder for the pack archive (see Tools_VFS.hpp)
+	//
+	// "NARC.exe -buildpack" packs all files and folders below PackFolders into "NARC.pack" - always from the loose files
+	// Files are added in path order, so the same data gives the same pack
+	// Levels with a "Level.baked" go in without the map, light, texture list and entity files it was made from - level textures stay, other levels may use them
+	// A file is stored compressed only if that saves at least 1/8 of it - PNG and MP3 are compressed already, baked levels have to stay mappable
+	//
+
+	struct SourceStruct final
+	{
+		std::string Path;
+		bool Directory{};
+	};
+
+	bool BuildPack();
+	std::vector<SourceStruct> GatherSources();
+	bool Compress(const std::vector<unsigned char>& In, std::vector<unsigned char>& Out);
+	void WriteSequence(std::vector<unsigned char>& Out, const unsigned char* Literals, std::size_t LiteralLength, std::size_t Distance, std::size_t MatchLength);
+	void WriteLength(std::vector<unsigned char>& Out, std::size_t Length);
+
+	//
+	// Variables and constants
+	//
+
+	inline const std::array<std::string, 4> PackFolders{ "./DATA", "./GFX", "./SFX", "./Fonts" };
+	inline const std::array<std::string, 1> StoredExtensions{ ".baked" };
+	inline constexpr std::size_t HashTableBits{ 16 };
+	inline constexpr std::size_t MaxDistance{ 65535 };
+
+	//
+	// Functions
+	//
+
+	inline bool BuildPack()
+	{
+		NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Build pack archive " + Tools_VFS::PackFileName + "...");
+
+		const std::vector<SourceStruct> Sources{ GatherSources() };
+
+		// Header and table of contents first, then the names - all sizes are known before any file is read
+		std::vector<Tools_VFS::PackEntryStruct> Entries(Sources.size());
+		std::string Names{};
+
+		for (std::size_t Index{}; Index < Sources.size(); ++Index)
+		{
+			const std::string Path{ Tools_VFS::NormalizePath(Sources[Index].Path) };
+
+			Entries[Index].PathHash = Tools_VFS::HashPath(Path);
+			Entries[Index].NameOffset = static_cast<std::uint32_t>(Names.size());
+			Entries[Index].NameLength = static_cast<std::uint32_t>(Path.size());
+			Names += Path;
+		}
+
+		const Tools_VFS::PackHeaderStruct Header{ Tools_VFS::Magic, Tools_VFS::Version, Entries.size(), sizeof(Tools_VFS::PackHeaderStruct) + Entries.size() * sizeof(Tools_VFS::PackEntryStruct), Names.size() };
+		std::vector<std::byte> Data(static_cast<std::size_t>(Header.NamesOffset + Header.NamesSize));
+		std::vector<unsigned char> Buffer{};
+		std::vector<unsigned char> Compressed{};
+		std::size_t CompressedFiles{};
+
+		for (std::size_t Index{}; Index < Sources.size(); ++Index)
+		{
+			Tools_VFS::PackEntryStruct& Entry{ Entries[Index] };
+
+			// Folders have no data - they are there for existence checks only
+			if (Sources[Index].Directory)
+			{
+				Entry.Flags = static_cast<std::uint32_t>(Tools_VFS::EntryFlags::Directory);
+				continue;
+			}
+
+			if (!lwmf::ReadFileFromDisk(Sources[Index].Path, Buffer))
+			{
+				NARCLog.AddEntry(lwmf::LogLevel::Error, __FILENAME__, __LINE__, "BuildPack(): Error reading " + Sources[Index].Path + "!");
+				return false;
+			}
+
+			const bool Stored{ std::any_of(StoredExtensions.begin(), StoredExtensions.end(), [&](const std::string& Extension) { return std::filesystem::path(Sources[Index].Path).extension() == Extension; }) };
+			const bool UseCompressed{ !Stored && Compress(Buffer, Compressed) && Compressed.size() <= Buffer.size() - (Buffer.size() >> 3) };
+			const std::vector<unsigned char>& Payload{ UseCompressed ? Compressed : Buffer };
+
+			// Pad up to the next aligned offset
+			Entry.Offset = (Data.size() + Tools_VFS::EntryAlignment - 1) & ~static_cast<std::size_t>(Tools_VFS::EntryAlignment - 1);
+			Entry.OriginalSize = Buffer.size();
+			Entry.StoredSize = Payload.size();
+			Entry.Flags = UseCompressed ? static_cast<std::uint32_t>(Tools_VFS::EntryFlags::Compressed) : 0;
+			CompressedFiles += UseCompressed ? 1 : 0;
+
+			Data.resize(static_cast<std::size_t>(Entry.Offset + Entry.StoredSize));
+
+			if (!Payload.empty())
+			{
+				std::memcpy(Data.data() + Entry.Offset, Payload.data(), Payload.size());
+			}
+		}
+
+		// Sorted by hash for the binary search - ties by name, so the order does not depend on the sort
+		std::sort(Entries.begin(), Entries.end(), [&](const auto& Left, const auto& Right) { return Left.PathHash != Right.PathHash ? Left.PathHash < Right.PathHash : Names.compare(Left.NameOffset, Left.NameLength, Names, Right.NameOffset, Right.NameLength) < 0; });
+
+		std::memcpy(Data.data(), &Header, sizeof(Header));
+		std::memcpy(Data.data() + sizeof(Header), Entries.data(), Entries.size() * sizeof(Tools_VFS::PackEntryStruct));
+		std::memcpy(Data.data() + Header.NamesOffset, Names.data(), Names.size());
+
+		std::ofstream File(Tools_VFS::PackFileName, std::ios::out | std::ios::binary | std::ios::trunc);
+		File.write(reinterpret_cast<const char*>(Data.data()), static_cast<std::streamsize>(Data.size()));
+
+		if (File.fail())
+		{
+			NARCLog.AddEntry(lwmf::LogLevel::Error, __FILENAME__, __LINE__, "BuildPack(): Error writing " + Tools_VFS::PackFileName + "!");
+			return false;
+		}
+
+		NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, Tools_VFS::PackFileName + " written (" + std::to_string(Entries.size()) + " entries, " + std::to_string(CompressedFiles) + " compressed, " + std::to_string(Data.size()) + " bytes).");
+		return true;
+	}
+
+	inline std::vector<SourceStruct> GatherSources()
+	{
+		std::vector<SourceStruct> Sources{};
+
+		for (const auto& Folder : PackFolders)
+		{
+			std::error_code Error{};
+
+			if (!std::filesystem::is_directory(Folder, Error))
+			{
+				NARCLog.AddEntry(lwmf::LogLevel::Warn, __FILENAME__, __LINE__, "GatherSources(): Folder " + Folder + " not found!");
+				continue;
+			}
+
+			Sources.push_back({ Folder, true });
+
+			for (const auto& Item : std::filesystem::recursive_directory_iterator(Folder))
+			{
+				if (Item.is_directory() || Item.is_regular_file())
+				{
+					Sources.push_back({ Item.path().generic_string(), Item.is_directory() });
+				}
+			}
+		}
+
+		// Level sources next to a bake are not read when the level is loaded from the pack
+		std::unordered_set<std::string> BakedSources{};
+
+		for (const auto& Source : Sources)
+		{
+			if (const std::filesystem::path Path{ Source.Path }; !Source.Directory && Path.filename() == "Level.baked" && Path.parent_path().parent_path().generic_string() + "/" == LevelFolder)
+			{
+				const std::string LevelPath{ Path.parent_path().generic_string() + "/" };
+
+				for (auto&& FileName : Game_BakedLevel::GatherSourceFiles(std::stoi(Path.parent_path().filename().string())))
+				{
+					if (FileName.starts_with(LevelPath))
+					{
+						BakedSources.insert(std::move(FileName));
+					}
+				}
+			}
+		}
+
+		std::erase_if(Sources, [&](const SourceStruct& Source) { return BakedSources.contains(Source.Path); });
+
+		if (!BakedSources.empty())
+		{
+			NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "GatherSources(): " + std::to_string(BakedSources.size()) + " level source files left out (baked).");
+		}
+
+		std::sort(Sources.begin(), Sources.end(), [](const SourceStruct& Left, const SourceStruct& Right) { return Left.Path < Right.Path; });
+
+		return Sources;
+	}
+
+	inline bool Compress(const std::vector<unsigned char>& In, std::vector<unsigned char>& Out)
+	{
+		// Greedy LZ77 in the format Tools_VFS::Decompress() reads - the last position of every 4 byte sequence is kept in a hash table
+		// Returns false if there is nothing to gain (too small)
+		Out.clear();
+
+		if (In.size() < Tools_VFS::MinMatchLength * 2)
+		{
+			return false;
+		}
+
+		std::vector<std::int_fast64_t> HashTable(static_cast<std::size_t>(1) << HashTableBits, -1);
+		std::size_t LiteralStart{};
+
+		for (std::size_t Pos{}; Pos + Tools_VFS::MinMatchLength <= In.size();)
+		{
+			std::uint32_t Sequence{};
+			std::memcpy(&Sequence, &In[Pos], sizeof(Sequence));
+
+			const std::size_t Slot{ static_cast<std::size_t>((Sequence * 2654435761U) >> (32 - HashTableBits)) };
+			const std::int_fast64_t Candidate{ HashTable[Slot] };
+			HashTable[Slot] = static_cast<std::int_fast64_t>(Pos);
+
+			if (Candidate < 0 || Pos - static_cast<std::size_t>(Candidate) > MaxDistance || std::memcmp(&In[static_cast<std::size_t>(Candidate)], &In[Pos], Tools_VFS::MinMatchLength) != 0)
+			{
+				++Pos;
+				continue;
+			}
+
+			const std::size_t Match{ static_cast<std::size_t>(Candidate) };
+			std::size_t Length{ Tools_VFS::MinMatchLength };
+
+			while (Pos + Length < In.size() && In[Match + Length] == In[Pos + Length])
+			{
+				++Length;
+			}
+
+			WriteSequence(Out, &In[LiteralStart], Pos - LiteralStart, Pos - Match, Length);
+			Pos += Length;
+			LiteralStart = Pos;
+		}
+
+		// The last sequence has literals only
+		WriteSequence(Out, In.data() + LiteralStart, In.size() - LiteralStart, 0, 0);
+
+		return true;
+	}
+
+	inline void WriteSequence(std::vector<unsigned char>& Out, const unsigned char* Literals, const std::size_t LiteralLength, const std::size_t Distance, const std::size_t MatchLength)
+	{
+		// Distance 0 = last sequence, no match behind the literals
+		const std::size_t MatchCode{ Distance == 0 ? 0 : MatchLength - Tools_VFS::MinMatchLength };
+
+		Out.push_back(static_cast<unsigned char>((std::min<std::size_t>(LiteralLength, 15) << 4) | std::min<std::size_t>(MatchCode, 15)));
+
+		if (LiteralLength >= 15)
+		{
+			WriteLength(Out, LiteralLength - 15);
+		}
+
+		Out.insert(Out.end(), Literals, Literals + LiteralLength);
+
+		if (Distance != 0)
+		{
+			Out.push_back(static_cast<unsigned char>(Distance & 255));
+			Out.push_back(static_cast<unsigned char>(Distance >> 8));
+
+			if (MatchCode >= 15)
+			{
+				WriteLength(Out, MatchCode - 15);
+			}
+		}
+	}
+
+	inline void WriteLength(std::vector<unsigned char>& Out, std::size_t Length)
+	{
+		for (; Length >= 255; Length -= 255)
+		{
+			Out.push_back(255);
+		}
+
+		Out.push_back(static_cast<unsigned char>(Length));
+	}
+
+
+} // namespace Tools_PackBuilder
@@ -0,0 +1,383 @@
+/*
+******************************************
+*                                        *
+* Tools_VFS.hpp                          *
+*                                        *
+* (c) 2017 - 2020 Stefan Kubsch          *
+******************************************
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <cctype>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <array>
+#include <span>
+#include <fstream>
+#include <algorithm>
+#include <iterator>
+#include <sys/stat.h>
+
+namespace Tools_VFS
+{
+
+
+	//
+	// Virtual file system
+	//
+	// All game files (INI, CSV, PNG, MP3, fonts, baked levels) are read through here - lwmf gets its files via lwmf::FileReader
+	// If "NARC.pack" exists (made by "NARC.exe -buildpack", see Tools_PackBuilder.hpp), it is memory mapped and searched first
+	// Everything not in the pack - or everything at all, if there is no pack - comes from the loose files, so during development nothing needs to be packed
+	//
+	// Pack layout: PackHeaderStruct, the table of contents (one PackEntryStruct per file and folder, sorted by PathHash), the name table, then the file data
+	// File data starts at a multiple of EntryAlignment and is either stored as is or compressed (see Decompress())
+	// Paths are normalized before hashing ("./DATA\Levels/" = "data/levels"), so a lookup is a binary search over the hashes plus one name compare
+	//
+
+	enum class EntryFlags : std::uint32_t
+	{
+		Directory = 1,
+		Compressed = 2
+	};
+
+	struct PackHeaderStruct final
+	{
+		std::array<char, 4> Magic{};
+		std::uint32_t Version{};
+		std::uint64_t NumberOfEntries{};
+		std::uint64_t NamesOffset{};
+		std::uint64_t NamesSize{};
+	};
+
+	struct PackEntryStruct final
+	{
+		std::uint64_t PathHash{};
+		std::uint64_t Offset{};
+		std::uint64_t StoredSize{};
+		std::uint64_t OriginalSize{};
+		std::uint32_t NameOffset{};
+		std::uint32_t NameLength{};
+		std::uint32_t Flags{};
+		std::uint32_t Reserved{};
+	};
+
+	bool Init();
+	bool CheckPack();
+	void Close();
+	std::string NormalizePath(std::string_view Path);
+	std::uint64_t HashPath(std::string_view NormalizedPath);
+	const PackEntryStruct* Find(const std::string& FileName);
+	bool HasFlag(const PackEntryStruct& Entry, EntryFlags Flag);
+	bool Exists(const std::string& FileName);
+	bool FolderExists(const std::string& FolderName);
+	bool ReadFile(const std::string& FileName, std::vector<unsigned char>& Data);
+	std::string ReadText(const std::string& FileName);
+	std::span<const std::byte> Map(const std::string& FileName);
+	bool Decompress(std::span<const std::byte> In, std::vector<unsigned char>& Out);
+	bool ReadLength(std::span<const std::byte> In, std::size_t& InPos, std::size_t& Length);
+
+	//
+	// Variables and constants
+	//
+
+	inline constexpr std::array<char, 4> Magic{ 'N', 'P', 'A', 'K' };
+	inline constexpr std::uint32_t Version{ 1 };
+	inline constexpr std::uint64_t EntryAlignment{ 64 };
+	inline constexpr std::size_t MinMatchLength{ 4 };
+
+	inline const std::string PackFileName{ "./NARC.pack" };
+
+	inline lwmf::MappedFile PackFile{};
+	inline std::span<const PackEntryStruct> Entries{};
+	inline std::string_view Names{};
+
+	//
+	// Functions
+	//
+
+	inline bool Init()
+	{
+		Close();
+
+		// Loose files are always there as fallback - so whatever happens here, lwmf reads through the VFS from now on
+		lwmf::FileReader = ReadFile;
+
+		if (const std::ifstream File(PackFileName, std::ios::in); File.fail())
+		{
+			NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "No pack archive found, using loose files...");
+			return false;
+		}
+
+		NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, "Open pack archive " + PackFileName + "...");
+
+		if (!PackFile.Open(PackFileName) || !CheckPack())
+		{
+			NARCLog.AddEntry(lwmf::LogLevel::Warn, __FILENAME__, __LINE__, "Init(): " + PackFileName + " is invalid or was made for another version - using loose files!");
+			Close();
+			return false;
+		}
+
+		NARCLog.AddEntry(lwmf::LogLevel::Info, __FILENAME__, __LINE__, std::to_string(Entries.size()) + " entries found in " + PackFileName + ".");
+		return true;
+	}
+
+	inline bool CheckPack()
+	{
+		const std::size_t FileSize{ PackFile.GetSize() };
+
+		if (FileSize < sizeof(PackHeaderStruct))
+		{
+			return false;
+		}
+
+		PackHeaderStruct Header{};
+		std::memcpy(&Header, PackFile.GetData(), sizeof(PackHeaderStruct));
+
+		// The table of contents follows the header
+		if (Header.Magic != Magic || Header.Version != Version || Header.NumberOfEntries > (FileSize - sizeof(PackHeaderStruct)) / sizeof(PackEntryStruct)
+			|| Header.NamesOffset != sizeof(PackHeaderStruct) + Header.NumberOfEntries * sizeof(PackEntryStruct) || Header.NamesSize > FileSize - Header.NamesOffset)
+		{
+			return false;
+		}
+
+		const std::span<const PackEntryStruct> Table{ reinterpret_cast<const PackEntryStruct*>(PackFile.GetData() + sizeof(PackHeaderStruct)), static_cast<std::size_t>(Header.NumberOfEntries) };
+
+		for (std::size_t Index{}; Index < Table.size(); ++Index)
+		{
+			const PackEntryStruct& Entry{ Table[Index] };
+
+			if ((Index > 0 && Table[Index - 1].PathHash > Entry.PathHash) || static_cast<std::uint64_t>(Entry.NameOffset) + Entry.NameLength > Header.NamesSize
+				|| Entry.Offset % EntryAlignment != 0 || Entry.Offset > FileSize || Entry.StoredSize > FileSize - Entry.Offset)
+			{
+				return false;
+			}
+		}
+
+		Entries = Table;
+		Names = { reinterpret_cast<const char*>(PackFile.GetData() + Header.NamesOffset), static_cast<std::size_t>(Header.NamesSize) };
+
+		return true;
+	}
+
+	inline void Close()
+	{
+		PackFile.Close();
+		Entries = {};
+		Names = {};
+	}
+
+	inline std::string NormalizePath(const std::string_view Path)
+	{
+		// Lower case, "/" only, no "." or empty segments - Windows does not care about these, so neither does the pack
+		std::string Result{};
+		Result.reserve(Path.size());
+
+		for (std::size_t Start{}; Start <= Path.size();)
+		{
+			std::size_t End{ Path.find_first_of("/\\", Start) };
+
+			if (End == std::string_view::npos)
+			{
+				End = Path.size();
+			}
+
+			if (const std::string_view Segment{ Path.substr(Start, End - Start) }; !Segment.empty() && Segment != ".")
+			{
+				if (!Result.empty())
+				{
+					Result += '/';
+				}
+
+				std::transform(Segment.begin(), Segment.end(), std::back_inserter(Result), [](const unsigned char Char) { return static_cast<char>(std::tolower(Char)); });
+			}
+
+			Start = End + 1;
+		}
+
+		return Result;
+	}
+
+	inline std::uint64_t HashPath(const std::string_view NormalizedPath)
+	{
+		return lwmf::HashBytes(NormalizedPath.data(), NormalizedPath.size(), 0);
+	}
+
+	inline const PackEntryStruct* Find(const std::string& FileName)
+	{
+		if (Entries.empty())
+		{
+			return nullptr;
+		}
+
+		const std::string Path{ NormalizePath(FileName) };
+		const std::uint64_t Hash{ HashPath(Path) };
+
+		// Entries with the same hash are next to each other - the name decides
+		for (auto Entry{ std::lower_bound(Entries.begin(), Entries.end(), Hash, [](const PackEntryStruct& Left, const std::uint64_t Right) { return Left.PathHash < Right; }) }; Entry != Entries.end() && Entry->PathHash == Hash; ++Entry)
+		{
+			if (Names.substr(Entry->NameOffset, Entry->NameLength) == Path)
+			{
+				return &*Entry;
+			}
+		}
+
+		return nullptr;
+	}
+
+	inline bool HasFlag(const PackEntryStruct& Entry, const EntryFlags Flag)
+	{
+		return (Entry.Flags & static_cast<std::uint32_t>(Flag)) != 0;
+	}
+
+	inline bool Exists(const std::string& FileName)
+	{
+		if (const PackEntryStruct* Entry{ Find(FileName) }; Entry != nullptr)
+		{
+			return !HasFlag(*Entry, EntryFlags::Directory);
+		}
+
+		const std::ifstream File(FileName, std::ios::in);
+		return !File.fail();
+	}
+
+	inline bool FolderExists(const std::string& FolderName)
+	{
+		if (const PackEntryStruct* Entry{ Find(FolderName) }; Entry != nullptr)
+		{
+			return HasFlag(*Entry, EntryFlags::Directory);
+		}
+
+		struct stat Info{};
+		return stat(FolderName.c_str(), &Info) == 0 && (Info.st_mode & S_IFDIR) != 0;
+	}
+
+	inline bool ReadFile(const std::string& FileName, std::vector<unsigned char>& Data)
+	{
+		// Called from asset jobs on several threads - the pack is never changed after Init(), so no locking needed
+		const PackEntryStruct* Entry{ Find(FileName) };
+
+		if (Entry == nullptr)
+		{
+			return lwmf::ReadFileFromDisk(FileName, Data);
+		}
+
+		if (HasFlag(*Entry, EntryFlags::Directory))
+		{
+			return false;
+		}
+
+		const std::span<const std::byte> Stored{ PackFile.GetData() + Entry->Offset, static_cast<std::size_t>(Entry->StoredSize) };
+		Data.resize(static_cast<std::size_t>(Entry->OriginalSize));
+
+		if (HasFlag(*Entry, EntryFlags::Compressed) ? !Decompress(Stored, Data) : Stored.size() != Data.size())
+		{
+			NARCLog.AddEntry(lwmf::LogLevel::Warn, __FILENAME__, __LINE__, "ReadFile(): " + FileName + " is corrupt in " + PackFileName + "!");
+			return false;
+		}
+
+		if (!HasFlag(*Entry, EntryFlags::Compressed))
+		{
+			std::copy(Stored.begin(), Stored.end(), reinterpret_cast<std::byte*>(Data.data()));
+		}
+
+		return true;
+	}
+
+	inline std::string ReadText(const std::string& FileName)
+	{
+		// Like a stream opened in text mode - Windows line endings become "\n"
+		std::vector<unsigned char> Data{};
+		ReadFile(FileName, Data);
+
+		std::string Text(Data.begin(), Data.end());
+		Text.erase(std::remove(Text.begin(), Text.end(), '\r'), Text.end());
+
+		return Text;
+	}
+
+	inline std::span<const std::byte> Map(const std::string& FileName)
+	{
+		// Only uncompressed files in the pack can be used in place - empty means "not available, read it otherwise"
+		if (const PackEntryStruct* Entry{ Find(FileName) }; Entry != nullptr && Entry->Flags == 0 && Entry->StoredSize == Entry->OriginalSize)
+		{
+			return { PackFile.GetData() + Entry->Offset, static_cast<std::size_t>(Entry->StoredSize) };
+		}
+
+		return {};
+	}
+
+	inline bool Decompress(const std::span<const std::byte> In, std::vector<unsigned char>& Out)
+	{
+		// Byte oriented LZ77 (LZ4 block style) - every sequence is:
+		// Token: literal length (high nibble), match length - MinMatchLength (low nibble) - a nibble of 15 is continued by bytes, until one is less than 255
+		// Literals, then the 16 bit distance of the match (little endian) - the last sequence ends after its literals
+		// Out has to be of the original size already
+		std::size_t InPos{};
+		std::size_t OutPos{};
+
+		while (InPos < In.size())
+		{
+			const std::uint8_t Token{ static_cast<std::uint8_t>(In[InPos++]) };
+			std::size_t LiteralLength{ static_cast<std::size_t>(Token >> 4) };
+
+			if ((LiteralLength == 15 && !ReadLength(In, InPos, LiteralLength)) || LiteralLength > In.size() - InPos || LiteralLength > Out.size() - OutPos)
+			{
+				return false;
+			}
+
+			std::copy_n(reinterpret_cast<const unsigned char*>(In.data()) + InPos, LiteralLength, Out.data() + OutPos);
+			InPos += LiteralLength;
+			OutPos += LiteralLength;
+
+			if (InPos == In.size())
+			{
+				break;
+			}
+
+			if (In.size() - InPos < 2)
+			{
+				return false;
+			}
+
+			const std::size_t Distance{ static_cast<std::size_t>(In[InPos]) | (static_cast<std::size_t>(In[InPos + 1]) << 8) };
+			InPos += 2;
+			std::size_t MatchLength{ static_cast<std::size_t>(Token & 15) };
+
+			if ((MatchLength == 15 && !ReadLength(In, InPos, MatchLength)) || Distance == 0 || Distance > OutPos || MatchLength + MinMatchLength > Out.size() - OutPos)
+			{
+				return false;
+			}
+
+			// Matches may overlap what they produce (runs), so byte by byte
+			for (const std::size_t End{ OutPos + MatchLength + MinMatchLength }; OutPos < End; ++OutPos)
+			{
+				Out[OutPos] = Out[OutPos - Distance];
+			}
+		}
+
+		return OutPos == Out.size();
+	}
+
+	inline bool ReadLength(const std::span<const std::byte> In, std::size_t& InPos, std::size_t& Length)
+	{
+		for (std::uint8_t Byte{ 255 }; Byte == 255;)
+		{
+			if (InPos >= In.size())
+			{
+				return false;
+			}
+
+			Byte = static_cast<std::uint8_t>(In[InPos++]);
+			Length += Byte;
+		}
+
+		return true;
+	}
+
+
+} // namespace Tools_VFS
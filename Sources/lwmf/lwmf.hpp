@@ -27,7 +27,9 @@ inline lwmf::Logging LWMFSystemLog("lwmf_systemlog.log");
 
 #include "lwmf_simd.hpp"
 #include "lwmf_math.hpp"
+#include "lwmf_random.hpp"
 #include "lwmf_general.hpp"
+#include "lwmf_fileaccess.hpp"
 #include "lwmf_color.hpp"
 #include "lwmf_openglloader.hpp"
 #include "lwmf_openglwindow.hpp"
@@ -49,4 +51,5 @@ inline lwmf::Logging LWMFSystemLog("lwmf_systemlog.log");
 #include "lwmf_perlinnoise.hpp"
 #include "lwmf_fpscounter.hpp"
 #include "lwmf_multithreading.hpp"
-#include "lwmf_inifile.hpp"
\ No newline at end of file
+#include "lwmf_inifile.hpp"
+#include "lwmf_mappedfile.hpp"
\ No newline at end of file
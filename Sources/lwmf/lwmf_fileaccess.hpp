@@ -0,0 +1,64 @@
+/*
+****************************************************
+*                                                  *
+* lwmf_fileaccess - lightweight media framework    *
+*                                                  *
+* (C) 2019 - present by Stefan Kubsch              *
+*                                                  *
+****************************************************
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <functional>
+#include <fstream>
+
+namespace lwmf
+{
+
+
+	// All files lwmf loads (PNG, INI, MP3) are read by ReadFile()
+	// Without a FileReader they come right from disk - an application can set one to serve them from somewhere else (e.g. a pack archive)
+	// Both return false if the file does not exist
+
+	using FileReaderFunction = std::function<bool(const std::string& FileName, std::vector<unsigned char>& Data)>;
+
+	bool ReadFile(const std::string& FileName, std::vector<unsigned char>& Data);
+	bool ReadFileFromDisk(const std::string& FileName, std::vector<unsigned char>& Data);
+
+	//
+	// Variables and constants
+	//
+
+	inline FileReaderFunction FileReader{};
+
+	//
+	// Functions
+	//
+
+	inline bool ReadFile(const std::string& FileName, std::vector<unsigned char>& Data)
+	{
+		return FileReader ? FileReader(FileName, Data) : ReadFileFromDisk(FileName, Data);
+	}
+
+	inline bool ReadFileFromDisk(const std::string& FileName, std::vector<unsigned char>& Data)
+	{
+		std::ifstream File(FileName, std::ios::in | std::ios::binary | std::ios::ate);
+
+		if (File.fail())
+		{
+			return false;
+		}
+
+		Data.resize(static_cast<std::size_t>(File.tellg()));
+		File.seekg(0);
+		File.read(reinterpret_cast<char*>(Data.data()), static_cast<std::streamsize>(Data.size()));
+
+		return !File.fail();
+	}
+
+
+} // namespace lwmf
\ No newline at end of file
@@ -12,124 +12,460 @@
 
 #include <cstdint>
 #include <string>
-#include <regex>
+#include <string_view>
 #include <vector>
+#include <deque>
+#include <unordered_map>
+#include <mutex>
+#include <charconv>
+#include <cctype>
+#include <type_traits>
 #include <fstream>
 #include <sstream>
 #include <algorithm>
 
 #include "lwmf_logging.hpp"
+#include "lwmf_fileaccess.hpp"
 
 namespace lwmf
 {
 
 
+	//
+	// INI documents
+	//
+	// A file gets parsed once into a table of sections and keys - every further read is a hash lookup, no reopening of the file and no regex
+	// Values are views into the text of the document, the typed accessors convert them on demand
+	// Documents are cached by file name; ReadINIValue() and WriteINIValue() work on the cached documents under INIDocumentsMutex, so they can be used from any thread
+	// A document got by GetINIDocument() itself is not locked - only read from it while nobody writes to the same file
+	// Save() parses the written lines again, so the cache always holds what is on disk; ReloadINIDocument() re-reads a file that was changed from outside
+	// Views (GetRaw()) are valid until the next write or reload of their document
+	//
+	// Like before, all spaces of a line are ignored, a value ends at "#" and keys consist of word characters
+	// Numbers may have a leading "+" and surrounding whitespace (tabs)
+	//
+
+	// For batch reads: GetValues("SECTION", INIBinding{ "Key", Variable }, ...)
+	template<typename T>
+	struct INIBinding final
+	{
+		std::string_view Key;
+		T& Value;
+	};
+
+	class INIDocument final
+	{
+	public:
+		bool Load(const std::string& INIFileName);
+		bool Save();
+		bool IsLoaded() const;
+		bool HasValue(std::string_view Section, std::string_view Key) const;
+		std::string_view GetRaw(std::string_view Section, std::string_view Key) const;
+		template<typename T>bool TryGet(std::string_view Section, std::string_view Key, T& Value) const;
+		template<typename T>T Get(std::string_view Section, std::string_view Key, T Default = T{}) const;
+		template<typename... T>std::int_fast32_t GetValues(std::string_view Section, INIBinding<T>... Bindings) const;
+		template<typename T>void Set(std::string_view Section, std::string_view Key, const T& Value);
+
+	private:
+		struct EntryStruct final
+		{
+			std::string_view Value;
+			std::size_t Line{};
+		};
+
+		struct SectionStruct final
+		{
+			std::unordered_map<std::string_view, EntryStruct> Entries{};
+			std::size_t LastLine{};
+		};
+
+		void Parse(const std::string& Text);
+		const EntryStruct* Find(std::string_view Section, std::string_view Key) const;
+		std::string_view Store(std::string Text);
+		template<typename T>static bool Convert(std::string_view Text, T& Value);
+		template<typename T>static std::string ToText(const T& Value);
+
+		std::string FileName;
+		// Original lines, so comments and formatting survive a write-back
+		std::vector<std::string> Lines{};
+		// Owns the text all views point to - a deque never moves its elements
+		std::deque<std::string> Strings{};
+		std::unordered_map<std::string_view, SectionStruct> Sections{};
+		bool Loaded{};
+	};
+
+	INIDocument& GetINIDocument(const std::string& INIFileName);
+	INIDocument& FindINIDocument(const std::string& INIFileName);
+	void ReloadINIDocument(const std::string& INIFileName);
 	template<typename T>T ReadINIValue(const std::string& INIFileName, const std::string& Section, const std::string& Key);
 	template<typename T>void WriteINIValue(const std::string& Section, const std::string& Key, T Value, const std::string& INIFileName);
 	std::int_fast32_t ReadINIValueRGBA(const std::string& INIFileName, const std::string& Section);
 
+	//
+	// Variables and constants
+	//
+
+	inline std::unordered_map<std::string, INIDocument> INIDocuments{};
+	inline std::mutex INIDocumentsMutex;
+
 	//
 	// Functions
 	//
 
-	template<typename T>T ReadINIValue(const std::string& INIFileName, const std::string& Section, const std::string& Key)
+	inline bool INIDocument::Load(const std::string& INIFileName)
 	{
-		LWMFSystemLog.AddEntry(LogLevel::Info, __FILENAME__, __LINE__, "Reading value from INI file " + INIFileName + ": [" + Section + "] / " + Key + "...");
+		LWMFSystemLog.AddEntry(LogLevel::Info, __FILENAME__, __LINE__, "Parsing INI file " + INIFileName + "...");
 
-		const std::regex SectionTest(R"(\[(.*?)\])", std::regex::optimize | std::regex::icase);
-		const std::regex ValueTest(R"((\w+)=([^\#]+(?!\+{3})))", std::regex::optimize | std::regex::icase);
+		FileName = INIFileName;
 
-		T OutputVar{};
-		std::ifstream INIFile(INIFileName, std::ios::in);
-		std::smatch Match{};
-		std::string CurrentSection;
+		std::vector<unsigned char> Buffer{};
+		Loaded = ReadFile(INIFileName, Buffer);
+		Parse(std::string(Buffer.begin(), Buffer.end()));
+
+		return Loaded;
+	}
+
+	inline bool INIDocument::Save()
+	{
+		LWMFSystemLog.AddEntry(LogLevel::Info, __FILENAME__, __LINE__, "Writing INI file " + FileName + "...");
+
+		std::string Text;
+
+		for (const auto& Line : Lines)
+		{
+			Text += Line;
+			Text += "\n";
+		}
+
+		std::ofstream INIFile(FileName, std::ios::out | std::ios::trunc);
+		INIFile << Text;
+
+		if (INIFile.fail())
+		{
+			return false;
+		}
+
+		// Values set by Set() are stored as written - parsed again, they read exactly like the file will on the next start
+		Loaded = true;
+		Parse(Text);
+
+		return true;
+	}
+
+	inline void INIDocument::Parse(const std::string& Text)
+	{
+		Lines.clear();
+		Strings.clear();
+		Sections.clear();
+
+		std::istringstream INIFile(Text);
+
+		// Keys before the first section header belong to ""
+		SectionStruct* CurrentSection{ &Sections[Store({})] };
 		std::string Line;
-		bool ValueFound{};
 
 		while (std::getline(INIFile, Line))
 		{
-			// Remove all spaces from line
+			// The buffer is read in binary mode, so Windows line endings are still there
+			if (!Line.empty() && Line.back() == '\r')
+			{
+				Line.pop_back();
+			}
+
+			Lines.emplace_back(Line);
+
 			Line.erase(std::remove(Line.begin(), Line.end(), ' '), Line.end());
 
-			if (Line.length() > 0)
+			if (Line.empty() || Line[0] == ';' || Line[0] == '#')
+			{
+				continue;
+			}
+
+			const std::string_view Text{ Store(std::move(Line)) };
+			const std::size_t LineNumber{ Lines.size() - 1 };
+
+			if (const std::size_t SectionStart{ Text.find('[') }, SectionEnd{ Text.find(']', SectionStart) }; SectionStart != std::string_view::npos && SectionEnd != std::string_view::npos)
 			{
-				if (std::regex_search(Line, Match, SectionTest))
+				CurrentSection = &Sections[Text.substr(SectionStart + 1, SectionEnd - SectionStart - 1)];
+				CurrentSection->LastLine = LineNumber;
+			}
+			else if (const std::size_t Equal{ Text.find('=') }; Equal != std::string_view::npos)
+			{
+				// Key = the word characters right in front of "="
+				std::size_t KeyStart{ Equal };
+
+				while (KeyStart > 0 && (std::isalnum(static_cast<unsigned char>(Text[KeyStart - 1])) != 0 || Text[KeyStart - 1] == '_'))
 				{
-					CurrentSection = Match[1];
+					--KeyStart;
 				}
-				else if (std::regex_search(Line, Match, ValueTest) && (CurrentSection == Section && Match[1] == Key))
-				{
-					LWMFSystemLog.AddEntry(LogLevel::Info, __FILENAME__, __LINE__, "   Value : " + std::string(Match[2]));
 
-					// Convert Value to proper type
-					std::istringstream Stream(Match[2]);
-					std::string(typeid(T).name()) == "bool" ? Stream >> std::boolalpha >> OutputVar : Stream >> OutputVar;
-					ValueFound = true;
-					break;
+				const std::string_view Value{ Text.substr(Equal + 1, Text.find('#', Equal + 1) - Equal - 1) };
+
+				if (KeyStart < Equal && !Value.empty())
+				{
+					// The first one wins if a key is defined twice
+					CurrentSection->Entries.try_emplace(Text.substr(KeyStart, Equal - KeyStart), EntryStruct{ Value, LineNumber });
+					CurrentSection->LastLine = LineNumber;
 				}
 			}
 		}
+	}
 
-		if (!ValueFound)
-		{
-			LWMFSystemLog.AddEntry(LogLevel::Error, __FILENAME__, __LINE__, "Value [" + Section + "] / " + Key + " not found!");
-		}
+	inline bool INIDocument::IsLoaded() const
+	{
+		return Loaded;
+	}
 
-		return OutputVar;
+	inline bool INIDocument::HasValue(const std::string_view Section, const std::string_view Key) const
+	{
+		return Find(Section, Key) != nullptr;
 	}
 
-	template<typename T>void WriteINIValue(const std::string& Section, const std::string& Key, const T Value, const std::string& INIFileName)
+	inline std::string_view INIDocument::GetRaw(const std::string_view Section, const std::string_view Key) const
 	{
-		LWMFSystemLog.AddEntry(LogLevel::Info, __FILENAME__, __LINE__, "Writing value to INI file " + INIFileName + " [" + Section + "] / " + Key);
+		const EntryStruct* Entry{ Find(Section, Key) };
+		return Entry != nullptr ? Entry->Value : std::string_view{};
+	}
+
+	template<typename T>bool INIDocument::TryGet(const std::string_view Section, const std::string_view Key, T& Value) const
+	{
+		const EntryStruct* Entry{ Find(Section, Key) };
+		return Entry != nullptr && Convert(Entry->Value, Value);
+	}
 
-		// Read INI file into vector of strings
+	template<typename T>T INIDocument::Get(const std::string_view Section, const std::string_view Key, T Default) const
+	{
+		TryGet(Section, Key, Default);
+		return Default;
+	}
+
+	template<typename... T>std::int_fast32_t INIDocument::GetValues(const std::string_view Section, INIBinding<T>... Bindings) const
+	{
+		// Returns the number of values found - the others keep their value
+		return (static_cast<std::int_fast32_t>(TryGet(Section, Bindings.Key, Bindings.Value)) + ... + 0);
+	}
+
+	template<typename T>void INIDocument::Set(const std::string_view Section, const std::string_view Key, const T& Value)
+	{
+		const std::string Text{ ToText(Value) };
+		std::string Line{ Key };
+		Line += "=";
+		Line += Text;
 
-		std::vector<std::string> VectorOfStrings{};
-		std::ifstream InputINIFile(INIFileName, std::ios::in);
-		std::string InputLine;
+		auto SectionFound{ Sections.find(Section) };
 
-		while (std::getline(InputINIFile, InputLine))
+		if (SectionFound == Sections.end())
 		{
-			VectorOfStrings.emplace_back(InputLine);
+			if (!Lines.empty())
+			{
+				Lines.emplace_back();
+			}
+
+			Lines.emplace_back("[" + std::string(Section) + "]");
+			SectionFound = Sections.try_emplace(Store(std::string(Section))).first;
+			SectionFound->second.LastLine = Lines.size() - 1;
 		}
 
-		InputINIFile.close();
+		if (const auto EntryFound{ SectionFound->second.Entries.find(Key) }; EntryFound != SectionFound->second.Entries.end())
+		{
+			Lines[EntryFound->second.Line] = std::move(Line);
+			EntryFound->second.Value = Store(Text);
+			return;
+		}
 
-		// Modify proper line and write back INI file
+		// New keys go right behind the last key of their section - every line number after it moves down by one
+		const std::size_t LineNumber{ SectionFound->second.LastLine + 1 };
+		Lines.insert(Lines.begin() + static_cast<std::ptrdiff_t>(LineNumber), std::move(Line));
 
-		const std::regex SectionTest(R"(\[(.*?)\])", std::regex::optimize | std::regex::icase);
-		const std::regex ValueTest(R"((\w+)=([^\#]+(?!\+{3})))", std::regex::optimize | std::regex::icase);
+		for (auto&& [Name, SectionData] : Sections)
+		{
+			if (SectionData.LastLine >= LineNumber)
+			{
+				++SectionData.LastLine;
+			}
 
-		std::string CurrentSection;
-		std::ofstream OutputINIFile(INIFileName, std::ios::in);
-		std::smatch Match{};
+			for (auto&& [EntryKey, Entry] : SectionData.Entries)
+			{
+				if (Entry.Line >= LineNumber)
+				{
+					++Entry.Line;
+				}
+			}
+		}
 
-		for (auto&& Line : VectorOfStrings)
+		SectionFound->second.Entries.try_emplace(Store(std::string(Key)), EntryStruct{ Store(Text), LineNumber });
+		SectionFound->second.LastLine = LineNumber;
+	}
+
+	inline const INIDocument::EntryStruct* INIDocument::Find(const std::string_view Section, const std::string_view Key) const
+	{
+		if (const auto SectionFound{ Sections.find(Section) }; SectionFound != Sections.end())
 		{
-			// Remove all spaces from line
-			Line.erase(std::remove(Line.begin(), Line.end(), ' '), Line.end());
+			if (const auto EntryFound{ SectionFound->second.Entries.find(Key) }; EntryFound != SectionFound->second.Entries.end())
+			{
+				return &EntryFound->second;
+			}
+		}
+
+		return nullptr;
+	}
+
+	inline std::string_view INIDocument::Store(std::string Text)
+	{
+		return Strings.emplace_back(std::move(Text));
+	}
+
+	template<typename T>bool INIDocument::Convert(std::string_view Text, T& Value)
+	{
+		// Spaces are gone already, but tabs are not
+		while (!Text.empty() && std::isspace(static_cast<unsigned char>(Text.front())) != 0)
+		{
+			Text.remove_prefix(1);
+		}
+
+		while (!Text.empty() && std::isspace(static_cast<unsigned char>(Text.back())) != 0)
+		{
+			Text.remove_suffix(1);
+		}
 
-			if (std::regex_search(Line, Match, SectionTest))
+		if constexpr (std::is_same_v<T, std::string>)
+		{
+			Value.assign(Text);
+			return true;
+		}
+		else if constexpr (std::is_same_v<T, bool>)
+		{
+			if (Text == "true" || Text == "1")
 			{
-				CurrentSection = Match[1];
+				Value = true;
+				return true;
 			}
-			else if (std::regex_search(Line, Match, ValueTest) && (CurrentSection == Section && Match[1] == Key))
+
+			if (Text == "false" || Text == "0")
 			{
-				Line << Key << "=" << Value << "\n";
+				Value = false;
+				return true;
 			}
 
-			OutputINIFile << Line;
+			return false;
 		}
+		else if constexpr (std::is_same_v<T, char>)
+		{
+			if (Text.empty())
+			{
+				return false;
+			}
 
-		OutputINIFile.close();
+			Value = Text[0];
+			return true;
+		}
+		else if constexpr (std::is_arithmetic_v<T>)
+		{
+			// Like the stream extraction before - reads as far as the text is a number
+			// from_chars() does not take a "+" sign, the stream extraction did
+			if (Text.size() > 1 && Text[0] == '+' && Text[1] != '-')
+			{
+				Text.remove_prefix(1);
+			}
+
+			return std::from_chars(Text.data(), Text.data() + Text.size(), Value).ec == std::errc{};
+		}
+		else
+		{
+			std::istringstream Stream{ std::string(Text) };
+			return static_cast<bool>(Stream >> Value);
+		}
+	}
+
+	template<typename T>std::string INIDocument::ToText(const T& Value)
+	{
+		if constexpr (std::is_same_v<T, bool>)
+		{
+			return Value ? "true" : "false";
+		}
+		else
+		{
+			std::ostringstream Stream;
+			Stream << Value;
+			return Stream.str();
+		}
+	}
+
+	inline INIDocument& GetINIDocument(const std::string& INIFileName)
+	{
+		// Documents are parsed under the lock, so several loader threads never parse the same file twice
+		std::scoped_lock Lock(INIDocumentsMutex);
+		return FindINIDocument(INIFileName);
+	}
+
+	inline INIDocument& FindINIDocument(const std::string& INIFileName)
+	{
+		// INIDocumentsMutex must be held by the caller
+		const auto [Document, Inserted] { INIDocuments.try_emplace(INIFileName) };
+
+		if (Inserted)
+		{
+			Document->second.Load(INIFileName);
+		}
+
+		return Document->second;
+	}
+
+	inline void ReloadINIDocument(const std::string& INIFileName)
+	{
+		// Parsed in place, so references to the document stay valid
+		std::scoped_lock Lock(INIDocumentsMutex);
+		FindINIDocument(INIFileName).Load(INIFileName);
+	}
+
+	template<typename T>T ReadINIValue(const std::string& INIFileName, const std::string& Section, const std::string& Key)
+	{
+		T OutputVar{};
+		bool Found{};
+
+		{
+			std::scoped_lock Lock(INIDocumentsMutex);
+			Found = FindINIDocument(INIFileName).TryGet(Section, Key, OutputVar);
+		}
+
+		if (!Found)
+		{
+			LWMFSystemLog.AddEntry(LogLevel::Error, __FILENAME__, __LINE__, "Value [" + Section + "] / " + Key + " not found in " + INIFileName + "!");
+		}
+
+		return OutputVar;
+	}
+
+	template<typename T>void WriteINIValue(const std::string& Section, const std::string& Key, const T Value, const std::string& INIFileName)
+	{
+		LWMFSystemLog.AddEntry(LogLevel::Info, __FILENAME__, __LINE__, "Writing value to INI file " + INIFileName + " [" + Section + "] / " + Key);
+
+		// Set() changes the cached document other threads read from
+		std::scoped_lock Lock(INIDocumentsMutex);
+		INIDocument& Document{ FindINIDocument(INIFileName) };
+		Document.Set(Section, Key, Value);
+		Document.Save();
 	}
 
 	inline std::int_fast32_t ReadINIValueRGBA(const std::string& INIFileName, const std::string& Section)
 	{
-		return RGBAtoINT(std::clamp(ReadINIValue<std::int_fast32_t>(INIFileName, Section, "Red"), 0, 255),
-							std::clamp(ReadINIValue<std::int_fast32_t>(INIFileName, Section, "Green"), 0, 255),
-							std::clamp(ReadINIValue<std::int_fast32_t>(INIFileName, Section, "Blue"), 0, 255),
-							std::clamp(ReadINIValue<std::int_fast32_t>(INIFileName, Section, "Alpha"), 0, 255));
+		std::int_fast32_t Red{};
+		std::int_fast32_t Green{};
+		std::int_fast32_t Blue{};
+		std::int_fast32_t Alpha{};
+		std::int_fast32_t Found{};
+
+		{
+			std::scoped_lock Lock(INIDocumentsMutex);
+			Found = FindINIDocument(INIFileName).GetValues(Section, INIBinding{ "Red", Red }, INIBinding{ "Green", Green }, INIBinding{ "Blue", Blue }, INIBinding{ "Alpha", Alpha });
+		}
+
+		if (Found != 4)
+		{
+			LWMFSystemLog.AddEntry(LogLevel::Error, __FILENAME__, __LINE__, "RGBA values of [" + Section + "] not found in " + INIFileName + "!");
+		}
+
+		return RGBAtoINT(std::clamp(Red, 0, 255), std::clamp(Green, 0, 255), std::clamp(Blue, 0, 255), std::clamp(Alpha, 0, 255));
 	}
 
 
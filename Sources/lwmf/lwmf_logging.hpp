@@ -34,6 +34,7 @@
 #include <sstream>
 #include <ctime>
 #include <iomanip>
+#include <mutex>
 
 // #define LWMF_LOGGINGENABLED in your application if you want to write any logsfiles
 #ifdef LWMF_LOGGINGENABLED
@@ -79,6 +80,8 @@ namespace lwmf
 		static std::string GetLocalTime();
 
 		std::ofstream Logfile;
+		// Entries may come from worker threads (e.g. the asset loader)
+		std::mutex LogMutex;
 	};
 
 	inline Logging::Logging(const std::string& Logfilename)
@@ -114,6 +117,8 @@ namespace lwmf
 
 	inline void Logging::AddEntry(const LogLevel Level, const char* Filename, const std::int_fast32_t LineNumber, const std::string_view Message)
 	{
+		const std::scoped_lock Lock(LogMutex);
+
 		if (LoggingEnabled && Logfile.is_open())
 		{
 			std::map<LogLevel, std::string_view> ErrorTable
@@ -0,0 +1,137 @@
+/*
+****************************************************
+*                                                  *
+* lwmf_mappedfile - lightweight media framework    *
+*                                                  *
+* (C) 2019 - present by Stefan Kubsch              *
+*                                                  *
+****************************************************
+*/
+
+#pragma once
+
+#define NOMINMAX
+#include <windows.h>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+#include "lwmf_logging.hpp"
+
+namespace lwmf
+{
+
+
+	// Read-only memory mapping of a whole file
+	// Nothing is read or copied up front - the pages are loaded by the OS on first access
+
+	class MappedFile final
+	{
+	public:
+		MappedFile() = default;
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+		~MappedFile();
+
+		bool Open(const std::string& Filename);
+		void Close();
+		const std::byte* GetData() const;
+		std::size_t GetSize() const;
+		bool IsOpen() const;
+
+	private:
+		HANDLE FileHandle{ INVALID_HANDLE_VALUE };
+		HANDLE MappingHandle{};
+		const std::byte* View{};
+		std::size_t ViewSize{};
+	};
+
+	inline MappedFile::~MappedFile()
+	{
+		Close();
+	}
+
+	inline bool MappedFile::Open(const std::string& Filename)
+	{
+		Close();
+
+		FileHandle = CreateFileA(Filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+		if (FileHandle == INVALID_HANDLE_VALUE)
+		{
+			LWMFSystemLog.AddEntry(LogLevel::Warn, __FILENAME__, __LINE__, "Could not open " + Filename + " for mapping!");
+			return false;
+		}
+
+		LARGE_INTEGER FileSize{};
+
+		// Empty files can not be mapped
+		if (GetFileSizeEx(FileHandle, &FileSize) == 0 || FileSize.QuadPart == 0)
+		{
+			LWMFSystemLog.AddEntry(LogLevel::Warn, __FILENAME__, __LINE__, "Could not get size of " + Filename + " or file is empty!");
+			Close();
+			return false;
+		}
+
+		MappingHandle = CreateFileMappingA(FileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+		if (MappingHandle == nullptr)
+		{
+			LWMFSystemLog.AddEntry(LogLevel::Warn, __FILENAME__, __LINE__, "CreateFileMapping() failed for " + Filename + "!");
+			Close();
+			return false;
+		}
+
+		View = static_cast<const std::byte*>(MapViewOfFile(MappingHandle, FILE_MAP_READ, 0, 0, 0));
+
+		if (View == nullptr)
+		{
+			LWMFSystemLog.AddEntry(LogLevel::Warn, __FILENAME__, __LINE__, "MapViewOfFile() failed for " + Filename + "!");
+			Close();
+			return false;
+		}
+
+		ViewSize = static_cast<std::size_t>(FileSize.QuadPart);
+		return true;
+	}
+
+	inline void MappedFile::Close()
+	{
+		if (View != nullptr)
+		{
+			UnmapViewOfFile(View);
+			View = nullptr;
+		}
+
+		if (MappingHandle != nullptr)
+		{
+			CloseHandle(MappingHandle);
+			MappingHandle = nullptr;
+		}
+
+		if (FileHandle != INVALID_HANDLE_VALUE)
+		{
+			CloseHandle(FileHandle);
+			FileHandle = INVALID_HANDLE_VALUE;
+		}
+
+		ViewSize = 0;
+	}
+
+	inline const std::byte* MappedFile::GetData() const
+	{
+		return View;
+	}
+
+	inline std::size_t MappedFile::GetSize() const
+	{
+		return ViewSize;
+	}
+
+	inline bool MappedFile::IsOpen() const
+	{
+		return View != nullptr;
+	}
+
+
+} // namespace lwmf
@@ -19,7 +19,6 @@
 #include <algorithm>
 #include <iostream>
 #include <map>
-#include <fstream>
 #include <mmsystem.h>
 #include <mmreg.h>
 #include <msacm.h>
@@ -33,6 +32,7 @@
 #pragma comment(lib, "Shlwapi.lib")
 
 #include "lwmf_logging.hpp"
+#include "lwmf_fileaccess.hpp"
 
 namespace lwmf
 {
@@ -115,9 +115,9 @@ namespace lwmf
 		//
 
 		LWMFSystemLog.AddEntry(LogLevel::Info, __FILENAME__, __LINE__, "Reading MP3 header of " + Filename);
-		std::ifstream File(Filename.c_str(), std::ios::in | std::ios::binary);
+		std::vector<BYTE> InputBuffer{};
 
-		if (File.fail())
+		if (!ReadFile(Filename, InputBuffer))
 		{
 			std::array<char, 100> ErrorMessage{};
 			strerror_s(ErrorMessage.data(), 100, errno);
@@ -128,24 +128,22 @@ namespace lwmf
 		{
 			AudioName = Filename;
 
-			std::int_fast32_t StreamChar{};
+			// Search for header informations (frame sync)
+			std::size_t HeaderPos{};
 
-			// Search for header informations
-			while (true)
+			while (HeaderPos + 3 < InputBuffer.size() && !(InputBuffer[HeaderPos] == 255 && InputBuffer[HeaderPos + 1] >> 4 == 15))
 			{
-				StreamChar = File.get();
-
-				if (StreamChar == 255)
-				{
-					StreamChar = File.get();
+				++HeaderPos;
+			}
 
-					if (StreamChar >> 4 == 15)
-					{
-						break;
-					}
-				}
+			if (HeaderPos + 3 >= InputBuffer.size())
+			{
+				LWMFSystemLog.AddEntry(LogLevel::Error, __FILENAME__, __LINE__, "No MP3 header found in " + Filename + "!");
+				return;
 			}
 
+			std::int_fast32_t StreamChar{ InputBuffer[HeaderPos + 1] };
+
 			// Check if file is MPEG Version 1
 			if (((StreamChar & 15) >> 2) >> 1 != 1)
 			{
@@ -153,7 +151,7 @@ namespace lwmf
 			}
 
 			// Get Bitrate
-			StreamChar = File.get();
+			StreamChar = InputBuffer[HeaderPos + 2];
 			constexpr std::array<std::int_fast32_t, 16> BitrateTable{ 0x000, 0x020, 0x028, 0x030, 0x038, 0x040, 0x050, 0x060, 0x070, 0x080, 0x0A0, 0x0C0, 0x0E0, 0x100, 0x140, 0x000 };
 			Bitrate = BitrateTable[StreamChar >> 4];
 			LWMFSystemLog.AddEntry(LogLevel::Info, __FILENAME__, __LINE__, "Bitrate: " + std::to_string(Bitrate));
@@ -164,7 +162,7 @@ namespace lwmf
 			LWMFSystemLog.AddEntry(LogLevel::Info, __FILENAME__, __LINE__, "Samplerate: " + std::to_string(SampleRate));
 
 			// Get number of channels
-			StreamChar = File.get();
+			StreamChar = InputBuffer[HeaderPos + 3];
 
 			// NumberOfChannels is per default initialized with "2"
 			// Set only to "1" if "Single Channel" is detected...
@@ -190,28 +188,13 @@ namespace lwmf
 			const WORD nBlockAlign{ static_cast<WORD>((NumberOfChannels * 16) / 8) };
 			PCMFormat = { WAVE_FORMAT_PCM, NumberOfChannels, SampleRate, SampleRate * nBlockAlign, nBlockAlign, 16, 0 };
 
-			std::size_t FileSize{};
-
-			if (File.seekg(0, std::ios::end).good())
-			{
-				FileSize = File.tellg();
-			}
-
-			if (File.seekg(0, std::ios::beg).good())
-			{
-				FileSize -= File.tellg();
-			}
-
-			std::vector<BYTE> InputBuffer(FileSize);
-			File.read(reinterpret_cast<char*>(InputBuffer.data()), FileSize);
-
 			CheckHRESError(CoInitializeEx(nullptr, COINIT_MULTITHREADED), "CoInitializeEx", LogLevel::Critical);
 
 			// Create a local scope for working with the CComPtrs...
 			{
 				CComPtr<IWMSyncReader> SyncReader{};
 				CheckHRESError(WMCreateSyncReader(nullptr, WMT_RIGHT_PLAYBACK, &SyncReader), "WMCreateSyncReader", LogLevel::Error);
-				const CComPtr<IStream> MP3Stream{ SHCreateMemStream(InputBuffer.data(), static_cast<UINT>(FileSize)) };
+				const CComPtr<IStream> MP3Stream{ SHCreateMemStream(InputBuffer.data(), static_cast<UINT>(InputBuffer.size())) };
 				CheckHRESError(SyncReader->OpenStream(MP3Stream), "OpenStream", LogLevel::Error);
 
 				CComPtr<IWMHeaderInfo> HeaderInfo{};
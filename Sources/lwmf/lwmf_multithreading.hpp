@@ -35,14 +35,18 @@ namespace lwmf
 		~Multithreading();
 
 		template<class F, class... Args>void AddThread(F&& f, Args&& ... args);
+		template<class F, class... Args>std::future<std::invoke_result_t<F, Args...>> AddBackgroundThread(F&& f, Args&& ... args);
 		void WaitForThreads();
 
 	private:
 		std::vector<std::thread> Workers{};
 		std::vector<std::future<void>> Results{};
 		std::queue<std::packaged_task<void()>> Tasks{};
+		std::queue<std::packaged_task<void()>> BackgroundTasks{};
 		std::mutex QueueMutex{};
 		std::condition_variable Condition{};
+		std::size_t MaxBackgroundWorkers{};
+		std::size_t BackgroundWorkers{};
 		bool Stop{};
 	};
 
@@ -50,6 +54,8 @@ namespace lwmf
 	{
 		const std::size_t NumberOfThreads{ static_cast<std::size_t>(std::thread::hardware_concurrency()) };
 		Workers.reserve(NumberOfThreads);
+		// At least one worker is always free for the tasks WaitForThreads() waits for
+		MaxBackgroundWorkers = NumberOfThreads > 1 ? NumberOfThreads - 1 : 1;
 		LWMFSystemLog.AddEntry(LogLevel::Trace, __FILENAME__, __LINE__, "lwmf::Multithreading() (variable name:NumberOfThreads, value: " + std::to_string(NumberOfThreads) + ")");
 
 		for (std::size_t i{}; i < NumberOfThreads; ++i)
@@ -59,20 +65,42 @@ namespace lwmf
 				while (true)
 				{
 					std::packaged_task<void()> Task;
+					bool Background{};
 					{
 						std::unique_lock<std::mutex> lock(QueueMutex);
-						Condition.wait(lock, [this] { return Stop || !Tasks.empty(); });
+						Condition.wait(lock, [this] { return Stop || !Tasks.empty() || (!BackgroundTasks.empty() && BackgroundWorkers < MaxBackgroundWorkers); });
 
-						if (Stop && Tasks.empty())
+						if (Stop && Tasks.empty() && BackgroundTasks.empty())
 						{
 							return;
 						}
 
-						Task = std::move(Tasks.front());
-						Tasks.pop();
+						// Tasks first - background tasks only run if none is waiting
+						if (!Tasks.empty())
+						{
+							Task = std::move(Tasks.front());
+							Tasks.pop();
+						}
+						else
+						{
+							Task = std::move(BackgroundTasks.front());
+							BackgroundTasks.pop();
+							++BackgroundWorkers;
+							Background = true;
+						}
 					}
 
 					Task();
+
+					if (Background)
+					{
+						{
+							const std::unique_lock<std::mutex> lock(QueueMutex);
+							--BackgroundWorkers;
+						}
+
+						Condition.notify_one();
+					}
 				}
 			});
 		}
@@ -106,6 +134,24 @@ namespace lwmf
 		Condition.notify_one();
 	}
 
+	// Background threads are not tracked by WaitForThreads(), the caller owns the returned future
+	// They have their own queue which is only served if no other task is waiting, and they never occupy all workers
+	// This way long running jobs (e.g. pathfinding) do not block the per-frame render and think threads
+
+	template<class F, class... Args>std::future<std::invoke_result_t<F, Args...>> Multithreading::AddBackgroundThread(F&& f, Args&& ... args)
+	{
+		std::packaged_task<std::invoke_result_t<F, Args...>()> Task([func = std::forward<F>(f), args = std::make_tuple(std::forward<Args>(args)...)]()
+		{
+			return std::apply(func, std::move(args));
+		});
+
+		std::future<std::invoke_result_t<F, Args...>> Result{ Task.get_future() };
+		const std::unique_lock<std::mutex> lock(QueueMutex);
+		BackgroundTasks.emplace(std::move(Task));
+		Condition.notify_one();
+		return Result;
+	}
+
 	inline void Multithreading::WaitForThreads()
 	{
 		for (const auto& Result : Results)
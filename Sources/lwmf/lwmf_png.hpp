@@ -11,13 +11,16 @@
 #pragma once
 
 #include <cstdint>
+#include <cstring>
 #include <string>
 #include <vector>
 #include <array>
+#include <utility>
 #include <iostream>
-#include <fstream>
+#include <intrin.h>
 
 #include "lwmf_logging.hpp"
+#include "lwmf_fileaccess.hpp"
 #include "lwmf_texture.hpp"
 #include "lwmf_color.hpp"
 
@@ -26,6 +29,7 @@ namespace lwmf
 
 
 	void LoadPNG(TextureStruct& Texture, const std::string& FileName);
+	void DecodePNG(TextureStruct& Texture, const std::vector<unsigned char>& Buffer, const std::string& FileName);
 
 	//
 	// Variables and constants
@@ -43,423 +47,508 @@ namespace lwmf
 
 	struct Zlib
 	{
-		inline static std::int_fast32_t ReadBitFromStream(std::int_fast32_t& Bit, const unsigned char* Bits)
+		// LSB-first bit reader with a 64 bit buffer
+		// A refill loads a whole word, so decoding a length/distance pair (at most 48 bits) needs just one refill
+		// Beyond the end of the stream zero bits are shifted in - Overrun() tells if any of them were consumed
+		struct BitReader
 		{
-			const std::int_fast32_t Result{ static_cast<std::int_fast32_t>((Bits[Bit >> 3] >> (Bit & 0x7)) & 1) };
-			++Bit;
+			const unsigned char* Data{};
+			const unsigned char* End{};
+			std::uint64_t Buffer{};
+			std::int_fast32_t Count{};
+			std::int_fast32_t PaddingBits{};
 
-			return Result;
-		}
+			inline void Refill()
+			{
+				if (End - Data >= 8)
+				{
+					// x86 is little endian - the loaded word is the next 64 bits of the stream
+					std::uint64_t Word{};
+					std::memcpy(&Word, Data, sizeof(Word));
+					Buffer |= Word << Count;
+					Data += (63 - Count) >> 3;
+					Count |= 56;
+				}
+				else
+				{
+					while (Count < 56)
+					{
+						if (Data < End)
+						{
+							Buffer |= static_cast<std::uint64_t>(*Data++) << Count;
+						}
+						else
+						{
+							PaddingBits += 8;
+						}
 
-		inline static std::int_fast32_t ReadBitsFromStream(std::int_fast32_t& Bit, const unsigned char* Bits, const std::int_fast32_t NBits)
-		{
-			std::int_fast32_t Result{};
+						Count += 8;
+					}
+				}
+			}
 
-			for (std::int_fast32_t i{}; i < NBits; ++i)
+			inline std::int_fast32_t ReadBits(const std::int_fast32_t NBits)
 			{
-				Result += (ReadBitFromStream(Bit, Bits)) << i;
+				const std::int_fast32_t Result{ static_cast<std::int_fast32_t>(Buffer & ((1ULL << NBits) - 1)) };
+				Consume(NBits);
+
+				return Result;
 			}
 
-			return Result;
-		}
+			inline void Consume(const std::int_fast32_t NBits)
+			{
+				Buffer >>= NBits;
+				Count -= NBits;
+			}
+
+			inline void AlignToByte()
+			{
+				// Puts the bytes which are still buffered back, so stored blocks can be copied straight from the input
+				Consume(Count & 7);
+				Data -= (Count - std::min(Count, PaddingBits)) >> 3;
+				Buffer = 0;
+				Count = 0;
+				PaddingBits = 0;
+			}
 
-		struct HuffmanTree
+			inline bool Overrun() const
+			{
+				return Count < PaddingBits;
+			}
+		};
+
+		// Canonical Huffman code as lookup table
+		// The first FastBits bits index the primary table, longer codes continue in a sub table behind it
+		// Entry: symbol (bits 0 - 15), code length (bits 16 - 23) - or for a sub table: offset (bits 0 - 15), index bits (bits 16 - 23) and the SubTable flag
+		struct HuffmanTable
 		{
-			inline std::int_fast32_t MakeFromLengths(const std::vector<std::int_fast32_t>& BitLength, const std::int_fast32_t MaximumBitLength)
+			static constexpr std::uint32_t SubTable{ 1U << 24 };
+			static constexpr std::int_fast32_t MaximumBitLength{ 15 };
+
+			inline std::int_fast32_t Build(const std::int_fast32_t* BitLength, const std::int_fast32_t NumCodes, const std::int_fast32_t TableBits)
 			{
-				const std::int_fast32_t NumCodes{ static_cast<std::int_fast32_t>(BitLength.size()) };
-				std::int_fast32_t TreePos{};
-				std::int_fast32_t NodeFilled{};
-				std::vector<std::int_fast32_t> Tree1D(NumCodes);
-				std::vector<std::int_fast32_t> BitLengthCount(MaximumBitLength + 1, 0);
-				std::vector<std::int_fast32_t> NextCode(MaximumBitLength + 1, 0);
-
-				for (std::int_fast32_t Bits{}; Bits < NumCodes; ++Bits)
+				std::array<std::int_fast32_t, MaximumBitLength + 1> BitLengthCount{};
+				std::array<std::uint_fast32_t, MaximumBitLength + 1> NextCode{};
+
+				for (std::int_fast32_t n{}; n < NumCodes; ++n)
 				{
-					++BitLengthCount[BitLength[Bits]];
+					if (BitLength[n] < 0 || BitLength[n] > MaximumBitLength)
+					{
+						return 55;
+					}
+
+					++BitLengthCount[BitLength[n]];
+				}
+
+				BitLengthCount[0] = 0;
+
+				// Over-subscribed codes are invalid, incomplete ones are allowed (e.g. a distance code with just one symbol)
+				for (std::int_fast32_t Bits{ 1 }, Left{ 1 }; Bits <= MaximumBitLength; ++Bits)
+				{
+					Left = (Left << 1) - BitLengthCount[Bits];
+
+					if (Left < 0)
+					{
+						return 55;
+					}
 				}
 
 				for (std::int_fast32_t Bits{ 1 }; Bits <= MaximumBitLength; ++Bits)
 				{
-					NextCode[Bits] = (NextCode[Bits - 1] + BitLengthCount[Bits - 1]) << 1;
+					NextCode[Bits] = (NextCode[Bits - 1] + static_cast<std::uint_fast32_t>(BitLengthCount[Bits - 1])) << 1;
 				}
 
+				FastBits = TableBits;
+				const std::uint_fast32_t FastMask{ (1U << FastBits) - 1 };
+				std::vector<std::uint_fast32_t> Codes(static_cast<std::size_t>(NumCodes));
+				std::vector<std::int_fast32_t> SubTableBits(static_cast<std::size_t>(1) << FastBits);
+
 				for (std::int_fast32_t n{}; n < NumCodes; ++n)
 				{
 					if (BitLength[n] != 0)
 					{
-						Tree1D[n] = NextCode[BitLength[n]]++;
+						Codes[n] = ReverseBits(NextCode[BitLength[n]]++, BitLength[n]);
+
+						if (BitLength[n] > FastBits)
+						{
+							std::int_fast32_t& Bits{ SubTableBits[Codes[n] & FastMask] };
+							Bits = std::max(Bits, BitLength[n] - FastBits);
+						}
 					}
 				}
 
-				Tree2D.clear();
-				Tree2D.shrink_to_fit();
-				Tree2D.resize((static_cast<std::size_t>(NumCodes) << 1), 32767);
+				Entries.assign(static_cast<std::size_t>(1) << FastBits, 0);
+
+				for (std::uint_fast32_t Prefix{}; Prefix <= FastMask; ++Prefix)
+				{
+					if (SubTableBits[Prefix] != 0)
+					{
+						Entries[Prefix] = SubTable | (static_cast<std::uint32_t>(SubTableBits[Prefix]) << 16) | static_cast<std::uint32_t>(Entries.size());
+						Entries.resize(Entries.size() + (static_cast<std::size_t>(1) << SubTableBits[Prefix]), 0);
+					}
+				}
 
 				for (std::int_fast32_t n{}; n < NumCodes; ++n)
 				{
-					for (std::int_fast32_t i{}; i < BitLength[n]; ++i)
+					const std::int_fast32_t Length{ BitLength[n] };
+					const std::uint32_t Entry{ (static_cast<std::uint32_t>(Length) << 16) | static_cast<std::uint32_t>(n) };
+
+					if (Length == 0)
+					{
+						continue;
+					}
+
+					// A code fills every slot whose low bits match it
+					if (Length <= FastBits)
 					{
-						if (TreePos > NumCodes - 2)
+						for (std::uint_fast32_t Index{ Codes[n] }; Index <= FastMask; Index += (1U << Length))
 						{
-							return 55;
+							Entries[Index] = Entry;
 						}
+					}
+					else
+					{
+						const std::uint32_t Pointer{ Entries[Codes[n] & FastMask] };
+						const std::uint_fast32_t Offset{ Pointer & 0xFFFF };
+						const std::uint_fast32_t Size{ 1U << ((Pointer >> 16) & 0xFF) };
 
-						const std::int_fast32_t Bit{ (Tree1D[n] >> (BitLength[n] - i - 1)) & 1 };
-
-						Tree2D[2 * TreePos + Bit] == 32767 ? (i + 1 == BitLength[n] ? (Tree2D[2 * TreePos + Bit] = n, TreePos = 0) : (Tree2D[2 * TreePos + Bit] = ++NodeFilled + NumCodes, TreePos = NodeFilled)) : TreePos = Tree2D[2 * TreePos + Bit] - NumCodes;
+						for (std::uint_fast32_t Index{ Codes[n] >> FastBits }; Index < Size; Index += (1U << (Length - FastBits)))
+						{
+							Entries[Offset + Index] = Entry;
+						}
 					}
 				}
 
 				return 0;
 			}
 
-			inline std::int_fast32_t Decode(bool& Decoded, std::int_fast32_t& Result, std::int_fast32_t& TreePos, const std::int_fast32_t Bit) const
+			// Expects at least MaximumBitLength buffered bits - returns -1 for an invalid code
+			inline std::int_fast32_t Decode(BitReader& Reader) const
 			{
-				const std::int_fast32_t NumCodes{ static_cast<std::int_fast32_t>(Tree2D.size()) >> 1 };
+				std::uint32_t Entry{ Entries[Reader.Buffer & ((1U << FastBits) - 1)] };
 
-				if (TreePos >= NumCodes)
+				if ((Entry & SubTable) != 0)
 				{
-					return 11;
+					Entry = Entries[(Entry & 0xFFFF) + ((Reader.Buffer >> FastBits) & ((1U << ((Entry >> 16) & 0xFF)) - 1))];
 				}
 
-				Result = Tree2D[2 * TreePos + Bit];
-				Decoded = (Result < NumCodes);
-				TreePos = Decoded ? 0 : Result - NumCodes;
+				const std::int_fast32_t Length{ static_cast<std::int_fast32_t>((Entry >> 16) & 0xFF) };
 
-				return 0;
+				if (Length == 0)
+				{
+					return -1;
+				}
+
+				Reader.Consume(Length);
+				return static_cast<std::int_fast32_t>(Entry & 0xFFFF);
+			}
+
+			static inline std::uint_fast32_t ReverseBits(std::uint_fast32_t Code, const std::int_fast32_t Length)
+			{
+				std::uint_fast32_t Result{};
+
+				for (std::int_fast32_t i{}; i < Length; ++i)
+				{
+					Result = (Result << 1) | (Code & 1);
+					Code >>= 1;
+				}
+
+				return Result;
 			}
 
-			std::vector<std::int_fast32_t> Tree2D;
+			std::vector<std::uint32_t> Entries{};
+			std::int_fast32_t FastBits{};
 		};
 
 		struct Inflator
 		{
+			static constexpr std::int_fast32_t LiteralTableBits{ 10 };
+			static constexpr std::int_fast32_t DistanceTableBits{ 8 };
+			static constexpr std::int_fast32_t CodeLengthTableBits{ 7 };
+			// Room behind the output, so matches can be copied in 8 byte steps
+			static constexpr std::size_t CopySlack{ 8 };
+
 			std::int_fast32_t Error{};
 
-			inline void Inflate(std::vector<unsigned char>& Out, const std::vector<unsigned char>& In, const std::int_fast32_t InPos = 0)
+			// Out should already have the expected size - it only grows if the stream holds more data
+			inline void Inflate(std::vector<unsigned char>& Out, const unsigned char* In, const std::size_t InLength)
 			{
-				std::int_fast32_t BP{};
-				std::int_fast32_t Pos{};
+				BitReader Reader{ In, In + InLength };
+				std::size_t Pos{};
 				std::int_fast32_t Final{};
 				Error = 0;
 
+				Out.resize(Out.size() + CopySlack);
+
 				while (Final == 0 && Error == 0)
 				{
-					if (BP >> 3 >= static_cast<std::int_fast32_t>(In.size()))
-					{
-						Error = 52;
-						return;
-					}
+					Reader.Refill();
 
-					Final = ReadBitFromStream(BP, &In[InPos]);
-					std::int_fast32_t BTYPE{ ReadBitFromStream(BP, &In[InPos]) };
-					BTYPE += (ReadBitFromStream(BP, &In[InPos]) << 1);
+					Final = Reader.ReadBits(1);
+					const std::int_fast32_t BTYPE{ Reader.ReadBits(2) };
 
-					if (BTYPE == 3)
+					switch (BTYPE)
 					{
-						Error = 20;
-						return;
+						case 0:
+						{
+							InflateNoCompression(Out, Reader, Pos);
+							break;
+						}
+						case 1:
+						{
+							// The fixed codes are the same for every image
+							static const std::array<HuffmanTable, 2> FixedTables{ GenerateFixedTables() };
+							InflateHuffmanBlock(Out, Reader, Pos, FixedTables[0], FixedTables[1]);
+							break;
+						}
+						case 2:
+						{
+							GetTablesInflateDynamic(Reader);
+
+							if (Error == 0)
+							{
+								InflateHuffmanBlock(Out, Reader, Pos, CodeTable, CodeTableD);
+							}
+
+							break;
+						}
+						default:
+						{
+							Error = 20;
+						}
 					}
 
-					BTYPE == 0 ? InflateNoCompression(Out, &In[InPos], BP, Pos, static_cast<std::int_fast32_t>(In.size())) : InflateHuffmanBlock(Out, &In[InPos], BP, Pos, static_cast<std::int_fast32_t>(In.size()), BTYPE);
+					if (Error == 0 && Reader.Overrun())
+					{
+						Error = 52;
+					}
 				}
 
 				if (Error == 0)
 				{
-					Out.resize(static_cast<std::size_t>(Pos));
+					Out.resize(Pos);
 				}
 			}
 
-			static inline void GenerateFixedTrees(HuffmanTree& Tree, HuffmanTree& TreeD)
+			static inline std::array<HuffmanTable, 2> GenerateFixedTables()
 			{
-				std::vector<std::int_fast32_t> BitLength(288, 8);
-				const std::vector<std::int_fast32_t> BitLengthD(32, 5);
+				std::array<std::int_fast32_t, 288> BitLength{};
+				std::array<std::int_fast32_t, 32> BitLengthD{};
+				std::array<HuffmanTable, 2> Tables{};
 
-				for (std::int_fast32_t i{ 144 }; i <= 255; ++i)
-				{
-					BitLength[i] = 9;
-				}
+				std::fill(BitLength.begin(), BitLength.begin() + 144, 8);
+				std::fill(BitLength.begin() + 144, BitLength.begin() + 256, 9);
+				std::fill(BitLength.begin() + 256, BitLength.begin() + 280, 7);
+				std::fill(BitLength.begin() + 280, BitLength.end(), 8);
+				BitLengthD.fill(5);
 
-				for (std::int_fast32_t i{ 256 }; i <= 279; ++i)
-				{
-					BitLength[i] = 7;
-				}
+				Tables[0].Build(BitLength.data(), static_cast<std::int_fast32_t>(BitLength.size()), LiteralTableBits);
+				Tables[1].Build(BitLengthD.data(), static_cast<std::int_fast32_t>(BitLengthD.size()), DistanceTableBits);
 
-				Tree.MakeFromLengths(BitLength, 15);
-				TreeD.MakeFromLengths(BitLengthD, 15);
+				return Tables;
 			}
 
-			HuffmanTree CodeTree;
-			HuffmanTree CodeTreeD;
-			HuffmanTree CodeLengthCodeTree;
+			HuffmanTable CodeTable;
+			HuffmanTable CodeTableD;
+			HuffmanTable CodeLengthCodeTable;
 
-			inline std::int_fast32_t HuffmanDecodeSymbol(const unsigned char* In, std::int_fast32_t& BP, const HuffmanTree& HuffCodeTree, const std::int_fast32_t InLength)
+			inline void GetTablesInflateDynamic(BitReader& Reader)
 			{
-				bool Decoded{};
+				Reader.Refill();
 
-				for (std::int_fast32_t CT{}, TreePos{};;)
-				{
-					if ((BP & 0x07) == 0 && (BP >> 3) > InLength)
-					{
-						Error = 10;
-						return 0;
-					}
+				const std::int_fast32_t HLit{ Reader.ReadBits(5) + 257 };
+				const std::int_fast32_t HDist{ Reader.ReadBits(5) + 1 };
+				const std::int_fast32_t HCLength{ Reader.ReadBits(4) + 4 };
+				std::array<std::int_fast32_t, 19> CodeLengthCode{};
 
-					Error = HuffCodeTree.Decode(Decoded, CT, TreePos, ReadBitFromStream(BP, In));
-
-					if (Error != 0)
-					{
-						return 0;
-					}
-
-					if (Decoded)
-					{
-						return CT;
-					}
-				}
-			}
-
-			inline void GetTreeInflateDynamic(HuffmanTree& Tree, HuffmanTree& TreeD, const unsigned char* In, std::int_fast32_t& BP, const std::int_fast32_t InLength)
-			{
-				if (BP >> 3 >= InLength - 2)
+				for (std::int_fast32_t i{}; i < HCLength; ++i)
 				{
-					Error = 49;
-					return;
+					Reader.Refill();
+					CodeLengthCode[CLCL[i]] = Reader.ReadBits(3);
 				}
 
-				const std::int_fast32_t HLit{ ReadBitsFromStream(BP, In, 5) + 257 };
-				const std::int_fast32_t HDist{ ReadBitsFromStream(BP, In, 5) + 1 };
-				const std::int_fast32_t HCLength{ ReadBitsFromStream(BP, In, 4) + 4 };
-				std::vector<std::int_fast32_t> CodeLengthCode(19);
-
-				for (std::int_fast32_t i{}; i < 19; ++i)
-				{
-					CodeLengthCode[CLCL[i]] = (i < HCLength) ? ReadBitsFromStream(BP, In, 3) : 0;
-				}
-
-				Error = CodeLengthCodeTree.MakeFromLengths(CodeLengthCode, 7);
+				Error = CodeLengthCodeTable.Build(CodeLengthCode.data(), static_cast<std::int_fast32_t>(CodeLengthCode.size()), CodeLengthTableBits);
 
 				if (Error != 0)
 				{
 					return;
 				}
 
-				std::vector<std::int_fast32_t> BitLength(288, 0);
-				std::vector<std::int_fast32_t> BitLengthD(32, 0);
+				// Literal/length and distance code lengths are one sequence - repeats may cross from one into the other
+				std::array<std::int_fast32_t, 320> BitLength{};
 				std::int_fast32_t i{};
-				std::int_fast32_t RepeatLength{};
 
 				while (i < HLit + HDist)
 				{
-					if (Error != 0)
+					Reader.Refill();
+
+					const std::int_fast32_t Code{ CodeLengthCodeTable.Decode(Reader) };
+					std::int_fast32_t RepeatLength{};
+					std::int_fast32_t Value{};
+
+					if (Code < 0)
 					{
+						Error = 16;
 						return;
 					}
 
-					const std::int_fast32_t Code{ HuffmanDecodeSymbol(In, BP, CodeLengthCodeTree, InLength) };
-
 					if (Code <= 15)
 					{
-						i < HLit ? BitLength[i++] = Code : BitLengthD[i++ - HLit] = Code;
+						BitLength[i++] = Code;
+						continue;
 					}
-					else if (Code == 16)
+
+					if (Code == 16)
 					{
-						if (BP >> 3 >= InLength)
+						if (i == 0)
 						{
-							Error = 50;
+							Error = 54;
 							return;
 						}
 
-						RepeatLength = 3 + ReadBitsFromStream(BP, In, 2);
-						const std::int_fast32_t Value{ (i - 1) < HLit ? BitLength[i - 1] : BitLengthD[i - HLit - 1] };
-
-						for (std::int_fast32_t n{}; n < RepeatLength; ++n)
-						{
-							if (i >= HLit + HDist)
-							{
-								Error = 13;
-								return;
-							}
-
-							i < HLit ? BitLength[i++] = Value : BitLengthD[i++ - HLit] = Value;
-						}
+						RepeatLength = 3 + Reader.ReadBits(2);
+						Value = BitLength[i - 1];
 					}
 					else if (Code == 17)
 					{
-						if (BP >> 3 >= InLength)
-						{
-							Error = 50;
-							return;
-						}
-
-						RepeatLength = 3 + ReadBitsFromStream(BP, In, 3);
-
-						for (std::int_fast32_t n{}; n < RepeatLength; ++n)
-						{
-							if (i >= HLit + HDist)
-							{
-								Error = 14;
-								return;
-							}
-
-							i < HLit ? BitLength[i++] = 0 : BitLengthD[i++ - HLit] = 0;
-						}
+						RepeatLength = 3 + Reader.ReadBits(3);
 					}
-					else if (Code == 18)
+					else
 					{
-						if (BP >> 3 >= InLength)
-						{
-							Error = 50;
-							return;
-						}
-
-						RepeatLength = 11 + ReadBitsFromStream(BP, In, 7);
-
-						for (std::int_fast32_t n{}; n < RepeatLength; ++n)
-						{
-							if (i >= HLit + HDist)
-							{
-								Error = 15;
-								return;
-							}
-
-							i < HLit ? BitLength[i++] = 0 : BitLengthD[i++ - HLit] = 0;
-						}
+						RepeatLength = 11 + Reader.ReadBits(7);
 					}
-					else
+
+					if (i + RepeatLength > HLit + HDist)
 					{
-						Error = 16;
+						Error = 13;
 						return;
 					}
+
+					std::fill(BitLength.begin() + i, BitLength.begin() + i + RepeatLength, Value);
+					i += RepeatLength;
 				}
 
-				if (BitLength[256] == 0)
+				if (Reader.Overrun())
 				{
-					Error = 64;
+					Error = 50;
 					return;
 				}
 
-				Error = Tree.MakeFromLengths(BitLength, 15);
-
-				if (Error != 0)
+				if (BitLength[256] == 0)
 				{
+					Error = 64;
 					return;
 				}
 
-				Error = TreeD.MakeFromLengths(BitLengthD, 15);
+				Error = CodeTable.Build(BitLength.data(), HLit, LiteralTableBits);
 
 				if (Error != 0)
 				{
 					return;
 				}
+
+				Error = CodeTableD.Build(BitLength.data() + HLit, HDist, DistanceTableBits);
 			}
 
-			inline void InflateHuffmanBlock(std::vector<unsigned char>& Out, const unsigned char* In, std::int_fast32_t& BP, std::int_fast32_t& Pos, const std::int_fast32_t InLength, const std::int_fast32_t Type)
+			inline void InflateHuffmanBlock(std::vector<unsigned char>& Out, BitReader& Reader, std::size_t& Pos, const HuffmanTable& Table, const HuffmanTable& TableD)
 			{
-				if (Type == 1)
-				{
-					GenerateFixedTrees(CodeTree, CodeTreeD);
-				}
-				else if (Type == 2)
-				{
-					GetTreeInflateDynamic(CodeTree, CodeTreeD, In, BP, InLength);
-
-					if (Error != 0)
-					{
-						return;
-					}
-				}
-
 				for (;;)
 				{
-					const std::int_fast32_t Code{ HuffmanDecodeSymbol(In, BP, CodeTree, InLength) };
+					Reader.Refill();
+
+					const std::int_fast32_t Code{ Table.Decode(Reader) };
 
-					if (Error != 0 || Code == 256)
+					if (Code < 0)
 					{
+						Error = 11;
 						return;
 					}
 
-					if (Code <= 255)
+					if (Code < 256)
 					{
-						if (Pos >= static_cast<std::int_fast32_t>(Out.size()))
+						if (Pos + CopySlack >= Out.size())
 						{
-							Out.resize((static_cast<std::size_t>(Pos) + 1) << 1);
+							Out.resize(Out.size() << 1);
 						}
 
 						Out[Pos++] = static_cast<unsigned char>(Code);
+						continue;
 					}
-					else if (Code >= 257 && Code <= 285) //-V560
+
+					if (Code == 256)
 					{
-						std::int_fast32_t Length{ LengthBase[Code - 257] };
+						return;
+					}
 
-						if ((BP >> 3) >= InLength) //-V1051
-						{
-							Error = 51;
-							return;
-						}
+					if (Code > 285)
+					{
+						Error = 16;
+						return;
+					}
 
-						Length += ReadBitsFromStream(BP, In, LengthExtra[Code - 257]);
-						const std::int_fast32_t CodeD{ HuffmanDecodeSymbol(In, BP, CodeTreeD, InLength) };
+					const std::size_t Length{ static_cast<std::size_t>(LengthBase[Code - 257] + Reader.ReadBits(LengthExtra[Code - 257])) };
+					const std::int_fast32_t CodeD{ TableD.Decode(Reader) };
 
-						if (Error != 0)
-						{
-							return;
-						}
+					if (CodeD < 0 || CodeD > 29)
+					{
+						Error = 18;
+						return;
+					}
 
-						if (CodeD > 29)
-						{
-							Error = 18;
-							return;
-						}
+					const std::size_t Distance{ static_cast<std::size_t>(DistanceBase[CodeD] + Reader.ReadBits(DistanceExtra[CodeD])) };
 
-						std::int_fast32_t Distance{ DistanceBase[CodeD] };
+					if (Distance > Pos)
+					{
+						Error = 52;
+						return;
+					}
 
-						if ((BP >> 3) >= InLength)
-						{
-							Error = 51;
-							return;
-						}
+					if (Pos + Length + CopySlack >= Out.size())
+					{
+						Out.resize((Pos + Length + CopySlack) << 1);
+					}
 
-						Distance += ReadBitsFromStream(BP, In, DistanceExtra[CodeD]);
+					unsigned char* Target{ Out.data() + Pos };
+					const unsigned char* Source{ Target - Distance };
 
-						if (Pos + Length >= static_cast<std::int_fast32_t>(Out.size()))
+					if (Distance >= 8)
+					{
+						// Every 8 byte block is complete before it is read again - may write up to 7 bytes into the slack
+						for (std::size_t i{}; i < Length; i += 8)
 						{
-							Out.resize((static_cast<std::size_t>(Pos) + static_cast<std::size_t>(Length)) << 1);
+							std::memcpy(Target + i, Source + i, 8);
 						}
-
-						for (std::int_fast32_t Back{ Pos - Distance }, i{}; i < Length; ++i)
+					}
+					else if (Distance == 1)
+					{
+						std::memset(Target, *Source, Length);
+					}
+					else
+					{
+						for (std::size_t i{}; i < Length; ++i)
 						{
-							Out[Pos++] = Out[Back++];
-
-							if (Back >= Pos)
-							{
-								Back = Pos - Distance;
-							}
+							Target[i] = Source[i];
 						}
 					}
+
+					Pos += Length;
 				}
 			}
 
-			inline void InflateNoCompression(std::vector<unsigned char>& Out, const unsigned char* In, std::int_fast32_t& BP, std::int_fast32_t& Pos, const std::int_fast32_t InLength)
+			inline void InflateNoCompression(std::vector<unsigned char>& Out, BitReader& Reader, std::size_t& Pos)
 			{
-				while ((BP & 0x7) != 0)
-				{
-					++BP;
-				}
+				Reader.AlignToByte();
 
-				std::int_fast32_t p{ BP >> 4 };
-
-				if (p >= InLength - 4)
+				if (Reader.End - Reader.Data < 4)
 				{
 					Error = 52;
 					return;
 				}
 
-				const std::int_fast32_t Len{ In[p] + (In[p + 1] << 8) };
-				const std::int_fast32_t NLen{ In[p + 2] + (In[p + 3] << 8) };
+				const std::size_t Len{ static_cast<std::size_t>(Reader.Data[0] + (Reader.Data[1] << 8)) };
+				const std::size_t NLen{ static_cast<std::size_t>(Reader.Data[2] + (Reader.Data[3] << 8)) };
 
-				p += 4;
+				Reader.Data += 4;
 
 				if (Len + NLen != 65535)
 				{
@@ -467,29 +556,26 @@ namespace lwmf
 					return;
 				}
 
-				if (Pos + Len >= static_cast<std::int_fast32_t>(Out.size()))
-				{
-					Out.resize(static_cast<std::size_t>(Pos) + static_cast<std::size_t>(Len));
-				}
-
-				if (p + Len > InLength)
+				if (static_cast<std::size_t>(Reader.End - Reader.Data) < Len)
 				{
 					Error = 23;
 					return;
 				}
 
-				for (std::int_fast32_t n{}; n < Len; ++n)
+				if (Pos + Len + CopySlack >= Out.size())
 				{
-					Out[Pos++] = In[p++];
+					Out.resize(Pos + Len + CopySlack);
 				}
 
-				BP = p << 3;
+				std::memcpy(Out.data() + Pos, Reader.Data, Len);
+				Pos += Len;
+				Reader.Data += Len;
 			}
 		};
 
-		inline std::int_fast32_t DeCompress(std::vector<unsigned char>& Out, const std::vector<unsigned char>& In) const
+		static inline std::int_fast32_t DeCompress(std::vector<unsigned char>& Out, const unsigned char* In, const std::size_t InLength)
 		{
-			if (In.size() < 2)
+			if (InLength < 2)
 			{
 				return 53;
 			}
@@ -510,7 +596,7 @@ namespace lwmf
 			}
 
 			Inflator InflateThis;
-			InflateThis.Inflate(Out, In, 2);
+			InflateThis.Inflate(Out, In + 2, InLength - 2);
 			return InflateThis.Error;
 		}
 	};
@@ -535,11 +621,12 @@ namespace lwmf
 
 		std::int_fast32_t Error{};
 
-		inline void Decode(std::vector<unsigned char>& Out, const std::vector<unsigned char>& In, const std::int_fast32_t Size, const bool ConvertToRGBA)
+		// Decodes straight into the texture - 8 bit non-interlaced images (all the usual ones) are unfiltered row by row into the pixels
+		inline void Decode(TextureStruct& Texture, const unsigned char* In, const std::int_fast32_t Size)
 		{
 			Error = 0;
 
-			if (Size == 0 || In.empty())
+			if (Size == 0 || In == nullptr)
 			{
 				Error = 48;
 				return;
@@ -553,7 +640,7 @@ namespace lwmf
 			}
 
 			std::int_fast32_t Pos{ 33 };
-			std::vector<unsigned char> ImageData{};
+			std::vector<std::pair<std::int_fast32_t, std::int_fast32_t>> ImageDataChunks{};
 			bool ImageEnd{};
 			PNGInfo.KeyDefined = false;
 
@@ -568,7 +655,8 @@ namespace lwmf
 				const std::int_fast32_t ChunkLength{ Read32bitInt(&In[Pos]) };
 				Pos += 4;
 
-				if (Pos + ChunkLength >= Size)
+				// Type, data and CRC have to be inside the buffer before any of them is read - written without Pos + ChunkLength, which could overflow
+				if (ChunkLength < 0 || ChunkLength > Size - Pos - 8)
 				{
 					Error = 35;
 					return;
@@ -576,7 +664,7 @@ namespace lwmf
 
 				if (In[Pos + 0] == 'I' && In[Pos + 1] == 'D' && In[Pos + 2] == 'A' && In[Pos + 3] == 'T')
 				{
-					ImageData.insert(ImageData.end(), &In[Pos + 4], &In[Pos + 4 + ChunkLength]);
+					ImageDataChunks.emplace_back(Pos + 4, ChunkLength);
 					Pos += (4 + ChunkLength);
 				}
 				else if (In[Pos + 0] == 'I' && In[Pos + 1] == 'E' && In[Pos + 2] == 'N' && In[Pos + 3] == 'D')
@@ -674,25 +762,108 @@ namespace lwmf
 				Pos += 4;
 			}
 
+			if (PNGInfo.Width <= 0 || PNGInfo.Height <= 0)
+			{
+				Error = 93;
+				return;
+			}
+
 			const std::int_fast32_t BitsPerPixel{ GetBpp(PNGInfo) };
-			std::vector<unsigned char> ScanLines(((PNGInfo.Width * (PNGInfo.Height * BitsPerPixel + 7)) >> 3) + PNGInfo.Height);
+			const std::int_fast32_t ByteWidth{ (BitsPerPixel + 7) >> 3 };
+			const std::int_fast32_t LineLength{ (PNGInfo.Width * BitsPerPixel + 7) >> 3 };
+
+			// Sizes of the Adam7 passes - pass 7 is the end of the data
+			const std::array<std::int_fast32_t, 7> PassWidth{ (PNGInfo.Width + 7) >> 3, (PNGInfo.Width + 3) >> 3, (PNGInfo.Width + 3) >> 2, (PNGInfo.Width + 1) >> 2, (PNGInfo.Width + 1) >> 1, (PNGInfo.Width + 0) >> 1, (PNGInfo.Width + 0) / 1 };
+			const std::array<std::int_fast32_t, 7> PassHeight{ (PNGInfo.Height + 7) >> 3, (PNGInfo.Height + 7) >> 3, (PNGInfo.Height + 3) >> 3, (PNGInfo.Height + 3) >> 2, (PNGInfo.Height + 1) >> 2, (PNGInfo.Height + 1) >> 1, (PNGInfo.Height + 0) >> 1 };
+			std::array<std::int_fast32_t, 8> PassStart{};
+
+			for (std::int_fast32_t i{}; i < 7; ++i)
+			{
+				PassStart[i + 1] = PassStart[i] + PassHeight[i] * ((PassWidth[i] != 0 ? 1 : 0) + ((PassWidth[i] * BitsPerPixel + 7) >> 3));
+			}
 
-			const Zlib zlib{};
-			Error = zlib.DeCompress(ScanLines, ImageData);
+			const std::size_t ScanLinesSize{ static_cast<std::size_t>(PNGInfo.InterlaceMethod == 0 ? PNGInfo.Height * (1 + LineLength) : PassStart[7]) };
+			std::vector<unsigned char> ScanLines(ScanLinesSize);
+
+			// Usually there is just one IDAT chunk - it is decompressed right from the file buffer
+			if (ImageDataChunks.size() == 1)
+			{
+				Error = Zlib::DeCompress(ScanLines, &In[ImageDataChunks[0].first], static_cast<std::size_t>(ImageDataChunks[0].second));
+			}
+			else
+			{
+				std::vector<unsigned char> ImageData{};
+
+				for (const auto& [Start, Length] : ImageDataChunks)
+				{
+					ImageData.insert(ImageData.end(), &In[Start], &In[Start + Length]);
+				}
+
+				Error = Zlib::DeCompress(ScanLines, ImageData.data(), ImageData.size());
+			}
+
+			if (Error == 0 && ScanLines.size() < ScanLinesSize)
+			{
+				Error = 91;
+			}
 
 			if (Error != 0)
 			{
 				return;
 			}
 
-			const std::int_fast32_t ByteWidth{ (BitsPerPixel + 7) >> 3 };
+			CreateTexture(Texture, PNGInfo.Width, PNGInfo.Height, 0x00000000);
 
-			Out.resize(static_cast<std::size_t>((PNGInfo.Height * PNGInfo.Width * BitsPerPixel + 7) >> 3));
+			// Texture pixels are RGBA in memory (see RGBAtoINT()) - if they are 32 bit, rows are written right into them
+			constexpr bool DirectOutput{ sizeof(Texture.Pixels[0]) == 4 };
+			std::vector<unsigned char> RGBALine(DirectOutput ? 0 : static_cast<std::size_t>(PNGInfo.Width) << 2);
 
-			if (PNGInfo.InterlaceMethod == 0)
+			if (PNGInfo.InterlaceMethod == 0 && PNGInfo.BitDepth == 8)
 			{
-				const std::int_fast32_t LineLength{ (PNGInfo.Width * BitsPerPixel + 7) >> 3 };
+				const bool UnFilterIntoTexture{ DirectOutput && PNGInfo.ColorType == 6 };
+				std::vector<unsigned char> Lines(UnFilterIntoTexture ? 0 : static_cast<std::size_t>(LineLength) << 1);
+
+				for (std::int_fast32_t y{}; y < PNGInfo.Height; ++y)
+				{
+					unsigned char* Target{ DirectOutput ? reinterpret_cast<unsigned char*>(Texture.Pixels.data()) + ((static_cast<std::size_t>(y) * static_cast<std::size_t>(PNGInfo.Width)) << 2) : RGBALine.data() };
+					const unsigned char* ScanLine{ &ScanLines[static_cast<std::size_t>(y) * static_cast<std::size_t>(1 + LineLength)] };
+
+					if (UnFilterIntoTexture)
+					{
+						UnFilterScanline(Target, ScanLine + 1, y == 0 ? nullptr : Target - (PNGInfo.Width << 2), ByteWidth, ScanLine[0], LineLength);
+					}
+					else
+					{
+						// Two alternating lines - the previous one is needed unconverted for unfiltering
+						unsigned char* Line{ &Lines[static_cast<std::size_t>(y & 1) * static_cast<std::size_t>(LineLength)] };
 
+						UnFilterScanline(Line, ScanLine + 1, y == 0 ? nullptr : &Lines[static_cast<std::size_t>((y + 1) & 1) * static_cast<std::size_t>(LineLength)], ByteWidth, ScanLine[0], LineLength);
+
+						if (Error == 0)
+						{
+							Error = Convert(Target, Line, PNGInfo, PNGInfo.Width);
+						}
+					}
+
+					if (Error != 0)
+					{
+						return;
+					}
+
+					if constexpr (!DirectOutput)
+					{
+						StoreRGBALine(Texture, y, RGBALine.data());
+					}
+				}
+
+				return;
+			}
+
+			// Everything else (interlaced, 16 bit, less than 8 bit) is decoded into one buffer and converted at once
+			std::vector<unsigned char> Out(static_cast<std::size_t>((PNGInfo.Height * PNGInfo.Width * BitsPerPixel + 7) >> 3));
+
+			if (PNGInfo.InterlaceMethod == 0)
+			{
 				if (std::int_fast32_t LineStart{}; BitsPerPixel >= 8)
 				{
 					for (std::int_fast32_t y{}; y < PNGInfo.Height; ++y)
@@ -711,13 +882,12 @@ namespace lwmf
 				}
 				else
 				{
-					std::vector<unsigned char> TempLine((PNGInfo.Width * BitsPerPixel + 7) >> 3);
+					std::vector<unsigned char> TempLine(LineLength);
+					std::vector<unsigned char> PreviousLine(LineLength);
 
 					for (std::int_fast32_t y{}, OBP{}; y < PNGInfo.Height; ++y)
 					{
-						const unsigned char* PreviousLine{ y == 0 ? nullptr : &Out[(y - 1) * PNGInfo.Width * ByteWidth] };
-
-						UnFilterScanline(TempLine.data(), &ScanLines[LineStart + 1], PreviousLine, ByteWidth, ScanLines[LineStart], LineLength);
+						UnFilterScanline(TempLine.data(), &ScanLines[LineStart + 1], y == 0 ? nullptr : PreviousLine.data(), ByteWidth, ScanLines[LineStart], LineLength);
 
 						if (Error != 0)
 						{
@@ -729,39 +899,38 @@ namespace lwmf
 							SetBitOfReversedStream(OBP, Out, ReadBitFromReversedStream(BP, TempLine.data()));
 						}
 
+						std::swap(TempLine, PreviousLine);
 						LineStart += (1 + LineLength);
 					}
 				}
 			}
 			else
 			{
-				const std::array<std::int_fast32_t, 7> PassWidth{ (PNGInfo.Width + 7) >> 3, (PNGInfo.Width + 3) >> 3, (PNGInfo.Width + 3) >> 2, (PNGInfo.Width + 1) >> 2, (PNGInfo.Width + 1) >> 1, (PNGInfo.Width + 0) >> 1, (PNGInfo.Width + 0) / 1 };
-				const std::array<std::int_fast32_t, 7> PassHeight{ (PNGInfo.Height + 7) >> 3, (PNGInfo.Height + 7) >> 3, (PNGInfo.Height + 3) >> 3, (PNGInfo.Height + 3) >> 2, (PNGInfo.Height + 1) >> 2, (PNGInfo.Height + 1) >> 1, (PNGInfo.Height + 0) >> 1 };
 				constexpr std::array<std::int_fast32_t, 28> Pattern{ 0,4,0,2,0,1,0,0,0,4,0,2,0,1,8,8,4,4,2,2,1,8,8,8,4,4,2,2 };
-				std::array<std::int_fast32_t, 7> PassStart{};
-
-				for (std::int_fast32_t i{}; i < 6; ++i)
-				{
-					PassStart[i + 1] = PassStart[i] + PassHeight[i] * ((PassWidth[i] != 0 ? 1 : 0) + ((PassWidth[i] * BitsPerPixel + 7) >> 3));
-				}
-
-				std::vector<unsigned char> ScanLineO((PNGInfo.Width * BitsPerPixel + 7) >> 3);
-				std::vector<unsigned char> ScanLineN((PNGInfo.Width * BitsPerPixel + 7) >> 3);
+				std::vector<unsigned char> ScanLineO(LineLength);
+				std::vector<unsigned char> ScanLineN(LineLength);
 
 				for (std::int_fast32_t i{}; i < 7; ++i)
 				{
-					Adam7(Out, ScanLineN.data(), ScanLineO.data(), &ScanLines[PassStart[i]], PNGInfo.Width, Pattern[i], Pattern[i + 7], Pattern[i + 14], Pattern[i + 21], PassWidth[i], PassHeight[i], BitsPerPixel); //-V522
+					Adam7(Out, ScanLineN.data(), ScanLineO.data(), &ScanLines[PassStart[i]], PNGInfo.Width, Pattern[i], Pattern[i + 7], Pattern[i + 14], Pattern[i + 21], PassWidth[i], PassHeight[i], BitsPerPixel);
+
+					if (Error != 0)
+					{
+						return;
+					}
 				}
 			}
 
-			if (ConvertToRGBA && (PNGInfo.ColorType != 6 || PNGInfo.BitDepth != 8))
+			std::vector<unsigned char> RGBAData(static_cast<std::size_t>(Texture.Size) << 2);
+			Error = Convert(RGBAData.data(), Out.data(), PNGInfo, Texture.Size);
+
+			for (std::int_fast32_t y{}; Error == 0 && y < PNGInfo.Height; ++y)
 			{
-				std::vector<unsigned char> Data{ Out };
-				Error = Convert(Out, Data.data(), PNGInfo, PNGInfo.Width, PNGInfo.Height);
+				StoreRGBALine(Texture, y, &RGBAData[(static_cast<std::size_t>(y) * static_cast<std::size_t>(PNGInfo.Width)) << 2]);
 			}
 		}
 
-		inline void ReadPNGHeader(const std::vector<unsigned char>& In, const std::int_fast32_t InLength)
+		inline void ReadPNGHeader(const unsigned char* In, const std::int_fast32_t InLength)
 		{
 			if (InLength < 29)
 			{
@@ -814,27 +983,35 @@ namespace lwmf
 
 		inline void UnFilterScanline(unsigned char* Recon, const unsigned char* ScanLine, const unsigned char* PreCon, const std::int_fast32_t ByteWidth, const std::int_fast32_t FilterType, const std::int_fast32_t Length)
 		{
+			// The first line has no predecessor - "Up" is a plain copy then, "Paeth" is the same as "Sub"
 			switch (FilterType)
 			{
 				case 0:
 				{
-					for (std::int_fast32_t i{}; i < Length; ++i)
-					{
-						Recon[i] = ScanLine[i];
-					}
-
+					std::memcpy(Recon, ScanLine, static_cast<std::size_t>(Length));
 					break;
 				}
 				case 1:
 				{
-					for (std::int_fast32_t i{}; i < ByteWidth; ++i)
+					if (ByteWidth == 4)
 					{
-						Recon[i] = ScanLine[i];
+						UnFilterSub<4>(Recon, ScanLine, Length);
 					}
-
-					for (std::int_fast32_t i{ ByteWidth }; i < Length; ++i)
+					else if (ByteWidth == 3)
 					{
-						Recon[i] = ScanLine[i] + Recon[i - ByteWidth];
+						UnFilterSub<3>(Recon, ScanLine, Length);
+					}
+					else
+					{
+						for (std::int_fast32_t i{}; i < ByteWidth; ++i)
+						{
+							Recon[i] = ScanLine[i];
+						}
+
+						for (std::int_fast32_t i{ ByteWidth }; i < Length; ++i)
+						{
+							Recon[i] = ScanLine[i] + Recon[i - ByteWidth];
+						}
 					}
 
 					break;
@@ -843,17 +1020,21 @@ namespace lwmf
 				{
 					if (PreCon != nullptr)
 					{
-						for (std::int_fast32_t i{}; i < Length; ++i)
+						std::int_fast32_t i{};
+
+						for (; i + 16 <= Length; i += 16)
+						{
+							_mm_storeu_si128(reinterpret_cast<__m128i*>(&Recon[i]), _mm_add_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&ScanLine[i])), _mm_loadu_si128(reinterpret_cast<const __m128i*>(&PreCon[i]))));
+						}
+
+						for (; i < Length; ++i)
 						{
 							Recon[i] = ScanLine[i] + PreCon[i];
 						}
 					}
 					else
 					{
-						for (std::int_fast32_t i{}; i < Length; ++i)
-						{
-							Recon[i] = ScanLine[i];
-						}
+						std::memcpy(Recon, ScanLine, static_cast<std::size_t>(Length));
 					}
 
 					break;
@@ -862,14 +1043,25 @@ namespace lwmf
 				{
 					if (PreCon != nullptr)
 					{
-						for (std::int_fast32_t i{}; i < ByteWidth; ++i)
+						if (ByteWidth == 4)
 						{
-							Recon[i] = ScanLine[i] + (PreCon[i] >> 1);
+							UnFilterAverage<4>(Recon, ScanLine, PreCon, Length);
 						}
-
-						for (std::int_fast32_t i{ ByteWidth }; i < Length; ++i)
+						else if (ByteWidth == 3)
 						{
-							Recon[i] = ScanLine[i] + ((Recon[i - ByteWidth] + PreCon[i]) >> 1);
+							UnFilterAverage<3>(Recon, ScanLine, PreCon, Length);
+						}
+						else
+						{
+							for (std::int_fast32_t i{}; i < ByteWidth; ++i)
+							{
+								Recon[i] = ScanLine[i] + (PreCon[i] >> 1);
+							}
+
+							for (std::int_fast32_t i{ ByteWidth }; i < Length; ++i)
+							{
+								Recon[i] = ScanLine[i] + ((Recon[i - ByteWidth] + PreCon[i]) >> 1);
+							}
 						}
 					}
 					else
@@ -888,28 +1080,28 @@ namespace lwmf
 				}
 				case 4:
 				{
-					if (PreCon != nullptr)
+					if (PreCon == nullptr)
 					{
-						for (std::int_fast32_t i{}; i < ByteWidth; ++i)
-						{
-							Recon[i] = ScanLine[i] + PathPredictor(0, PreCon[i], 0);
-						}
-
-						for (std::int_fast32_t i{ ByteWidth }; i < Length; ++i)
-						{
-							Recon[i] = ScanLine[i] + PathPredictor(Recon[i - ByteWidth], PreCon[i], PreCon[i - ByteWidth]);
-						}
+						UnFilterScanline(Recon, ScanLine, PreCon, ByteWidth, 1, Length);
+					}
+					else if (ByteWidth == 4)
+					{
+						UnFilterPaeth<4>(Recon, ScanLine, PreCon, Length);
+					}
+					else if (ByteWidth == 3)
+					{
+						UnFilterPaeth<3>(Recon, ScanLine, PreCon, Length);
 					}
 					else
 					{
 						for (std::int_fast32_t i{}; i < ByteWidth; ++i)
 						{
-							Recon[i] = ScanLine[i];
+							Recon[i] = ScanLine[i] + PathPredictor(0, PreCon[i], 0);
 						}
 
 						for (std::int_fast32_t i{ ByteWidth }; i < Length; ++i)
 						{
-							Recon[i] = ScanLine[i] + PathPredictor(Recon[i - ByteWidth], 0, 0);
+							Recon[i] = ScanLine[i] + PathPredictor(Recon[i - ByteWidth], PreCon[i], PreCon[i - ByteWidth]);
 						}
 					}
 					break;
@@ -922,6 +1114,82 @@ namespace lwmf
 			}
 		}
 
+		// SIMD unfiltering for RGB and RGBA lines - one pixel per step, since every pixel depends on its left neighbour
+		// Length is always a multiple of Bpp here (8 bit per channel)
+
+		template<std::int_fast32_t Bpp>
+		static inline __m128i LoadPixel(const unsigned char* Source)
+		{
+			std::int32_t Pixel{};
+			std::memcpy(&Pixel, Source, Bpp);
+			return _mm_cvtsi32_si128(Pixel);
+		}
+
+		template<std::int_fast32_t Bpp>
+		static inline void StorePixel(unsigned char* Target, const __m128i Pixel)
+		{
+			const std::int32_t Value{ _mm_cvtsi128_si32(Pixel) };
+			std::memcpy(Target, &Value, Bpp);
+		}
+
+		template<std::int_fast32_t Bpp>
+		static inline void UnFilterSub(unsigned char* Recon, const unsigned char* ScanLine, const std::int_fast32_t Length)
+		{
+			__m128i a{ _mm_setzero_si128() };
+
+			for (std::int_fast32_t i{}; i < Length; i += Bpp)
+			{
+				a = _mm_add_epi8(a, LoadPixel<Bpp>(&ScanLine[i]));
+				StorePixel<Bpp>(&Recon[i], a);
+			}
+		}
+
+		template<std::int_fast32_t Bpp>
+		static inline void UnFilterAverage(unsigned char* Recon, const unsigned char* ScanLine, const unsigned char* PreCon, const std::int_fast32_t Length)
+		{
+			const __m128i One{ _mm_set1_epi8(1) };
+			__m128i a{ _mm_setzero_si128() };
+
+			for (std::int_fast32_t i{}; i < Length; i += Bpp)
+			{
+				const __m128i b{ LoadPixel<Bpp>(&PreCon[i]) };
+				// _mm_avg_epu8() rounds up - subtract the lost bit to get (a + b) >> 1
+				const __m128i Average{ _mm_sub_epi8(_mm_avg_epu8(a, b), _mm_and_si128(_mm_xor_si128(a, b), One)) };
+
+				a = _mm_add_epi8(Average, LoadPixel<Bpp>(&ScanLine[i]));
+				StorePixel<Bpp>(&Recon[i], a);
+			}
+		}
+
+		template<std::int_fast32_t Bpp>
+		static inline void UnFilterPaeth(unsigned char* Recon, const unsigned char* ScanLine, const unsigned char* PreCon, const std::int_fast32_t Length)
+		{
+			// Predictor in 16 bit lanes: pa = |b - c|, pb = |a - c|, pc = |a + b - 2c|
+			const __m128i Zero{ _mm_setzero_si128() };
+			__m128i a{ Zero };
+			__m128i b{ Zero };
+
+			for (std::int_fast32_t i{}; i < Length; i += Bpp)
+			{
+				const __m128i c{ b };
+				b = _mm_unpacklo_epi8(LoadPixel<Bpp>(&PreCon[i]), Zero);
+
+				const __m128i PA{ _mm_sub_epi16(b, c) };
+				const __m128i PB{ _mm_sub_epi16(a, c) };
+				const __m128i PC{ _mm_abs_epi16(_mm_add_epi16(PA, PB)) };
+				const __m128i AbsPA{ _mm_abs_epi16(PA) };
+				const __m128i AbsPB{ _mm_abs_epi16(PB) };
+				const __m128i Smallest{ _mm_min_epi16(PC, _mm_min_epi16(AbsPA, AbsPB)) };
+
+				// Ties prefer a over b over c
+				const __m128i Nearest{ _mm_blendv_epi8(_mm_blendv_epi8(c, b, _mm_cmpeq_epi16(Smallest, AbsPB)), a, _mm_cmpeq_epi16(Smallest, AbsPA)) };
+
+				// Bytewise add wraps like the scalar version, the upper byte of each lane stays zero
+				a = _mm_add_epi8(_mm_unpacklo_epi8(LoadPixel<Bpp>(&ScanLine[i]), Zero), Nearest);
+				StorePixel<Bpp>(&Recon[i], _mm_packus_epi16(a, a));
+			}
+		}
+
 		inline void Adam7(std::vector<unsigned char>& Out, unsigned char* LineN, unsigned char* LineO, const unsigned char* In, const std::int_fast32_t Width, const std::int_fast32_t PassLeft, const std::int_fast32_t PassTop, const std::int_fast32_t SpaceX, const std::int_fast32_t SpaceY, const std::int_fast32_t PassWidth, const std::int_fast32_t PassHeight, const std::int_fast32_t Bpp)
 		{
 			if (PassWidth == 0)
@@ -936,7 +1204,7 @@ namespace lwmf
 			{
 				const unsigned char* PreviousLine{ y == 0 ? nullptr : LineO };
 
-				UnFilterScanline(LineN, &In[y * LineLength + 1], PreviousLine, ByteWidth, In[y * LineLength], ((Width * Bpp + 7) >> 3));
+				UnFilterScanline(LineN, &In[y * LineLength + 1], PreviousLine, ByteWidth, In[y * LineLength], LineLength - 1);
 
 				if (Error != 0)
 				{
@@ -980,7 +1248,7 @@ namespace lwmf
 		{
 			std::int_fast32_t Result{};
 
-			for (std::int_fast32_t i{ NBits - 1}; i < NBits; --i)
+			for (std::int_fast32_t i{ NBits - 1 }; i >= 0; --i)
 			{
 				Result += ((ReadBitFromReversedStream(BitP, Bits)) << i);
 			}
@@ -1049,11 +1317,9 @@ namespace lwmf
 			return BPPInfo.BitDepth;
 		}
 
-		static inline std::int_fast32_t Convert(std::vector<unsigned char>& Out, const unsigned char* In, const Info& InfoIn, const std::int_fast32_t Width, const std::int_fast32_t Height)
+		// Converts NumberOfPixels pixels to RGBA - Out must hold NumberOfPixels * 4 bytes
+		static inline std::int_fast32_t Convert(unsigned char* Out, const unsigned char* In, const Info& InfoIn, const std::int_fast32_t NumberOfPixels)
 		{
-			const std::int_fast32_t NumberOfPixels{ Width * Height };
-			Out.resize(static_cast<std::size_t>(NumberOfPixels) << 2);
-
 			if (std::int_fast32_t BP{}; InfoIn.BitDepth == 8 && InfoIn.ColorType == 0)
 			{
 				for (std::int_fast32_t i{}; i < NumberOfPixels; ++i)
@@ -1068,7 +1334,21 @@ namespace lwmf
 			}
 			else if (InfoIn.BitDepth == 8 && InfoIn.ColorType == 2)
 			{
-				for (std::int_fast32_t i{}; i < NumberOfPixels; ++i)
+				std::int_fast32_t i{};
+
+				if (!InfoIn.KeyDefined)
+				{
+					// Four pixels per step - the 16 byte load reads two pixels ahead, so stop early enough
+					const __m128i Shuffle{ _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1) };
+					const __m128i Alpha{ _mm_set1_epi32(static_cast<std::int32_t>(0xFF000000)) };
+
+					for (; i + 6 <= NumberOfPixels; i += 4)
+					{
+						_mm_storeu_si128(reinterpret_cast<__m128i*>(&Out[i << 2]), _mm_or_si128(_mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&In[i * 3])), Shuffle), Alpha));
+					}
+				}
+
+				for (; i < NumberOfPixels; ++i)
 				{
 					const std::int_fast32_t Offset{ i << 2 };
 					const std::int_fast32_t SrcOffset{ i * 3 };
@@ -1078,22 +1358,21 @@ namespace lwmf
 						Out[Offset + c] = In[SrcOffset + c];
 					}
 
-					Out[Offset + 3] = (static_cast<std::int_fast32_t>(InfoIn.KeyDefined) == 1 && In[SrcOffset] == InfoIn.KeyR && In[SrcOffset + 1] == InfoIn.KeyG && In[SrcOffset + 2] == InfoIn.KeyB) ? 0 : 255;
+					Out[Offset + 3] = (InfoIn.KeyDefined && In[SrcOffset] == InfoIn.KeyR && In[SrcOffset + 1] == InfoIn.KeyG && In[SrcOffset + 2] == InfoIn.KeyB) ? 0 : 255;
 				}
 			}
 			else if (InfoIn.BitDepth == 8 && InfoIn.ColorType == 3)
 			{
+				const std::int_fast32_t PaletteSize{ static_cast<std::int_fast32_t>(InfoIn.Palette.size()) };
+
 				for (std::int_fast32_t i{}; i < NumberOfPixels; ++i)
 				{
-					if ((In[i] << 2) >= static_cast<std::int_fast32_t>(InfoIn.Palette.size()))
+					if ((In[i] << 2) >= PaletteSize)
 					{
 						return 46;
 					}
 
-					for (std::int_fast32_t c{}; c < 4; ++c)
-					{
-						Out[(i << 2) + c] = InfoIn.Palette[(In[i] << 2) + c];
-					}
+					std::memcpy(&Out[i << 2], &InfoIn.Palette[static_cast<std::size_t>(In[i]) << 2], 4);
 				}
 			}
 			else if (InfoIn.BitDepth == 8 && InfoIn.ColorType == 4)
@@ -1111,15 +1390,7 @@ namespace lwmf
 			}
 			else if (InfoIn.BitDepth == 8 && InfoIn.ColorType == 6)
 			{
-				for (std::int_fast32_t i{}; i < NumberOfPixels; ++i)
-				{
-					const std::int_fast32_t Offset{ i << 2 };
-
-					for (std::int_fast32_t c{}; c < 4; ++c)
-					{
-						Out[Offset + c] = In[Offset + c];
-					}
-				}
+				std::memcpy(Out, In, static_cast<std::size_t>(NumberOfPixels) << 2);
 			}
 			else if (InfoIn.BitDepth == 16 && InfoIn.ColorType == 0)
 			{
@@ -1195,16 +1466,24 @@ namespace lwmf
 						return 47;
 					}
 
-					for (std::int_fast32_t c{}; c < 4; ++c)
-					{
-						Out[(i << 2) + c] = InfoIn.Palette[(Value << 2) + c];
-					}
+					std::memcpy(&Out[i << 2], &InfoIn.Palette[static_cast<std::size_t>(Value) << 2], 4);
 				}
 			}
 
 			return 0;
 		}
 
+		// Only needed if texture pixels are not 32 bit wide
+		static inline void StoreRGBALine(TextureStruct& Texture, const std::int_fast32_t Line, const unsigned char* RGBA)
+		{
+			const std::int_fast32_t Offset{ Line * Texture.Width };
+
+			for (std::int_fast32_t x{}; x < Texture.Width; ++x)
+			{
+				Texture.Pixels[Offset + x] = RGBAtoINT(RGBA[x << 2], RGBA[(x << 2) + 1], RGBA[(x << 2) + 2], RGBA[(x << 2) + 3]);
+			}
+		}
+
 		static inline unsigned char PathPredictor(const std::int_fast32_t a, const std::int_fast32_t b, const std::int_fast32_t c)
 		{
 			const std::int_fast32_t p{ a + b - c };
@@ -1220,9 +1499,7 @@ namespace lwmf
 	{
 		LWMFSystemLog.AddEntry(LogLevel::Info, __FILENAME__, __LINE__, "Load file " + Filename + "...");
 
-		std::ifstream File(Filename.c_str(), std::ios::in | std::ios::binary);
-
-		if (File.fail())
+		if (std::vector<unsigned char> Buffer{}; !ReadFile(Filename, Buffer))
 		{
 			std::array<char, 100> ErrorMessage{};
 			strerror_s(ErrorMessage.data(), 100, errno);
@@ -1231,31 +1508,19 @@ namespace lwmf
 		}
 		else
 		{
-			std::streamsize Size{};
-
-			if (File.seekg(0, std::ios::end).good())
-			{
-				Size = File.tellg();
-			}
-
-			if (File.seekg(0, std::ios::beg).good())
-			{
-				Size -= File.tellg();
-			}
-
-			std::vector<unsigned char> Buffer(static_cast<std::size_t>(Size));
-			std::vector<unsigned char> ImageData;
-
-			File.read(reinterpret_cast<char*>(Buffer.data()), Size);
+			DecodePNG(Texture, Buffer, Filename);
+		}
+	}
 
-			PNG Decoder;
-			Decoder.Decode(ImageData, Buffer, static_cast<std::int_fast32_t>(Buffer.size()), true);
-			CreateTexture(Texture, Decoder.PNGInfo.Width, Decoder.PNGInfo.Height, 0x00000000);
+	inline void DecodePNG(TextureStruct& Texture, const std::vector<unsigned char>& Buffer, const std::string& Filename)
+	{
+		// For PNG files which are already in memory - Filename is only used for logging
+		PNG Decoder;
+		Decoder.Decode(Texture, Buffer.data(), static_cast<std::int_fast32_t>(Buffer.size()));
 
-			for (std::int_fast32_t Offset{}; Offset < Texture.Size; ++Offset)
-			{
-				Texture.Pixels[Offset] = RGBAtoINT(ImageData[Offset << 2], ImageData[(Offset << 2) + 1], ImageData[(Offset << 2) + 2], ImageData[(Offset << 2) + 3]);
-			}
+		if (Decoder.Error != 0)
+		{
+			LWMFSystemLog.AddEntry(LogLevel::Error, __FILENAME__, __LINE__, "lwmf::DecodePNG(): Error decoding " + Filename + " (error code " + std::to_string(Decoder.Error) + ")");
 		}
 	}
 
@@ -0,0 +1,211 @@
+/*
+******************************************************
+*                                                    *
+* lwmf_random - lightweight media framework          *
+*                                                    *
+* (C) 2019 - present by Stefan Kubsch                *
+*                                                    *
+******************************************************
+*/
+
+#pragma once
+
+#include <intrin.h>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <array>
+#include <limits>
+
+namespace lwmf
+{
+
+
+	// Random numbers without shared state
+	//
+	// CounterRandom() is a pure function of (seed, stream, counter) - e.g. stream = entity number, counter = game tick
+	// Every call stands alone, so any thread can ask for any number in any order and always gets the same result
+	//
+	// Xoshiro256 is a small (32 byte) sequential generator for code which needs many numbers in a row, seeded per stream
+	// It fulfills the "UniformRandomBitGenerator" requirements, so it works with std::shuffle etc.
+	//
+	// https://prng.di.unimi.it/
+
+	std::uint64_t SplitMix64(std::uint64_t Value);
+	std::uint64_t CounterRandom(std::uint64_t Seed, std::uint64_t Stream, std::uint64_t Counter);
+	float CounterRandomFloat(std::uint64_t Seed, std::uint64_t Stream, std::uint64_t Counter);
+	void CounterRandomBatch(std::uint64_t Seed, std::uint64_t Stream, std::uint64_t FirstCounter, std::uint32_t* Result, std::size_t Count);
+	void CounterRandomFloatBatch(std::uint64_t Seed, std::uint64_t Stream, std::uint64_t FirstCounter, float* Result, std::size_t Count);
+	std::uint32_t Hash32(std::uint32_t Value);
+	std::uint64_t HashBytes(const void* Data, std::size_t Size, std::uint64_t Seed);
+	__m128i Hash32x4(__m128i Values);
+
+	class Xoshiro256 final
+	{
+	public:
+		using result_type = std::uint64_t;
+
+		Xoshiro256(std::uint64_t Seed, std::uint64_t Stream);
+		std::uint64_t operator()();
+		float NextFloat();
+		static constexpr std::uint64_t min() { return 0; }
+		static constexpr std::uint64_t max() { return (std::numeric_limits<std::uint64_t>::max)(); }
+
+	private:
+		static std::uint64_t RotateLeft(std::uint64_t Value, std::int_fast32_t Shift);
+
+		std::array<std::uint64_t, 4> State{};
+	};
+
+	//
+	// Variables and constants
+	//
+
+	inline constexpr std::uint64_t GoldenGamma{ 0x9E3779B97F4A7C15ULL };
+	inline constexpr float UnitFloatFactor{ 1.0F / 16777216.0F };
+
+	//
+	// Functions
+	//
+
+	inline std::uint64_t SplitMix64(std::uint64_t Value)
+	{
+		Value = (Value ^ (Value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		Value = (Value ^ (Value >> 27)) * 0x94D049BB133111EBULL;
+		return Value ^ (Value >> 31);
+	}
+
+	inline std::uint64_t CounterRandom(const std::uint64_t Seed, const std::uint64_t Stream, const std::uint64_t Counter)
+	{
+		// Key the stream with the seed first, so neighbouring streams do not share counters
+		return SplitMix64(SplitMix64(Seed + Stream * GoldenGamma) + Counter * GoldenGamma);
+	}
+
+	inline float CounterRandomFloat(const std::uint64_t Seed, const std::uint64_t Stream, const std::uint64_t Counter)
+	{
+		// Upper 24 bits -> [0.0, 1.0)
+		return static_cast<float>(CounterRandom(Seed, Stream, Counter) >> 40) * UnitFloatFactor;
+	}
+
+	inline std::uint32_t Hash32(std::uint32_t Value)
+	{
+		// "lowbias32" integer hash by Chris Wellons
+		Value ^= Value >> 16;
+		Value *= 0x7FEB352DU;
+		Value ^= Value >> 15;
+		Value *= 0x846CA68BU;
+		return Value ^ (Value >> 16);
+	}
+
+	inline std::uint64_t HashBytes(const void* Data, const std::size_t Size, const std::uint64_t Seed)
+	{
+		// Content hash (checksums, cache keys) - eight bytes per step, each one mixed in by SplitMix64()
+		const unsigned char* Bytes{ static_cast<const unsigned char*>(Data) };
+		std::uint64_t Hash{ SplitMix64(Seed + static_cast<std::uint64_t>(Size) * GoldenGamma) };
+		std::size_t Index{};
+
+		for (; Index + sizeof(std::uint64_t) <= Size; Index += sizeof(std::uint64_t))
+		{
+			std::uint64_t Word{};
+			std::memcpy(&Word, Bytes + Index, sizeof(std::uint64_t));
+			Hash = SplitMix64((Hash ^ Word) + GoldenGamma);
+		}
+
+		if (Index < Size)
+		{
+			std::uint64_t Word{};
+			std::memcpy(&Word, Bytes + Index, Size - Index);
+			Hash = SplitMix64((Hash ^ Word) + GoldenGamma);
+		}
+
+		return Hash;
+	}
+
+	inline __m128i Hash32x4(__m128i Values)
+	{
+		// Hash32() on four lanes (SSE 4.1)
+		Values = _mm_xor_si128(Values, _mm_srli_epi32(Values, 16));
+		Values = _mm_mullo_epi32(Values, _mm_set1_epi32(static_cast<std::int32_t>(0x7FEB352DU)));
+		Values = _mm_xor_si128(Values, _mm_srli_epi32(Values, 15));
+		Values = _mm_mullo_epi32(Values, _mm_set1_epi32(static_cast<std::int32_t>(0x846CA68BU)));
+		return _mm_xor_si128(Values, _mm_srli_epi32(Values, 16));
+	}
+
+	inline void CounterRandomBatch(const std::uint64_t Seed, const std::uint64_t Stream, const std::uint64_t FirstCounter, std::uint32_t* Result, const std::size_t Count)
+	{
+		// 32 bit hash of (key + counter), four numbers per step - meant for effects, which need many cheap numbers at once
+		const std::uint32_t First{ static_cast<std::uint32_t>(SplitMix64(Seed + Stream * GoldenGamma)) + static_cast<std::uint32_t>(FirstCounter) };
+		__m128i Counters{ _mm_add_epi32(_mm_set1_epi32(static_cast<std::int32_t>(First)), _mm_setr_epi32(0, 1, 2, 3)) };
+		std::size_t Index{};
+
+		for (; Index + 4 <= Count; Index += 4)
+		{
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(Result + Index), Hash32x4(Counters));
+			Counters = _mm_add_epi32(Counters, _mm_set1_epi32(4));
+		}
+
+		for (; Index < Count; ++Index)
+		{
+			Result[Index] = Hash32(First + static_cast<std::uint32_t>(Index));
+		}
+	}
+
+	inline void CounterRandomFloatBatch(const std::uint64_t Seed, const std::uint64_t Stream, const std::uint64_t FirstCounter, float* Result, const std::size_t Count)
+	{
+		// Same numbers as CounterRandomBatch(), upper 24 bits -> [0.0, 1.0)
+		const std::uint32_t First{ static_cast<std::uint32_t>(SplitMix64(Seed + Stream * GoldenGamma)) + static_cast<std::uint32_t>(FirstCounter) };
+		__m128i Counters{ _mm_add_epi32(_mm_set1_epi32(static_cast<std::int32_t>(First)), _mm_setr_epi32(0, 1, 2, 3)) };
+		std::size_t Index{};
+
+		for (; Index + 4 <= Count; Index += 4)
+		{
+			_mm_storeu_ps(Result + Index, _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(Hash32x4(Counters), 8)), _mm_set1_ps(UnitFloatFactor)));
+			Counters = _mm_add_epi32(Counters, _mm_set1_epi32(4));
+		}
+
+		for (; Index < Count; ++Index)
+		{
+			Result[Index] = static_cast<float>(Hash32(First + static_cast<std::uint32_t>(Index)) >> 8) * UnitFloatFactor;
+		}
+	}
+
+	inline Xoshiro256::Xoshiro256(const std::uint64_t Seed, const std::uint64_t Stream)
+	{
+		// Seeding with SplitMix64 never produces the forbidden all-zero state
+		std::uint64_t Value{ SplitMix64(Seed + Stream * GoldenGamma) };
+
+		for (auto&& Word : State)
+		{
+			Value += GoldenGamma;
+			Word = SplitMix64(Value);
+		}
+	}
+
+	inline std::uint64_t Xoshiro256::RotateLeft(const std::uint64_t Value, const std::int_fast32_t Shift)
+	{
+		return (Value << Shift) | (Value >> (64 - Shift));
+	}
+
+	inline std::uint64_t Xoshiro256::operator()()
+	{
+		// xoshiro256**
+		const std::uint64_t Result{ RotateLeft(State[1] * 5, 7) * 9 };
+		const std::uint64_t Temp{ State[1] << 17 };
+
+		State[2] ^= State[0];
+		State[3] ^= State[1];
+		State[1] ^= State[2];
+		State[0] ^= State[3];
+		State[2] ^= Temp;
+		State[3] = RotateLeft(State[3], 45);
+
+		return Result;
+	}
+
+	inline float Xoshiro256::NextFloat()
+	{
+		return static_cast<float>((*this)() >> 40) * UnitFloatFactor;
+	}
+
+
+} // namespace lwmf
@@ -13,6 +13,10 @@ typedef struct ini_file_s* ini_file_t;
 ini_file_t I_LoadINI(const char* filename);
 void I_UnloadINI(ini_file_t ini);
 
+/* Returns the stored value without copying, NULL if missing - valid until the
+   key is set again or the file is unloaded */
+const char* I_INIGetValue(ini_file_t ini, const char* section, const char* key);
+
 bool I_INIGetString(ini_file_t ini, const char* section, const char* key, 
                     char* buffer, size_t bufferSize, const char* defaultValue);
 bool I_INIGetInt(ini_file_t ini, const char* section, const char* key, 
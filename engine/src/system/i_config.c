@@ -5,20 +5,33 @@
 #include <string.h>
 #include <ctype.h>
 
+/* Entries of all sections share one hash table keyed by section + key hash,
+   the linked lists only keep the file order for saving and enumeration */
+#define INI_INITIAL_BUCKETS 64
+
 typedef struct ini_entry_s {
     char* key;
     char* value;
+    uint32_t hash;
+    struct ini_section_s* section;
     struct ini_entry_s* next;
+    struct ini_entry_s* bucketNext;
 } ini_entry_t;
 
 typedef struct ini_section_s {
     char* name;
+    uint32_t hash;
     ini_entry_t* entries;
+    ini_entry_t* lastEntry;
     struct ini_section_s* next;
 } ini_section_t;
 
 typedef struct ini_file_s {
     ini_section_t* sections;
+    ini_section_t* lastSection;
+    ini_entry_t** buckets;
+    size_t bucketCount;
+    size_t entryCount;
 } ini_file_impl_t;
 
 static char* trim_whitespace(char* str) {
@@ -44,10 +57,25 @@ static char* duplicate_string(const char* str) {
     return copy;
 }
 
+static uint32_t hash_string(const char* str, uint32_t seed) {
+    /* FNV-1a */
+    uint32_t hash = seed;
+    while (*str) {
+        hash ^= (uint8_t)*str++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static uint32_t entry_hash(const ini_section_t* section, const char* key) {
+    return hash_string(key, section->hash ^ 2166136261u);
+}
+
 static ini_section_t* find_section(ini_file_impl_t* ini, const char* name) {
+    uint32_t hash = hash_string(name, 2166136261u);
     ini_section_t* section = ini->sections;
     while (section) {
-        if (strcmp(section->name, name) == 0) {
+        if (section->hash == hash && strcmp(section->name, name) == 0) {
             return section;
         }
         section = section->next;
@@ -55,44 +83,78 @@ static ini_section_t* find_section(ini_file_impl_t* ini, const char* name) {
     return NULL;
 }
 
-static ini_entry_t* find_entry(ini_section_t* section, const char* key) {
-    ini_entry_t* entry = section->entries;
+static ini_entry_t* find_entry(ini_file_impl_t* ini, ini_section_t* section, const char* key) {
+    if (!ini->buckets) return NULL;
+    
+    uint32_t hash = entry_hash(section, key);
+    ini_entry_t* entry = ini->buckets[hash & (ini->bucketCount - 1)];
     while (entry) {
-        if (strcmp(entry->key, key) == 0) {
+        if (entry->hash == hash && entry->section == section && strcmp(entry->key, key) == 0) {
             return entry;
         }
-        entry = entry->next;
+        entry = entry->bucketNext;
     }
     return NULL;
 }
 
+static void grow_buckets(ini_file_impl_t* ini) {
+    size_t newCount = ini->bucketCount ? ini->bucketCount * 2 : INI_INITIAL_BUCKETS;
+    ini_entry_t** newBuckets = (ini_entry_t**)I_Calloc(newCount, sizeof(ini_entry_t*));
+    
+    for (size_t i = 0; i < ini->bucketCount; i++) {
+        ini_entry_t* entry = ini->buckets[i];
+        while (entry) {
+            ini_entry_t* nextEntry = entry->bucketNext;
+            size_t index = entry->hash & (newCount - 1);
+            entry->bucketNext = newBuckets[index];
+            newBuckets[index] = entry;
+            entry = nextEntry;
+        }
+    }
+    
+    I_Free(ini->buckets);
+    ini->buckets = newBuckets;
+    ini->bucketCount = newCount;
+}
+
 static ini_section_t* add_section(ini_file_impl_t* ini, const char* name) {
     ini_section_t* section = (ini_section_t*)I_Calloc(1, sizeof(ini_section_t));
     section->name = duplicate_string(name);
+    section->hash = hash_string(name, 2166136261u);
     
     if (!ini->sections) {
         ini->sections = section;
     } else {
-        ini_section_t* last = ini->sections;
-        while (last->next) last = last->next;
-        last->next = section;
+        ini->lastSection->next = section;
     }
+    ini->lastSection = section;
     
     return section;
 }
 
-static ini_entry_t* add_entry(ini_section_t* section, const char* key, const char* value) {
+static ini_entry_t* add_entry(ini_file_impl_t* ini, ini_section_t* section, const char* key, const char* value) {
+    /* Keep the load factor below 1 */
+    if (ini->entryCount >= ini->bucketCount) {
+        grow_buckets(ini);
+    }
+    
     ini_entry_t* entry = (ini_entry_t*)I_Calloc(1, sizeof(ini_entry_t));
     entry->key = duplicate_string(key);
     entry->value = duplicate_string(value);
+    entry->hash = entry_hash(section, key);
+    entry->section = section;
     
     if (!section->entries) {
         section->entries = entry;
     } else {
-        ini_entry_t* last = section->entries;
-        while (last->next) last = last->next;
-        last->next = entry;
+        section->lastEntry->next = entry;
     }
+    section->lastEntry = entry;
+    
+    size_t index = entry->hash & (ini->bucketCount - 1);
+    entry->bucketNext = ini->buckets[index];
+    ini->buckets[index] = entry;
+    ini->entryCount++;
     
     return entry;
 }
@@ -137,12 +199,12 @@ ini_file_t I_LoadINI(const char* filename) {
                     value[strlen(value) - 1] = '\0';
                 }
                 
-                ini_entry_t* existing = find_entry(currentSection, key);
+                ini_entry_t* existing = find_entry(ini, currentSection, key);
                 if (existing) {
                     I_Free(existing->value);
                     existing->value = duplicate_string(value);
                 } else {
-                    add_entry(currentSection, key, value);
+                    add_entry(ini, currentSection, key, value);
                 }
             }
         }
@@ -175,43 +237,36 @@ void I_UnloadINI(ini_file_t ini) {
         section = nextSection;
     }
     
+    I_Free(impl->buckets);
     I_Free(impl);
 }
 
-bool I_INIGetString(ini_file_t ini, const char* section, const char* key,
-                    char* buffer, size_t bufferSize, const char* defaultValue) {
-    if (!ini || !section || !key || !buffer || bufferSize == 0) {
-        if (buffer && bufferSize > 0) {
-            strncpy(buffer, defaultValue ? defaultValue : "", bufferSize - 1);
-            buffer[bufferSize - 1] = '\0';
-        }
-        return false;
-    }
+const char* I_INIGetValue(ini_file_t ini, const char* section, const char* key) {
+    if (!ini || !section || !key) return NULL;
     
     ini_file_impl_t* impl = (ini_file_impl_t*)ini;
     ini_section_t* sec = find_section(impl, section);
-    if (!sec) {
-        strncpy(buffer, defaultValue ? defaultValue : "", bufferSize - 1);
-        buffer[bufferSize - 1] = '\0';
-        return false;
-    }
+    if (!sec) return NULL;
     
-    ini_entry_t* entry = find_entry(sec, key);
-    if (!entry) {
-        strncpy(buffer, defaultValue ? defaultValue : "", bufferSize - 1);
-        buffer[bufferSize - 1] = '\0';
-        return false;
-    }
+    ini_entry_t* entry = find_entry(impl, sec, key);
+    return entry ? entry->value : NULL;
+}
+
+bool I_INIGetString(ini_file_t ini, const char* section, const char* key,
+                    char* buffer, size_t bufferSize, const char* defaultValue) {
+    if (!buffer || bufferSize == 0) return false;
     
-    strncpy(buffer, entry->value, bufferSize - 1);
+    const char* value = I_INIGetValue(ini, section, key);
+    
+    strncpy(buffer, value ? value : (defaultValue ? defaultValue : ""), bufferSize - 1);
     buffer[bufferSize - 1] = '\0';
-    return true;
+    return value != NULL;
 }
 
 bool I_INIGetInt(ini_file_t ini, const char* section, const char* key,
                  int* value, int defaultValue) {
-    char buffer[64];
-    if (!I_INIGetString(ini, section, key, buffer, sizeof(buffer), NULL)) {
+    const char* buffer = I_INIGetValue(ini, section, key);
+    if (!buffer) {
         *value = defaultValue;
         return false;
     }
@@ -229,8 +284,8 @@ bool I_INIGetInt(ini_file_t ini, const char* section, const char* key,
 
 bool I_INIGetFloat(ini_file_t ini, const char* section, const char* key,
                    float* value, float defaultValue) {
-    char buffer[64];
-    if (!I_INIGetString(ini, section, key, buffer, sizeof(buffer), NULL)) {
+    const char* buffer = I_INIGetValue(ini, section, key);
+    if (!buffer) {
         *value = defaultValue;
         return false;
     }
@@ -248,8 +303,8 @@ bool I_INIGetFloat(ini_file_t ini, const char* section, const char* key,
 
 bool I_INIGetBool(ini_file_t ini, const char* section, const char* key,
                   bool* value, bool defaultValue) {
-    char buffer[64];
-    if (!I_INIGetString(ini, section, key, buffer, sizeof(buffer), NULL)) {
+    const char* buffer = I_INIGetValue(ini, section, key);
+    if (!buffer) {
         *value = defaultValue;
         return false;
     }
@@ -271,8 +326,8 @@ bool I_INIGetBool(ini_file_t ini, const char* section, const char* key,
 bool I_INIGetColor(ini_file_t ini, const char* section, const char* key,
                    uint8_t* r, uint8_t* g, uint8_t* b, uint8_t* a,
                    uint8_t defaultR, uint8_t defaultG, uint8_t defaultB, uint8_t defaultA) {
-    char buffer[64];
-    if (!I_INIGetString(ini, section, key, buffer, sizeof(buffer), NULL)) {
+    const char* buffer = I_INIGetValue(ini, section, key);
+    if (!buffer) {
         *r = defaultR;
         *g = defaultG;
         *b = defaultB;
@@ -306,12 +361,12 @@ bool I_INISetString(ini_file_t ini, const char* section, const char* key, const
         sec = add_section(impl, section);
     }
     
-    ini_entry_t* entry = find_entry(sec, key);
+    ini_entry_t* entry = find_entry(impl, sec, key);
     if (entry) {
         I_Free(entry->value);
         entry->value = duplicate_string(value);
     } else {
-        add_entry(sec, key, value);
+        add_entry(impl, sec, key, value);
     }
     
     return true;
@@ -12,6 +12,7 @@ extern "C" {
 #define MAX_MAP_HEIGHT 256
 #define MAX_TEXTURES 256
 #define MAX_ENTITIES 1024
+#define MAX_PROJECTILES 4096
 #define MAX_WEAPONS 16
 #define MAX_DOORS 128
 #define MAX_LIGHTS 256
@@ -146,8 +147,29 @@ typedef struct {
     bool solid;
     bool visible;
     bool pickupable;
+    
+    uint32_t generation;
+    int liveIndex;
 } entity_t;
 
+typedef struct {
+    int index;
+    uint32_t generation;
+} entity_handle_t;
+
+/* Projectile pool, one array per field. Live projectiles are packed into [0, count),
+   a removed one is replaced by the last, so spawning never allocates. */
+typedef struct {
+    int count;
+    float posX[MAX_PROJECTILES];
+    float posY[MAX_PROJECTILES];
+    float velX[MAX_PROJECTILES];
+    float velY[MAX_PROJECTILES];
+    float radius[MAX_PROJECTILES];
+    float lifeTime[MAX_PROJECTILES];
+    int damage[MAX_PROJECTILES];
+} projectile_pool_t;
+
 typedef struct {
     char name[64];
     weapon_state_t state;
@@ -208,11 +230,25 @@ typedef struct {
     vec2_t playerStart;
     float playerStartAngle;
     
+    /* Entity pool: MAX_ENTITIES slots, allocated once and kept across level reloads.
+       entityCount is the number of live entities, liveEntities[0..entityCount) their slots. */
     int entityCount;
     entity_t* entities;
+    int* liveEntities;
+    int* freeEntities;
+    int freeEntityCount;
+    
+    /* Allocated on the first shot and kept across level reloads like the entity pool */
+    projectile_pool_t* projectiles;
     
     int doorCount;
     door_t* doors;
+    /* Tile -> door slot (-1 without a door), activeDoors[0..activeDoorCount) are the doors which are not closed */
+    int* doorIndex;
+    int* activeDoors;
+    int activeDoorCount;
+    /* Bumped whenever a door opens or closes the tile it sits on */
+    unsigned int mapRevision;
     
     int lightCount;
     light_t* lights;
@@ -31,6 +31,9 @@ uint8_t G_GetWallTexture(level_t* level, int x, int y, int side);
 
 entity_t* G_SpawnEntity(level_t* level, entity_type_t type, vec2_t position);
 void G_RemoveEntity(level_t* level, entity_t* entity);
+entity_t* G_GetLiveEntity(level_t* level, int liveIndex);
+entity_handle_t G_GetEntityHandle(level_t* level, entity_t* entity);
+entity_t* G_GetEntity(level_t* level, entity_handle_t handle);
 entity_t* G_FindEntityAt(level_t* level, vec2_t position, float radius);
 
 door_t* G_GetDoorAt(level_t* level, int x, int y);
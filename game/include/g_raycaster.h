@@ -55,6 +55,7 @@ void G_RenderFrame(raycaster_t* raycaster);
 void G_RenderWalls(raycaster_t* raycaster);
 void G_RenderFloorCeiling(raycaster_t* raycaster);
 void G_RenderEntities(raycaster_t* raycaster);
+void G_RenderProjectiles(raycaster_t* raycaster);
 void G_RenderWeapon(raycaster_t* raycaster);
 void G_RenderSkybox(raycaster_t* raycaster);
 
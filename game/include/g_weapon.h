@@ -36,6 +36,7 @@ vec2_t G_GetWeaponOffset(weapon_t* weapon, player_t* player);
 
 void G_PerformHitscan(player_t* player, level_t* level, weapon_t* weapon);
 void G_SpawnProjectile(player_t* player, level_t* level, weapon_t* weapon);
+void G_UpdateProjectiles(level_t* level, float deltaTime);
 
 int G_GetWeaponFrame(weapon_t* weapon);
 bool G_IsWeaponReady(weapon_t* weapon);
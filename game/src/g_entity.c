@@ -25,8 +25,14 @@ static float normalizeAngle(float angle);
 void G_InitEntity(entity_t* entity, entity_type_t type, vec2_t position) {
     if (!entity) return;
     
+    /* Pool bookkeeping belongs to the slot, not to the entity */
+    uint32_t generation = entity->generation;
+    int liveIndex = entity->liveIndex;
+    
     memset(entity, 0, sizeof(entity_t));
     
+    entity->generation = generation;
+    entity->liveIndex = liveIndex;
     entity->type = type;
     entity->position = position;
     entity->state = ES_IDLE;
@@ -136,8 +142,9 @@ void G_UpdateEntity(entity_t* entity, level_t* level, player_t* player, float de
 void G_UpdateAllEntities(level_t* level, player_t* player, float deltaTime) {
     if (!level || !player) return;
     
-    for (int i = 0; i < level->entityCount; i++) {
-        G_UpdateEntity(&level->entities[i], level, player, deltaTime);
+    /* Backwards, so entities removed during the update do not skip others */
+    for (int i = level->entityCount - 1; i >= 0; i--) {
+        G_UpdateEntity(&level->entities[level->liveEntities[i]], level, player, deltaTime);
     }
 }
 
@@ -554,6 +561,8 @@ void G_UpdatePickup(entity_t* entity, level_t* level, player_t* player, float de
     
     if (G_IsEntityInRange(entity, player->position, entity->radius + PLAYER_RADIUS)) {
         G_EntityPickup(entity, player);
+        G_RemoveEntity(level, entity);
+        return;
     }
     
     entity->angle += deltaTime * 2.0f;
@@ -600,7 +609,7 @@ static bool checkEntityCollision(level_t* level, vec2_t position, float radius,
     }
     
     for (int i = 0; i < level->entityCount; i++) {
-        entity_t* other = &level->entities[i];
+        entity_t* other = &level->entities[level->liveEntities[i]];
         if (other == ignore || !other->active || !other->solid) continue;
         
         float dx = position.x - other->position.x;
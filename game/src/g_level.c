@@ -10,6 +10,8 @@
 
 static bool parseMapLine(const char* line, uint8_t* tiles, int width);
 static bool parseTextureLine(const char* line, uint8_t* textures, int width);
+static bool initEntityPool(level_t* level);
+static void resetEntityPool(level_t* level);
 
 level_t* G_CreateLevel(void) {
     level_t* level = (level_t*)I_Calloc(1, sizeof(level_t));
@@ -26,6 +28,10 @@ void G_DestroyLevel(level_t* level) {
     if (!level) return;
     
     G_UnloadLevel(level);
+    I_Free(level->entities);
+    I_Free(level->liveEntities);
+    I_Free(level->freeEntities);
+    I_Free(level->projectiles);
     I_Free(level);
     
     I_Log("Level destroyed");
@@ -103,11 +109,34 @@ void G_UnloadLevel(level_t* level) {
         I_Free(level->wallTextures[i]);
     }
     I_Free(level->lightMap);
-    I_Free(level->entities);
     I_Free(level->doors);
+    I_Free(level->doorIndex);
+    I_Free(level->activeDoors);
     I_Free(level->lights);
     
+    /* The entity pool survives the reload, only its slots are released */
+    resetEntityPool(level);
+    
+    entity_t* entities = level->entities;
+    int* liveEntities = level->liveEntities;
+    int* freeEntities = level->freeEntities;
+    int freeEntityCount = level->freeEntityCount;
+    projectile_pool_t* projectiles = level->projectiles;
+    /* Keeps counting, so a cache built for the previous level never matches the next one */
+    unsigned int mapRevision = level->mapRevision + 1;
+    
     memset(level, 0, sizeof(level_t));
+    
+    level->entities = entities;
+    level->liveEntities = liveEntities;
+    level->freeEntities = freeEntities;
+    level->freeEntityCount = freeEntityCount;
+    level->projectiles = projectiles;
+    level->mapRevision = mapRevision;
+    
+    if (projectiles) {
+        projectiles->count = 0;
+    }
 }
 
 bool G_LoadMapData(level_t* level, const char* mapFile) {
@@ -341,32 +370,20 @@ bool G_LoadLightData(level_t* level, const char* lightFile) {
 bool G_LoadEntityData(level_t* level, const char* entityPath) {
     if (!level || !entityPath) return false;
     
-    level->entityCount = 0;
-    
     for (int i = 0; i < 1000; i++) {
         char entityFile[1024];
         snprintf(entityFile, sizeof(entityFile), "%s/%d.ini", entityPath, i);
         
         if (!I_FileExists(entityFile)) continue;
         
-        level->entityCount++;
-    }
-    
-    if (level->entityCount == 0) return true;
-    
-    level->entities = (entity_t*)I_Calloc(level->entityCount, sizeof(entity_t));
-    int entityIndex = 0;
-    
-    for (int i = 0; i < 1000 && entityIndex < level->entityCount; i++) {
-        char entityFile[1024];
-        snprintf(entityFile, sizeof(entityFile), "%s/%d.ini", entityPath, i);
-        
-        if (!I_FileExists(entityFile)) continue;
-        
         ini_file_t entityConfig = I_LoadINI(entityFile);
         if (!entityConfig) continue;
         
-        entity_t* entity = &level->entities[entityIndex];
+        entity_t* entity = G_SpawnEntity(level, ET_NONE, (vec2_t){0, 0});
+        if (!entity) {
+            I_UnloadINI(entityConfig);
+            break;
+        }
         
         char typeStr[64];
         I_INIGetString(entityConfig, "Entity", "Type", typeStr, sizeof(typeStr), "");
@@ -403,7 +420,6 @@ bool G_LoadEntityData(level_t* level, const char* entityPath) {
                              entity->type == ET_ITEM_ARMOR);
         
         I_UnloadINI(entityConfig);
-        entityIndex++;
     }
     
     return true;
@@ -433,6 +449,11 @@ bool G_LoadDoorData(level_t* level, const char* doorFile) {
     
     if (level->doorCount > 0) {
         level->doors = (door_t*)I_Calloc(level->doorCount, sizeof(door_t));
+        level->activeDoors = (int*)I_Calloc(level->doorCount, sizeof(int));
+        level->doorIndex = (int*)I_Malloc(level->width * level->height * sizeof(int));
+        for (int i = 0; i < level->width * level->height; i++) {
+            level->doorIndex[i] = -1;
+        }
         
         I_Free(buffer);
         if (!I_LoadConfigFile(doorFile, &buffer, &size)) {
@@ -464,6 +485,7 @@ bool G_LoadDoorData(level_t* level, const char* doorFile) {
                     if (door->position.x >= 0 && door->position.x < level->width &&
                         door->position.y >= 0 && door->position.y < level->height) {
                         level->tiles[door->position.y * level->width + door->position.x] = TILE_DOOR;
+                        level->doorIndex[door->position.y * level->width + door->position.x] = doorIndex;
                     }
                     
                     doorIndex++;
@@ -516,35 +538,79 @@ uint8_t G_GetWallTexture(level_t* level, int x, int y, int side) {
 entity_t* G_SpawnEntity(level_t* level, entity_type_t type, vec2_t position) {
     if (!level) return NULL;
     
-    entity_t* newEntities = (entity_t*)I_Realloc(level->entities, 
-                                                  (level->entityCount + 1) * sizeof(entity_t));
-    if (!newEntities) return NULL;
+    if (!level->entities && !initEntityPool(level)) return NULL;
     
-    level->entities = newEntities;
-    entity_t* entity = &level->entities[level->entityCount];
-    level->entityCount++;
+    if (level->freeEntityCount == 0) {
+        I_Log("Entity pool exhausted (%d entities)", MAX_ENTITIES);
+        return NULL;
+    }
+    
+    int slot = level->freeEntities[--level->freeEntityCount];
+    entity_t* entity = &level->entities[slot];
+    uint32_t generation = entity->generation;
     
     memset(entity, 0, sizeof(entity_t));
     entity->type = type;
     entity->position = position;
     entity->active = true;
     entity->visible = true;
+    entity->generation = generation;
+    entity->liveIndex = level->entityCount;
+    
+    level->liveEntities[level->entityCount++] = slot;
     
     return entity;
 }
 
 void G_RemoveEntity(level_t* level, entity_t* entity) {
-    if (!level || !entity) return;
+    if (!level || !entity || entity->liveIndex < 0) return;
+    
+    int slot = (int)(entity - level->entities);
+    if (slot < 0 || slot >= MAX_ENTITIES) return;
+    
+    /* Swap with the last live entity, so the live list stays dense */
+    int last = level->liveEntities[--level->entityCount];
+    level->liveEntities[entity->liveIndex] = last;
+    level->entities[last].liveIndex = entity->liveIndex;
     
     entity->active = false;
     entity->visible = false;
+    entity->liveIndex = -1;
+    entity->generation++;
+    
+    level->freeEntities[level->freeEntityCount++] = slot;
+}
+
+entity_t* G_GetLiveEntity(level_t* level, int liveIndex) {
+    if (!level || liveIndex < 0 || liveIndex >= level->entityCount) return NULL;
+    
+    return &level->entities[level->liveEntities[liveIndex]];
+}
+
+entity_handle_t G_GetEntityHandle(level_t* level, entity_t* entity) {
+    entity_handle_t handle = {-1, 0};
+    
+    if (!level || !entity || !level->entities || entity->liveIndex < 0) return handle;
+    
+    handle.index = (int)(entity - level->entities);
+    handle.generation = entity->generation;
+    return handle;
+}
+
+entity_t* G_GetEntity(level_t* level, entity_handle_t handle) {
+    if (!level || !level->entities || handle.index < 0 || handle.index >= MAX_ENTITIES) return NULL;
+    
+    entity_t* entity = &level->entities[handle.index];
+    if (entity->liveIndex < 0 || entity->generation != handle.generation) return NULL;
+    
+    return entity;
 }
 
 entity_t* G_FindEntityAt(level_t* level, vec2_t position, float radius) {
     if (!level) return NULL;
     
     for (int i = 0; i < level->entityCount; i++) {
-        entity_t* entity = &level->entities[i];
+        entity_t* entity = &level->entities[level->liveEntities[i]];
         if (!entity->active) continue;
         
         float dx = entity->position.x - position.x;
@@ -561,16 +627,11 @@ entity_t* G_FindEntityAt(level_t* level, vec2_t position, float radius) {
 }
 
 door_t* G_GetDoorAt(level_t* level, int x, int y) {
-    if (!level) return NULL;
+    if (!level || !level->doorIndex) return NULL;
+    if (x < 0 || x >= level->width || y < 0 || y >= level->height) return NULL;
     
-    for (int i = 0; i < level->doorCount; i++) {
-        door_t* door = &level->doors[i];
-        if (door->position.x == x && door->position.y == y) {
-            return door;
-        }
-    }
-    
-    return NULL;
+    int doorIndex = level->doorIndex[y * level->width + x];
+    return doorIndex >= 0 ? &level->doors[doorIndex] : NULL;
 }
 
 bool G_OpenDoor(level_t* level, door_t* door, player_t* player) {
@@ -586,43 +647,57 @@ bool G_OpenDoor(level_t* level, door_t* door, player_t* player) {
     door->state = DS_OPENING;
     door->stateTime = 0.0f;
     
+    /* Closed doors are dormant, only the active ones are updated per tick */
+    level->activeDoors[level->activeDoorCount++] = (int)(door - level->doors);
+    
     I_Log("Door opened at (%d, %d)", door->position.x, door->position.y);
     return true;
 }
 
+/* Returns true once the door is closed again and can leave the active list */
+static bool updateDoor(level_t* level, door_t* door, float deltaTime) {
+    switch (door->state) {
+        case DS_OPENING:
+            door->openAmount += deltaTime / 1.0f;
+            if (door->openAmount >= 1.0f) {
+                door->openAmount = 1.0f;
+                door->state = DS_OPEN;
+                door->stateTime = 0.0f;
+                level->mapRevision++;
+            }
+            break;
+            
+        case DS_OPEN:
+            door->stateTime += deltaTime;
+            if (door->stateTime >= door->openTime) {
+                door->state = DS_CLOSING;
+                level->mapRevision++;
+            }
+            break;
+            
+        case DS_CLOSING:
+            door->openAmount -= deltaTime / 1.0f;
+            if (door->openAmount <= 0.0f) {
+                door->openAmount = 0.0f;
+                door->state = DS_CLOSED;
+                return true;
+            }
+            break;
+            
+        default:
+            return true;
+    }
+    
+    return false;
+}
+
 void G_UpdateDoors(level_t* level, float deltaTime) {
     if (!level) return;
     
-    for (int i = 0; i < level->doorCount; i++) {
-        door_t* door = &level->doors[i];
-        
-        switch (door->state) {
-            case DS_OPENING:
-                door->openAmount += deltaTime / 1.0f;
-                if (door->openAmount >= 1.0f) {
-                    door->openAmount = 1.0f;
-                    door->state = DS_OPEN;
-                    door->stateTime = 0.0f;
-                }
-                break;
-                
-            case DS_OPEN:
-                door->stateTime += deltaTime;
-                if (door->stateTime >= door->openTime) {
-                    door->state = DS_CLOSING;
-                }
-                break;
-                
-            case DS_CLOSING:
-                door->openAmount -= deltaTime / 1.0f;
-                if (door->openAmount <= 0.0f) {
-                    door->openAmount = 0.0f;
-                    door->state = DS_CLOSED;
-                }
-                break;
-                
-            default:
-                break;
+    /* Backwards, so closed doors can be swapped out of the list */
+    for (int i = level->activeDoorCount - 1; i >= 0; i--) {
+        if (updateDoor(level, &level->doors[level->activeDoors[i]], deltaTime)) {
+            level->activeDoors[i] = level->activeDoors[--level->activeDoorCount];
         }
     }
 }
@@ -694,7 +769,7 @@ bool G_CheckLevelComplete(level_t* level) {
     if (!level) return false;
     
     for (int i = 0; i < level->entityCount; i++) {
-        entity_t* entity = &level->entities[i];
+        entity_t* entity = &level->entities[level->liveEntities[i]];
         if (entity->active && (entity->type == ET_ENEMY_SOLDIER || 
                                entity->type == ET_ENEMY_DEMON)) {
             return false;
@@ -720,7 +795,7 @@ int G_CountEnemies(level_t* level) {
     
     int count = 0;
     for (int i = 0; i < level->entityCount; i++) {
-        entity_t* entity = &level->entities[i];
+        entity_t* entity = &level->entities[level->liveEntities[i]];
         if (entity->active && (entity->type == ET_ENEMY_SOLDIER || 
                                entity->type == ET_ENEMY_DEMON)) {
             count++;
@@ -738,6 +813,46 @@ void G_LoadLevelState(level_t* level, const void* buffer) {
     if (!level || !buffer) return;
 }
 
+static bool initEntityPool(level_t* level) {
+    level->entities = (entity_t*)I_Calloc(MAX_ENTITIES, sizeof(entity_t));
+    level->liveEntities = (int*)I_Malloc(MAX_ENTITIES * sizeof(int));
+    level->freeEntities = (int*)I_Malloc(MAX_ENTITIES * sizeof(int));
+    
+    if (!level->entities || !level->liveEntities || !level->freeEntities) {
+        I_Free(level->entities);
+        I_Free(level->liveEntities);
+        I_Free(level->freeEntities);
+        level->entities = NULL;
+        level->liveEntities = NULL;
+        level->freeEntities = NULL;
+        return false;
+    }
+    
+    level->entityCount = 0;
+    resetEntityPool(level);
+    return true;
+}
+
+static void resetEntityPool(level_t* level) {
+    if (!level->entities) return;
+    
+    /* Live entities get a new generation, so old handles no longer resolve */
+    for (int i = 0; i < level->entityCount; i++) {
+        entity_t* entity = &level->entities[level->liveEntities[i]];
+        entity->active = false;
+        entity->generation++;
+    }
+    
+    /* Lowest slots are handed out first */
+    for (int i = 0; i < MAX_ENTITIES; i++) {
+        level->entities[i].liveIndex = -1;
+        level->freeEntities[i] = MAX_ENTITIES - 1 - i;
+    }
+    
+    level->freeEntityCount = MAX_ENTITIES;
+    level->entityCount = 0;
+}
+
 static bool parseMapLine(const char* line, uint8_t* tiles, int width) {
     if (!line || !tiles) return false;
     
@@ -344,6 +344,7 @@ void G_ProcessGameLogic(game_context_t* context, float deltaTime) {
     G_UpdatePlayer(context->player, context->level, deltaTime);
     G_UpdateAllWeapons(context->weaponManager, context->player, deltaTime);
     G_UpdateAllEntities(context->level, context->player, deltaTime);
+    G_UpdateProjectiles(context->level, deltaTime);
     G_UpdateDoors(context->level, deltaTime);
     
     if (context->player->health <= 0) {
@@ -242,7 +242,7 @@ bool G_IsPositionSolid(level_t* level, float x, float y, float radius) {
     }
     
     for (int i = 0; i < level->entityCount; i++) {
-        entity_t* entity = &level->entities[i];
+        entity_t* entity = &level->entities[level->liveEntities[i]];
         if (!entity->active || !entity->solid) continue;
         
         float dx = x - entity->position.x;
@@ -94,6 +94,7 @@ void G_RenderFrame(raycaster_t* raycaster) {
     }
     
     G_RenderEntities(raycaster);
+    G_RenderProjectiles(raycaster);
     
     G_RenderWeapon(raycaster);
 }
@@ -250,10 +251,11 @@ void G_RenderEntities(raycaster_t* raycaster) {
     int spriteCount = 0;
     
     for (int i = 0; i < raycaster->level->entityCount && spriteCount < MAX_ENTITIES; i++) {
-        entity_t* entity = &raycaster->level->entities[i];
+        int slot = raycaster->level->liveEntities[i];
+        entity_t* entity = &raycaster->level->entities[slot];
         if (!entity->active || !entity->visible) continue;
         
-        raycaster->spriteOrder[spriteCount] = i;
+        raycaster->spriteOrder[spriteCount] = slot;
         float dx = entity->position.x - raycaster->player->position.x;
         float dy = entity->position.y - raycaster->player->position.y;
         raycaster->spriteDistance[spriteCount] = dx * dx + dy * dy;
@@ -306,6 +308,45 @@ void G_RenderEntities(raycaster_t* raycaster) {
     }
 }
 
+void G_RenderProjectiles(raycaster_t* raycaster) {
+    if (!raycaster || !raycaster->level || !raycaster->player || !raycaster->level->projectiles) return;
+    
+    projectile_pool_t* pool = raycaster->level->projectiles;
+    player_t* player = raycaster->player;
+    
+    float invDet = 1.0f / (player->plane.x * player->direction.y - player->direction.x * player->plane.y);
+    int pitch = (int)(player->pitch * raycaster->height);
+    int centerY = raycaster->height / 2 + pitch;
+    
+    /* Untextured squares in one pass after the entities, depth tested against the walls per column */
+    for (int i = 0; i < pool->count; i++) {
+        float spriteX = pool->posX[i] - player->position.x;
+        float spriteY = pool->posY[i] - player->position.y;
+        
+        float transformX = invDet * (player->direction.y * spriteX - player->direction.x * spriteY);
+        float transformY = invDet * (-player->plane.y * spriteX + player->plane.x * spriteY);
+        
+        if (transformY <= 0.1f) continue;
+        
+        int screenX = (int)((raycaster->width / 2) * (1 + transformX / transformY));
+        int size = (int)(raycaster->height * pool->radius[i] / (TILE_SIZE * transformY));
+        if (size < 1) size = 1;
+        
+        int drawStartX = screenX - size < 0 ? 0 : screenX - size;
+        int drawEndX = screenX + size >= raycaster->width ? raycaster->width - 1 : screenX + size;
+        int drawStartY = centerY - size < 0 ? 0 : centerY - size;
+        int drawEndY = centerY + size >= raycaster->height ? raycaster->height - 1 : centerY + size;
+        
+        for (int stripe = drawStartX; stripe <= drawEndX; stripe++) {
+            if (transformY >= raycaster->zBuffer[stripe]) continue;
+            
+            for (int y = drawStartY; y <= drawEndY; y++) {
+                raycaster->framebuffer[y * raycaster->width + stripe] = 0xFFFFC040;
+            }
+        }
+    }
+}
+
 void G_RenderWeapon(raycaster_t* raycaster) {
     if (!raycaster || !raycaster->player) return;
 }
@@ -8,6 +8,7 @@
 #include <math.h>
 #include <string.h>
 #include <stdio.h>
+#include <float.h>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -18,11 +19,17 @@
 #define WEAPON_SWAY_AMOUNT 0.001f
 #define WEAPON_RECOIL_AMOUNT 0.1f
 #define WEAPON_RECOIL_RECOVERY 5.0f
+#define PROJECTILE_RADIUS 4.0f
 
 static float weaponBobTime = 0.0f;
 static float weaponRecoil = 0.0f;
 static vec2_t weaponSway = {0, 0};
 
+static void removeProjectile(projectile_pool_t* pool, int i);
+static bool isProjectileBlocked(level_t* level, int tileX, int tileY);
+static float intersectSegment(vec2_t start, vec2_t dir, float length, vec2_t center, float radius);
+static bool sweepProjectile(level_t* level, int i, float deltaTime);
+
 weapon_manager_t* G_CreateWeaponManager(void) {
     weapon_manager_t* manager = (weapon_manager_t*)I_Calloc(1, sizeof(weapon_manager_t));
     I_Log("Weapon manager created");
@@ -275,7 +282,7 @@ void G_PerformHitscan(player_t* player, level_t* level, weapon_t* weapon) {
     vec2_t hitPoint = rayStart;
     
     for (int i = 0; i < level->entityCount; i++) {
-        entity_t* entity = &level->entities[i];
+        entity_t* entity = &level->entities[level->liveEntities[i]];
         if (!entity->active || !entity->solid) continue;
         
         vec2_t toEntity = {entity->position.x - rayStart.x, entity->position.y - rayStart.y};
@@ -325,24 +332,143 @@ void G_PerformHitscan(player_t* player, level_t* level, weapon_t* weapon) {
 void G_SpawnProjectile(player_t* player, level_t* level, weapon_t* weapon) {
     if (!player || !level || !weapon) return;
     
-    vec2_t spawnPos = player->position;
-    spawnPos.x += player->direction.x * 32.0f;
-    spawnPos.y += player->direction.y * 32.0f;
+    if (!level->projectiles) {
+        level->projectiles = (projectile_pool_t*)I_Calloc(1, sizeof(projectile_pool_t));
+        if (!level->projectiles) return;
+    }
     
-    entity_t* projectile = G_SpawnEntity(level, ET_NONE, spawnPos);
-    if (!projectile) return;
+    projectile_pool_t* pool = level->projectiles;
+    if (pool->count >= MAX_PROJECTILES) return;
     
     float angle = atan2f(player->direction.y, player->direction.x);
     float spread = ((float)rand() / RAND_MAX - 0.5f) * weapon->spread;
     angle += spread;
     
-    projectile->velocity.x = cosf(angle) * weapon->projectileSpeed;
-    projectile->velocity.y = sinf(angle) * weapon->projectileSpeed;
-    projectile->damage = weapon->damage;
-    projectile->radius = 4.0f;
-    projectile->height = 8.0f;
+    int i = pool->count++;
+    pool->posX[i] = player->position.x + player->direction.x * 32.0f;
+    pool->posY[i] = player->position.y + player->direction.y * 32.0f;
+    pool->velX[i] = cosf(angle) * weapon->projectileSpeed;
+    pool->velY[i] = sinf(angle) * weapon->projectileSpeed;
+    pool->radius[i] = PROJECTILE_RADIUS;
+    pool->lifeTime[i] = weapon->projectileSpeed > 0.0f ? weapon->range / weapon->projectileSpeed : 0.0f;
+    pool->damage[i] = weapon->damage;
+}
+
+void G_UpdateProjectiles(level_t* level, float deltaTime) {
+    if (!level || !level->projectiles) return;
+    
+    projectile_pool_t* pool = level->projectiles;
+    
+    /* Backwards, so the projectile moved into a removed slot was already updated */
+    for (int i = pool->count - 1; i >= 0; i--) {
+        pool->lifeTime[i] -= deltaTime;
+        
+        if (pool->lifeTime[i] <= 0.0f || sweepProjectile(level, i, deltaTime)) {
+            removeProjectile(pool, i);
+        }
+    }
+}
+
+static void removeProjectile(projectile_pool_t* pool, int i) {
+    int last = --pool->count;
+    if (i == last) return;
+    
+    pool->posX[i] = pool->posX[last];
+    pool->posY[i] = pool->posY[last];
+    pool->velX[i] = pool->velX[last];
+    pool->velY[i] = pool->velY[last];
+    pool->radius[i] = pool->radius[last];
+    pool->lifeTime[i] = pool->lifeTime[last];
+    pool->damage[i] = pool->damage[last];
+}
+
+static bool isProjectileBlocked(level_t* level, int tileX, int tileY) {
+    uint8_t tile = G_GetTile(level, tileX, tileY);
+    if (tile == TILE_WALL) return true;
+    if (tile != TILE_DOOR) return false;
+    
+    door_t* door = G_GetDoorAt(level, tileX, tileY);
+    return door && door->state != DS_OPEN;
+}
+
+/* Distance along the segment where it enters the circle, -1 if it misses */
+static float intersectSegment(vec2_t start, vec2_t dir, float length, vec2_t center, float radius) {
+    float toX = center.x - start.x;
+    float toY = center.y - start.y;
+    float proj = toX * dir.x + toY * dir.y;
+    float disc = radius * radius - (toX * toX + toY * toY - proj * proj);
+    
+    if (disc < 0.0f) return -1.0f;
+    
+    float root = sqrtf(disc);
+    if (proj + root < 0.0f || proj - root > length) return -1.0f;
+    
+    return proj - root > 0.0f ? proj - root : 0.0f;
+}
+
+/* Moves one projectile through the tiles it crosses this frame, returns true if it hit something */
+static bool sweepProjectile(level_t* level, int i, float deltaTime) {
+    projectile_pool_t* pool = level->projectiles;
+    
+    vec2_t start = {pool->posX[i], pool->posY[i]};
+    float moveX = pool->velX[i] * deltaTime;
+    float moveY = pool->velY[i] * deltaTime;
+    float length = sqrtf(moveX * moveX + moveY * moveY);
+    
+    if (length <= 0.0f) return false;
+    
+    vec2_t dir = {moveX / length, moveY / length};
+    
+    /* Nearest entity along the whole segment - the C port has no spatial index, so the live list is scanned once */
+    float hitDist = length;
+    entity_t* hitEntity = NULL;
+    
+    for (int e = 0; e < level->entityCount; e++) {
+        entity_t* entity = &level->entities[level->liveEntities[e]];
+        if (!entity->active || !entity->solid) continue;
+        
+        float dist = intersectSegment(start, dir, hitDist, entity->position, entity->radius + pool->radius[i]);
+        if (dist >= 0.0f) {
+            hitDist = dist;
+            hitEntity = entity;
+        }
+    }
+    
+    /* Tile DDA up to the target - a wall or closed door in front of it stops the projectile first */
+    int tileX = (int)(start.x / TILE_SIZE);
+    int tileY = (int)(start.y / TILE_SIZE);
+    int stepX = dir.x < 0.0f ? -1 : 1;
+    int stepY = dir.y < 0.0f ? -1 : 1;
+    float deltaX = dir.x != 0.0f ? fabsf(TILE_SIZE / dir.x) : FLT_MAX;
+    float deltaY = dir.y != 0.0f ? fabsf(TILE_SIZE / dir.y) : FLT_MAX;
+    float sideX = dir.x != 0.0f ? (dir.x < 0.0f ? start.x - tileX * TILE_SIZE : (tileX + 1) * TILE_SIZE - start.x) / fabsf(dir.x) : FLT_MAX;
+    float sideY = dir.y != 0.0f ? (dir.y < 0.0f ? start.y - tileY * TILE_SIZE : (tileY + 1) * TILE_SIZE - start.y) / fabsf(dir.y) : FLT_MAX;
+    
+    if (isProjectileBlocked(level, tileX, tileY)) return true;
+    
+    while (true) {
+        float next = sideX < sideY ? sideX : sideY;
+        if (next > hitDist) break;
+        
+        if (sideX < sideY) {
+            sideX += deltaX;
+            tileX += stepX;
+        } else {
+            sideY += deltaY;
+            tileY += stepY;
+        }
+        
+        if (isProjectileBlocked(level, tileX, tileY)) return true;
+    }
+    
+    if (hitEntity) {
+        G_DamageEntity(hitEntity, pool->damage[i], start);
+        return true;
+    }
     
-    I_Log("Spawned projectile with velocity (%.2f, %.2f)", projectile->velocity.x, projectile->velocity.y);
+    pool->posX[i] += moveX;
+    pool->posY[i] += moveY;
+    return false;
 }
 
 int G_GetWeaponFrame(weapon_t* weapon) {